@@ -21,10 +21,11 @@
 #include "ds18b20.h"
 
 #include <string.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "driver/gpio.h"
+#include <stdint.h>
 
+#ifdef ESP_PLATFORM
+#include "ds18b20_gpio.h"
+#endif /* ESP_PLATFORM */
 #include "ds18b20_specifications.h"
 #include "ds18b20_registers.h"
 #include "ds18b20_rom.h"
@@ -37,6 +38,110 @@
 #define DS18B20_READ_TEMPERATURE_BYTES          2   /**< Specifies how many bytes are required to read to get measured temperature */
 #define DS18B20_READ_CONFIGURATION_BYTES        5   /**< Specifies how many bytes are required to read to get configuration of the device */
 
+#define DS18B20_INTEGRITY_MAX_CHANGE_DEFAULT        (10 * 16)   /**< Default highest plausible change between consecutive readings (1/16 Celsius) */
+#define DS18B20_INTEGRITY_ESCALATION_READS_DEFAULT  8           /**< Default number of full CRC-verified reads after anomaly */
+
+#define DS18B20_TIMING_POLL_PERIOD_MS           1   /**< Period of status checks while measuring convertion time (ms) */
+#define DS18B20_TIMING_MEAN_GAIN_SHIFT          3   /**< Each measurement moves the average convertion time by 1/8 of its error */
+#define DS18B20_TIMING_DEVIATION_GAIN_SHIFT     2   /**< Each measurement moves the average deviation by 1/4 of its error */
+#define DS18B20_TIMING_DEVIATION_INIT_SHIFT     3   /**< The first measurement sets the average deviation to 1/8 of measured time */
+#define DS18B20_TIMING_DEADLINE_DEVIATIONS      4   /**< Number of average deviations added to learned convertion time to get the deadline */
+#define DS18B20_TIMING_WAKE_DEVIATIONS          2   /**< Number of average deviations before learned convertion time when polling begins */
+#define DS18B20_US_PER_MS                       1000    /**< Number of microseconds in one millisecond */
+
+#define DS18B20_RESOLUTION_STEPS_PER_CHANGE_DEFAULT 2   /**< Default number of resolution steps which change between readings should span */
+#define DS18B20_RESOLUTION_SETTLE_READINGS_DEFAULT  3   /**< Default number of readings calling for higher resolution before it is raised */
+#define DS18B20_RESOLUTION_GAIN_SHIFT               2   /**< Each reading moves trend and noise by 1/4 of their error */
+#define DS18B20_RESOLUTION_FRACTION_SHIFT           4   /**< Trend and noise keep 4 more fractional bits than readings (1/256 Celsius) */
+
+#define DS18B20_MIRROR_STALE                    0   /**< Generation of mirror which has never been valid */
+
+#define DS18B20_ROM_INDEX_EMPTY                 SIZE_MAX    /**< Value of unused ROM index slot */
+#define DS18B20_ROM_HASH_BASIS                  2166136261u /**< Initial value of FNV-1a hash */
+#define DS18B20_ROM_HASH_PRIME                  16777619u   /**< Multiplier of FNV-1a hash */
+
+/**
+ * @brief Validates transport and assigns it together with devices array or storage to One-Wire bus instance.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances (unused if storage is given)
+ * @param storage Pointer to packed storage of devices (optional)
+ * @param devicesNo Number of devices
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_attachTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t devicesNo);
+
+/**
+ * @brief Initializes One-Wire bus instance with known number of devices kept either in devices array or packed storage.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances (unused if storage is given)
+ * @param storage Pointer to packed storage of devices (optional)
+ * @param devicesNo Number of devices
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_initOneWire(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t devicesNo, const bool checksum);
+
+/**
+ * @brief Enumerates One-Wire bus and initializes its instance with found devices kept either in devices array or packed storage.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances (unused if storage is given)
+ * @param storage Pointer to packed storage of devices (optional)
+ * @param capacity Maximum number of devices
+ * @param familyCode Family code of handled devices
+ * @param devicesNoOut Pointer to variable where number of all matching devices will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_discoverOneWire(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum);
+
+/**
+ * @brief Reads scratchpad memory and power mode of all devices with already known ROM addresses.
+ * 
+ * Power mode is probed with a single broadcast and per-device probes are needed only if any device is parasite powered.
+ * If so, the first temperature convertion is performed by all devices at once, because it is not reliable.
+ * If cached records are given, each device has to reply to scratchpad read and power modes are taken from the records,
+ * as long as they agree with the broadcast probe.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @param records Cached device records of topology blob or NULL
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_initDevices(DS18B20_onewire_t * const onewire, const bool checksum, const uint8_t * const records);
+
+/**
+ * @brief Validates the topology blob and fills ROM addresses of the devices with the cached ones.
+ * 
+ * Only one device can be connected when skipping ROM is used to select it, so its cached ROM address is compared with the one read from the bus.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param blob Topology blob loaded from the store
+ * @param blobSize Size of the blob in bytes
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_importTopology(const DS18B20_onewire_t * const onewire, const uint8_t * const blob, const size_t blobSize, const bool checksum);
+
+/**
+ * @brief Calculates hash of the serial number contained in ROM address.
+ * 
+ * @param rom ROM address
+ * @return uint32_t Hash value
+ */
+static uint32_t ds18b20_hashRom(const DS18B20_rom_t rom);
+
 /**
  * @brief Waits for DS18B20 operation to end with periodically checking its status.
  * 
@@ -59,6 +164,26 @@ static void ds18b20_waitWithChecking(const DS18B20_onewire_t * const onewire, ui
  */
 static DS18B20_error_t ds18b20_readRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint8_t bytesToRead, const bool checksum);
 
+/**
+ * @brief Reads configuration registers of all devices one by one, optionally comparing them with the expected values.
+ * 
+ * Only bytes up to configuration register are read, unless CRC checksum is calculated.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param expected Scratchpad memory containing expected configurable bytes (NULL if they should not be verified)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readAllRegisters(const DS18B20_onewire_t * const onewire, const DS18B20_scratchpad_t expected, const bool checksum);
+
+/**
+ * @brief Checks if all devices connected to the bus are handled by One-Wire bus instance, so function commands can be broadcast with Skip ROM.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return bool True if there are no devices of other families or above the capacity on the bus
+ */
+static bool ds18b20_ownsBus(const DS18B20_onewire_t * const onewire);
+
 /**
  * @brief Reads ROM address of the found device.
  * 
@@ -120,438 +245,2627 @@ static DS18B20_error_t ds18b20_selectDevice(const DS18B20_onewire_t * const onew
  */
 static DS18B20_error_t ds18b20_requestTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs);
 
-DS18B20_error_t ds18b20__InitOneWire(DS18B20_onewire_t * const onewire, const int bus, DS18B20_t * const devices, const size_t devicesNo, const bool checksum)
-{
-    DS18B20_error_t status;
-    if (!onewire || !devices || !devicesNo)
-    {
-        return DS18B20_INV_ARG;
-    }
+/**
+ * @brief Only requests all DS18B20 connected to One-Wire bus for temperature convertion without reading their values while periodically checking if performing operation by the devices has ended.
+ * 
+ * Waits until this operation has finished by periodically checking its status.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checkPeriodMs Specifies how often the status of the specified operation will be checked (in milliseconds)
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_requestTemperatures(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs);
 
-    if (ESP_OK != gpio_reset_pin(bus))
-    {
-        return DS18B20_INV_CONF;
-    }
+/**
+ * @brief Starts temperature convertion of chosen DS18B20 without waiting for it to finish.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param convertion Pointer to convertion instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_startTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion);
 
-    onewire->bus = bus;
-    onewire->devices = devices;
-    onewire->devicesNo = devicesNo;
+/**
+ * @brief Starts temperature convertion of all DS18B20 connected to One-Wire bus without waiting for it to finish.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to convertion instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_startTemperatures(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion);
 
-    // Manually calling restart search for the first time, because internal values have not been set yet.
-    status = ds18b20_restart_search(onewire, false);
-    if (DS18B20_OK != status)
-    {
-        return status;
-    }
+/**
+ * @brief Marks started temperature convertion as finished and releases the bus if strong pullup has been enabled.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to started convertion instance
+ */
+static void ds18b20_finishConvertion(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion);
 
-    for (size_t deviceIndex = 0; deviceIndex < devicesNo; ++deviceIndex)
-    {
-        // Clear rom
-        memset(onewire->devices[deviceIndex].rom, DS18B20_DEFAULT_VALUE, DS18B20_ROM_SIZE);
+/**
+ * @brief Waits for started temperature convertion to end, measuring its time if learning of convertion time is enabled.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to started convertion instance
+ * @param timing Pointer to learned convertion time to use and update (NULL if learning is disabled)
+ * @param resolution Convertion resolution
+ * @param checkPeriodMs Specifies how often the status of the convertion will be checked if learning is disabled (in milliseconds)
+ */
+static void ds18b20_waitForConvertion(const DS18B20_onewire_t * const onewire, const DS18B20_convertion_t * const convertion, 
+    DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution, const uint16_t checkPeriodMs);
 
-        // Clear scratchpad
-        memset(onewire->devices[deviceIndex].scratchpad, DS18B20_DEFAULT_VALUE, DS18B20_SP_SIZE);
+/**
+ * @brief Returns learned convertion time of the selected device or all devices.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device, number of devices means convertions started on all devices
+ * @return DS18B20_timing_state_t* Pointer to learned convertion time, NULL if learning is disabled
+ */
+static DS18B20_timing_state_t *ds18b20_timing(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
-        if (DS18B20_1W_SINGLEDEVICE != devicesNo)
-        {
-            // Search ROM from next device and set it.
-            status = ds18b20_searchRom(onewire, deviceIndex, checksum);
-            if (DS18B20_OK != status)
-            {
-                return status;
-            }
-        }
-        else
-        {
-            // Read ROM from device and set it.
-            status = ds18b20_readRom(onewire, checksum);
-            if (DS18B20_OK != status)
-            {
-                return status;
-            }
-        }
-        
-        // Default resolution after power-up is 12-bit, but prefer to check it and set it.
-        status = ds18b20_selectDevice(onewire, deviceIndex);
-        if (DS18B20_OK != status)
-        {
-            return status;
-        }
-        status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
-        if (DS18B20_OK != status)
-        {
-            return status;
-        }
+/**
+ * @brief Calculates time after which the convertion is expected to be finished.
+ * 
+ * @param timing Pointer to learned convertion time (can be NULL)
+ * @param resolution Convertion resolution
+ * @return uint16_t Expected convertion time (in milliseconds), the worst case time if nothing has been learned yet
+ */
+static uint16_t ds18b20_expectedMillis(const DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution);
 
-        // Read power mode and set it.
-        // If parasite mode then perform first temperature convertion, because it will not be reliable.
-        status = ds18b20_selectDevice(onewire, deviceIndex);
-        if (DS18B20_OK != status)
-        {
-            return status;
-        }
-        status = ds18b20_read_powermode(onewire, deviceIndex);
-        if (DS18B20_OK != status)
-        {
-            return status;
-        }
-        if (DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode)
-        {
-            status = ds18b20_requestTemperature(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD);
-            if (DS18B20_OK != status)
-            {
-                return status;
-            }
-        }
-    }
+/**
+ * @brief Calculates time after which the convertion is considered finished without asking the devices.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param timing Pointer to learned convertion time (can be NULL)
+ * @param resolution Convertion resolution
+ * @return uint16_t Convertion deadline (in milliseconds), never greater than the worst case time
+ */
+static uint16_t ds18b20_deadlineMillis(const DS18B20_onewire_t * const onewire, const DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution);
 
-    return DS18B20_OK;
-}
+/**
+ * @brief Updates learned convertion time with a new measurement.
+ * 
+ * @param timing Pointer to learned convertion time
+ * @param elapsedMs Measured convertion time (in milliseconds)
+ * @param resolution Convertion resolution
+ */
+static void ds18b20_learnConvertionTime(DS18B20_timing_state_t * const timing, const uint32_t elapsedMs, const DS18B20_resolution_t resolution);
 
-DS18B20_error_t ds18b20__InitConfigDefault(DS18B20_config_t * const config)
-{
-    if (!config)
-    {
-        return DS18B20_INV_ARG;
-    }
-    
-    config->upperAlarm = DS18B20_SP_TEMP_HIGH_DEFAULT_VALUE;
-    config->lowerAlarm = DS18B20_SP_TEMP_LOW_DEFAULT_VALUE;
-    config->resolution = ds18b20_config_byte_to_resolution(DS18B20_SP_CONFIG_DEFAULT_VALUE);
-    
-    return DS18B20_OK;
-}
+/**
+ * @brief Reads the last converted temperature from memory of the selected device.
+ * 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum);
 
-DS18B20_error_t ds18b20__RequestTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
-{
-    return ds18b20__RequestTemperatureCWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD);
-}
+/**
+ * @brief Reads the temperature bytes of chosen DS18B20 into its scratchpad without converting them.
+ * 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * If adaptive integrity mode is enabled, CRC checksum is additionally calculated whenever the reading is suspicious.
+ * If adaptive resolution mode is enabled, the reading is tracked to choose resolution of the next convertion.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readTemperatureBytes(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum);
 
-DS18B20_error_t ds18b20__RequestTemperatureCWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
-{
-    DS18B20_error_t status;
-    if (!onewire || deviceIndex >= onewire->devicesNo)
-    {
-        return DS18B20_INV_ARG;
-    }
+/**
+ * @brief Reads temperature bytes of the selected device verifying them according to adaptive integrity mode (if enabled).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readTemperatureWithIntegrity(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum);
 
-    status = ds18b20_requestTemperature(onewire, deviceIndex, checkPeriodMs);
-    if (DS18B20_OK != status)
-    {
-        return status;
-    }
+/**
+ * @brief Updates trend and noise of the selected device with its last reading and chooses resolution of its next convertion.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ */
+static void ds18b20_trackResolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
-    return DS18B20_OK;
-}
+/**
+ * @brief Chooses the coarsest resolution which still resolves given change between readings within targets of adaptive resolution mode.
+ * 
+ * @param policy Pointer to targets of adaptive resolution mode
+ * @param activity Change between readings (in 1/256 Celsius)
+ * @return DS18B20_resolution_t Chosen resolution
+ */
+static DS18B20_resolution_t ds18b20_chooseResolution(const DS18B20_resolution_policy_t * const policy, const uint32_t activity);
 
-DS18B20_error_t ds18b20__GetTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
-{
-    return ds18b20__GetTemperatureCWithChecking(onewire, deviceIndex, temperatureOut, DS18B20_NO_CHECK_PERIOD, checksum);
-}
+/**
+ * @brief Writes resolution chosen by adaptive resolution mode into configuration register of the selected device if it has changed.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_applyResolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
-DS18B20_error_t ds18b20__GetTemperatureCWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, uint16_t checkPeriodMs, const bool checksum)
-{
-    DS18B20_error_t status = ds18b20__RequestTemperatureCWithChecking(onewire, deviceIndex, checkPeriodMs);
-    if (DS18B20_OK != status)
-    {
-        return status;
-    }
+/**
+ * @brief Returns mirror of configurable registers of the selected device.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return DS18B20_mirror_t* Pointer to mirror, NULL if write avoidance is disabled
+ */
+static DS18B20_mirror_t *ds18b20_mirror(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
+/**
+ * @brief Checks if scratchpad of the selected device is known to hold given configurable registers already.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param registers Upper alarm, lower alarm and configuration registers
+ * @return bool True if writing the registers can be skipped
+ */
+static bool ds18b20_isMirrored(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint8_t * const registers);
+
+/**
+ * @brief Checks if EEPROM of the selected device is known to hold the same configurable registers as its scratchpad.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return bool True if copying scratchpad into EEPROM can be skipped
+ */
+static bool ds18b20_isStored(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Records that EEPROM of the selected device holds the same configurable registers as its scratchpad (if they are known).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ */
+static void ds18b20_mirrorEeprom(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Marks mirrored scratchpad registers of the selected device as stale.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ */
+static void ds18b20_invalidateRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Checks if cached temperature of the selected device is not older than the specified age.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param maxAgeMs Maximal age of cached temperature (in milliseconds)
+ * @param nowMs Current time (in milliseconds)
+ * @return bool True if cached temperature can be returned without accessing the bus
+ */
+static bool ds18b20_isFresh(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, const uint32_t nowMs);
+
+/**
+ * @brief Caches temperature lately read from the selected device together with the current time (if caching is enabled).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ */
+static void ds18b20_cacheTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Makes cached temperatures of all devices fresh enough, using single convertion for all stale ones.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param maxAgeMs Maximal age of cached temperatures (in milliseconds)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_refreshCache(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, const bool checksum);
+
+/**
+ * @brief Selects chosen DS18B20 and reads its temperature bytes (or the whole scratchpad if CRC checksum is calculated).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readTemperatureRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum);
+
+/**
+ * @brief Returns raw temperature lately read into scratchpad of chosen DS18B20.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return DS18B20_temperature_raw_t Temperature in 1/16 Celsius
+ */
+static DS18B20_temperature_raw_t ds18b20_lastTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Checks if temperature read without CRC checksum fits in limits of adaptive integrity mode.
+ * 
+ * Temperature is not plausible if it is out of range, changed too much since the last reading or equals to power-on reset value.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param state Pointer to adaptive integrity mode state of the device
+ * @param temperature Temperature in 1/16 Celsius
+ * @return true Temperature looks plausible
+ * @return false Temperature needs to be verified
+ */
+static bool ds18b20_isPlausible(const DS18B20_onewire_t * const onewire, const DS18B20_integrity_state_t * const state, const DS18B20_temperature_raw_t temperature);
+
+/**
+ * @brief Reads the temperature measured by chosen DS18B20 as raw value without any floating point operations.
+ * 
+ * Reads measured temperature from the device memory where it has been stored.
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature (in 1/16 Celsius) will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_readTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Converts temperatures lately read from all devices connected to One-Wire bus into human-readable values.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param temperaturesOut Array of variables (one per each device) where converted temperatures will be saved eventually
+ */
+static void ds18b20_convertTemperatures(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut);
+
+#ifdef ESP_PLATFORM
+DS18B20_error_t ds18b20__InitOneWire(DS18B20_onewire_t * const onewire, const int bus, DS18B20_t * const devices, const size_t devicesNo, const bool checksum)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->bus = bus;
+
+    return ds18b20__InitOneWireWithTransport(onewire, &ds18b20_gpio_transport, NULL, devices, devicesNo, checksum);
+}
+#endif /* ESP_PLATFORM */
+
+DS18B20_error_t ds18b20__InitOneWireWithTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t devicesNo, const bool checksum)
+{
+    if (!onewire || !devices || !devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_initOneWire(onewire, transport, transportContext, devices, NULL, devicesNo, checksum);
+}
+
+DS18B20_error_t ds18b20__InitOneWireWithStorage(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_storage_t * const storage, const size_t devicesNo, const bool checksum)
+{
+    if (!onewire || !storage || !devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_initOneWire(onewire, transport, transportContext, NULL, storage, devicesNo, checksum);
+}
+
+#ifdef ESP_PLATFORM
+DS18B20_error_t ds18b20__DiscoverOneWire(DS18B20_onewire_t * const onewire, const int bus, DS18B20_t * const devices, const size_t capacity, 
+    const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->bus = bus;
+
+    return ds18b20__DiscoverOneWireWithTransport(onewire, &ds18b20_gpio_transport, NULL, devices, capacity, familyCode, devicesNoOut, checksum);
+}
+#endif /* ESP_PLATFORM */
+
+DS18B20_error_t ds18b20__DiscoverOneWireWithTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum)
+{
+    if (!onewire || !devices || !capacity || !devicesNoOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_discoverOneWire(onewire, transport, transportContext, devices, NULL, capacity, familyCode, devicesNoOut, checksum);
+}
+
+DS18B20_error_t ds18b20__DiscoverOneWireWithStorage(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_storage_t * const storage, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum)
+{
+    if (!onewire || !storage || !capacity || !devicesNoOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_discoverOneWire(onewire, transport, transportContext, NULL, storage, capacity, familyCode, devicesNoOut, checksum);
+}
+
+DS18B20_error_t ds18b20__InitTopology(DS18B20_topology_t * const topology, const DS18B20_topology_store_t * const store, void * const storeContext, 
+    uint8_t * const blob, const size_t blobSize)
+{
+    if (!topology || !store || !store->load || !store->save || !blob)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    topology->store = store;
+    topology->storeContext = storeContext;
+    topology->blob = blob;
+    topology->blobSize = blobSize;
+    topology->warm = false;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InitOneWireWithTopology(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t devicesNo, DS18B20_topology_t * const topology, const bool checksum)
+{
+    if (!onewire || !devices || !devicesNo || !topology)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    topology->warm = false;
+    DS18B20_error_t status = ds18b20_attachTransport(onewire, transport, transportContext, devices, NULL, devicesNo);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    onewire->busDevicesNo = devicesNo;
+
+    size_t blobSize;
+    if (DS18B20_OK == topology->store->load(topology->storeContext, topology->blob, topology->blobSize, &blobSize)
+        && DS18B20_OK == ds18b20_importTopology(onewire, topology->blob, blobSize, checksum)
+        && DS18B20_OK == ds18b20_initDevices(onewire, checksum, &topology->blob[DS18B20_TOPOLOGY_HEADER_SIZE]))
+    {
+        topology->warm = true;
+        return DS18B20_OK;
+    }
+
+    // Bus has changed since the topology was saved (or it has never been saved), so it has to be searched again
+    status = ds18b20_initOneWire(onewire, transport, transportContext, devices, NULL, devicesNo, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return ds18b20__SaveTopology(onewire, topology);
+}
+
+DS18B20_error_t ds18b20__ExportTopology(const DS18B20_onewire_t * const onewire, uint8_t * const blob, const size_t blobSize, size_t * const sizeOut)
+{
+    if (!onewire || !blob || !sizeOut || onewire->devicesNo > UINT16_MAX || DS18B20_TOPOLOGY_SIZE(onewire->devicesNo) > blobSize)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    blob[0] = DS18B20_TOPOLOGY_MAGIC;
+    blob[1] = DS18B20_TOPOLOGY_VERSION;
+    blob[2] = (uint8_t) onewire->devicesNo;
+    blob[3] = (uint8_t) (onewire->devicesNo >> 8);
+
+    // Flags are packed the same way as in device storage
+    uint8_t * const records = &blob[DS18B20_TOPOLOGY_HEADER_SIZE];
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        uint8_t * const record = &records[deviceIndex * DS18B20_TOPOLOGY_RECORD_SIZE];
+        memcpy(record, ds18b20_device_rom(onewire, deviceIndex), DS18B20_ROM_SIZE);
+        record[DS18B20_ROM_SIZE] = ds18b20_device_resolution(onewire, deviceIndex) 
+            | (ds18b20_device_powermode(onewire, deviceIndex) << DS18B20_STORAGE_POWERMODE_SHIFT);
+    }
+
+    size_t size = DS18B20_TOPOLOGY_SIZE(onewire->devicesNo);
+    blob[size - 1] = ds18b20_crc8(blob, size - 1);
+    *sizeOut = size;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SaveTopology(const DS18B20_onewire_t * const onewire, const DS18B20_topology_t * const topology)
+{
+    if (!onewire || !topology)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    size_t blobSize;
+    DS18B20_error_t status = ds18b20__ExportTopology(onewire, topology->blob, topology->blobSize, &blobSize);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return topology->store->save(topology->storeContext, topology->blob, blobSize);
+}
+
+DS18B20_error_t ds18b20__InitStorage(DS18B20_storage_t * const storage, DS18B20_rom_t * const roms, DS18B20_temperature_raw_t * const temperatures, uint8_t * const flags)
+{
+    if (!storage || !roms || !temperatures || !flags)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    storage->roms = roms;
+    storage->temperatures = temperatures;
+    storage->flags = flags;
+    memset(storage->scratchpad, DS18B20_DEFAULT_VALUE, DS18B20_SP_SIZE);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetDeviceView(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_t * const viewOut)
+{
+    if (!onewire || deviceIndex >= onewire->devicesNo || !viewOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!onewire->storage)
+    {
+        *viewOut = onewire->devices[deviceIndex];
+        return DS18B20_OK;
+    }
+
+    // Only temperature and configuration are known for every device, the rest of scratchpad is not stored
+    memcpy(viewOut->rom, ds18b20_device_rom(onewire, deviceIndex), DS18B20_ROM_SIZE);
+    memset(viewOut->scratchpad, DS18B20_DEFAULT_VALUE, DS18B20_SP_SIZE);
+    viewOut->resolution = ds18b20_device_resolution(onewire, deviceIndex);
+    viewOut->powerMode = ds18b20_device_powermode(onewire, deviceIndex);
+    viewOut->scratchpad[DS18B20_SP_TEMP_LSB_BYTE] = (uint16_t) onewire->storage->temperatures[deviceIndex] & 0xFF;
+    viewOut->scratchpad[DS18B20_SP_TEMP_MSB_BYTE] = (uint16_t) onewire->storage->temperatures[deviceIndex] >> 8;
+    viewOut->scratchpad[DS18B20_SP_CONFIG_BYTE] = ds18b20_resolution_to_config_byte(viewOut->resolution);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InitIntegrityDefault(DS18B20_integrity_t * const integrity)
+{
+    if (!integrity)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    integrity->minTemperature = DS18B20_TEMPERATURE_MIN_RAW;
+    integrity->maxTemperature = DS18B20_TEMPERATURE_MAX_RAW;
+    integrity->maxChange = DS18B20_INTEGRITY_MAX_CHANGE_DEFAULT;
+    integrity->escalationReads = DS18B20_INTEGRITY_ESCALATION_READS_DEFAULT;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__EnableAdaptiveIntegrity(DS18B20_onewire_t * const onewire, const DS18B20_integrity_t * const integrity, 
+    DS18B20_integrity_state_t * const states, const size_t statesNo)
+{
+    if (!onewire || !integrity || !states || statesNo < onewire->devicesNo 
+        || integrity->minTemperature > integrity->maxTemperature || integrity->maxChange < 0)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    // Nothing is known about the devices yet, so the first reading of each one is always verified
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        states[deviceIndex].lastTemperature = DS18B20_SP_TEMP_DEFAULT_VALUE;
+        states[deviceIndex].fullReadsLeft = 1;
+    }
+    onewire->integrity = *integrity;
+    onewire->integrityStates = states;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__DisableAdaptiveIntegrity(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->integrityStates = NULL;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__EnableConvertionLearning(DS18B20_onewire_t * const onewire, DS18B20_timing_state_t * const states, 
+    const size_t statesNo, const uint16_t marginMs)
+{
+    if (!onewire || !states || statesNo <= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(states, DS18B20_DEFAULT_VALUE, (onewire->devicesNo + 1) * sizeof(DS18B20_timing_state_t));
+    onewire->timingStates = states;
+    onewire->timingMarginMs = marginMs;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__DisableConvertionLearning(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->timingStates = NULL;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InitResolutionPolicyDefault(DS18B20_resolution_policy_t * const policy)
+{
+    if (!policy)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    policy->minResolution = DS18B20_RESOLUTION_09;
+    policy->maxConvertionMs = DS18B20_RESOLUTION_12_DELAY_MS;
+    policy->stepsPerChange = DS18B20_RESOLUTION_STEPS_PER_CHANGE_DEFAULT;
+    policy->settleReadings = DS18B20_RESOLUTION_SETTLE_READINGS_DEFAULT;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__EnableAdaptiveResolution(DS18B20_onewire_t * const onewire, const DS18B20_resolution_policy_t * const policy, 
+    DS18B20_resolution_state_t * const states, const size_t statesNo)
+{
+    if (!onewire || !policy || !states || statesNo < onewire->devicesNo 
+        || policy->minResolution >= DS18B20_RESOLUTION_COUNT || !policy->stepsPerChange)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        // Nothing is known about the devices yet, so they start with the highest resolution allowed
+        memset(&states[deviceIndex], DS18B20_DEFAULT_VALUE, sizeof(DS18B20_resolution_state_t));
+        states[deviceIndex].resolution = ds18b20_chooseResolution(policy, 0);
+    }
+    onewire->resolutionPolicy = *policy;
+    onewire->resolutionStates = states;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__DisableAdaptiveResolution(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->resolutionStates = NULL;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__EnableWriteAvoidance(DS18B20_onewire_t * const onewire, DS18B20_mirror_t * const mirrors, const size_t mirrorsNo)
+{
+    if (!onewire || !mirrors || mirrorsNo < onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(mirrors, DS18B20_DEFAULT_VALUE, onewire->devicesNo * sizeof(DS18B20_mirror_t));
+    onewire->mirrors = mirrors;
+    onewire->mirrorGeneration = DS18B20_MIRROR_STALE + 1;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__DisableWriteAvoidance(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->mirrors = NULL;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InvalidateMirrors(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (DS18B20_MIRROR_STALE == ++onewire->mirrorGeneration)
+    {
+        ++onewire->mirrorGeneration;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__EnableTemperatureCache(DS18B20_onewire_t * const onewire, DS18B20_cache_entry_t * const entries, const size_t entriesNo)
+{
+    if (!onewire || !entries || entriesNo < onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(entries, DS18B20_DEFAULT_VALUE, onewire->devicesNo * sizeof(DS18B20_cache_entry_t));
+    onewire->cache = entries;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__DisableTemperatureCache(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    onewire->cache = NULL;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InvalidateTemperatureCache(DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (onewire->cache)
+    {
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            onewire->cache[deviceIndex].valid = false;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperatureCCached(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
+{
+    if (!temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_temperature_raw_t raw;
+    DS18B20_error_t status = ds18b20__GetTemperatureRawCached(onewire, deviceIndex, maxAgeMs, &raw, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    *temperatureOut = ds18b20_convert_temperature_raw(raw);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperatureRawCached(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum)
+{
+    if (!onewire || deviceIndex >= onewire->devicesNo || !temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (ds18b20_isFresh(onewire, deviceIndex, maxAgeMs, ds18b20_get_millis(onewire)))
+    {
+        *temperatureOut = onewire->cache[deviceIndex].temperature;
+        return DS18B20_OK;
+    }
+
+    return ds18b20__GetTemperatureRaw(onewire, deviceIndex, temperatureOut, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesCCached(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum)
+{
+    if (!onewire || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!onewire->cache)
+    {
+        return ds18b20__GetTemperaturesC(onewire, temperaturesOut, checksum);
+    }
+
+    DS18B20_error_t status = ds18b20_refreshCache(onewire, maxAgeMs, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        temperaturesOut[deviceIndex] = ds18b20_convert_temperature_raw(onewire->cache[deviceIndex].temperature);
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesRawCached(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum)
+{
+    if (!onewire || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!onewire->cache)
+    {
+        return ds18b20__GetTemperaturesRaw(onewire, temperaturesOut, checksum);
+    }
+
+    DS18B20_error_t status = ds18b20_refreshCache(onewire, maxAgeMs, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        temperaturesOut[deviceIndex] = onewire->cache[deviceIndex].temperature;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SetCriticalScope(DS18B20_onewire_t * const onewire, const DS18B20_critical_t critical)
+{
+    if (!onewire || critical >= DS18B20_CRITICAL_COUNT || ds18b20_port_holds_critical(&onewire->lock))
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    // Waits for transaction performed by other task, so it is not finished with different scope
+    ds18b20_port_enter_critical(&onewire->lock);
+    onewire->critical = critical;
+    ds18b20_port_exit_critical(&onewire->lock);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InitConfigDefault(DS18B20_config_t * const config)
+{
+    if (!config)
+    {
+        return DS18B20_INV_ARG;
+    }
+    
+    config->upperAlarm = DS18B20_SP_TEMP_HIGH_DEFAULT_VALUE;
+    config->lowerAlarm = DS18B20_SP_TEMP_LOW_DEFAULT_VALUE;
+    config->resolution = ds18b20_config_byte_to_resolution(DS18B20_SP_CONFIG_DEFAULT_VALUE);
+    
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__RequestTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    return ds18b20__RequestTemperatureCWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD);
+}
+
+DS18B20_error_t ds18b20__RequestTemperatureCWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    status = ds18b20_requestTemperature(onewire, deviceIndex, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
+{
+    return ds18b20__GetTemperatureCWithChecking(onewire, deviceIndex, temperatureOut, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperatureCWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, uint16_t checkPeriodMs, const bool checksum)
+{
+    if (!temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_error_t status = ds18b20__RequestTemperatureCWithChecking(onewire, deviceIndex, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return ds18b20_readTemperature(onewire, deviceIndex, temperatureOut, checksum);
+}
+
+DS18B20_error_t ds18b20__RequestTemperaturesC(const DS18B20_onewire_t * const onewire)
+{
+    return ds18b20__RequestTemperaturesCWithChecking(onewire, DS18B20_NO_CHECK_PERIOD);
+}
+
+DS18B20_error_t ds18b20__RequestTemperaturesCWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    status = ds18b20_requestTemperatures(onewire, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum)
+{
+    return ds18b20__GetTemperaturesCWithChecking(onewire, temperaturesOut, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesCWithChecking(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut, uint16_t checkPeriodMs, const bool checksum)
+{
+    if (!temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_error_t status = ds18b20__RequestTemperaturesCWithChecking(onewire, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        status = ds18b20_readTemperatureBytes(onewire, deviceIndex, checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+    ds18b20_convertTemperatures(onewire, temperaturesOut);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__StartTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion)
+{
+    if (!onewire || deviceIndex >= onewire->devicesNo || !convertion)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_startTemperature(onewire, deviceIndex, convertion);
+}
+
+DS18B20_error_t ds18b20__StartTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion)
+{
+    if (!onewire || !convertion)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    return ds18b20_startTemperatures(onewire, convertion);
+}
+
+DS18B20_error_t ds18b20__IsConvertionReady(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, bool * const readyOut)
+{
+    if (!onewire || !convertion || !readyOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!convertion->ready)
+    {
+        // Devices cannot be asked about the status while they are powered by strong pullup.
+        if (DS18B20_WAITING_END <= (int32_t)(ds18b20_get_millis(onewire) - convertion->deadlineMs)
+            || (!convertion->strongPullup && ds18b20_read_bit(onewire)))
+        {
+            ds18b20_finishConvertion(onewire, convertion);
+        }
+    }
+
+    *readyOut = convertion->ready;
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__CollectTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo || !temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    bool ready;
+    status = ds18b20__IsConvertionReady(onewire, convertion, &ready);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    if (!ready)
+    {
+        return DS18B20_NOT_READY;
+    }
+
+    return ds18b20_readTemperature(onewire, deviceIndex, temperatureOut, checksum);
+}
+
+DS18B20_error_t ds18b20__CollectTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    bool ready;
+    status = ds18b20__IsConvertionReady(onewire, convertion, &ready);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    if (!ready)
+    {
+        return DS18B20_NOT_READY;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        status = ds18b20_readTemperatureBytes(onewire, deviceIndex, checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+    ds18b20_convertTemperatures(onewire, temperaturesOut);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__GetTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum)
+{
+    return ds18b20__GetTemperatureRawWithChecking(onewire, deviceIndex, temperatureOut, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperatureRawWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, uint16_t checkPeriodMs, const bool checksum)
+{
+    if (!temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_error_t status = ds18b20__RequestTemperatureCWithChecking(onewire, deviceIndex, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return ds18b20_readTemperatureRaw(onewire, deviceIndex, temperatureOut, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesRaw(const DS18B20_onewire_t * const onewire, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum)
+{
+    return ds18b20__GetTemperaturesRawWithChecking(onewire, temperaturesOut, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__GetTemperaturesRawWithChecking(const DS18B20_onewire_t * const onewire, DS18B20_temperature_raw_t * const temperaturesOut, uint16_t checkPeriodMs, const bool checksum)
+{
+    if (!temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_error_t status = ds18b20__RequestTemperaturesCWithChecking(onewire, checkPeriodMs);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        status = ds18b20_readTemperatureRaw(onewire, deviceIndex, &temperaturesOut[deviceIndex], checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__CollectTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo || !temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    bool ready;
+    status = ds18b20__IsConvertionReady(onewire, convertion, &ready);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    if (!ready)
+    {
+        return DS18B20_NOT_READY;
+    }
+
+    return ds18b20_readTemperatureRaw(onewire, deviceIndex, temperatureOut, checksum);
+}
+
+DS18B20_error_t ds18b20__CollectTemperaturesRaw(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    bool ready;
+    status = ds18b20__IsConvertionReady(onewire, convertion, &ready);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    if (!ready)
+    {
+        return DS18B20_NOT_READY;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        status = ds18b20_readTemperatureRaw(onewire, deviceIndex, &temperaturesOut[deviceIndex], checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_temperature_out_t ds18b20__RawToC(const DS18B20_temperature_raw_t raw)
+{
+    return ds18b20_convert_temperature_raw(raw);
+}
+
+DS18B20_temperature_milli_t ds18b20__RawToMilliC(const DS18B20_temperature_raw_t raw)
+{
+    return ds18b20_convert_temperature_raw_to_milli(raw);
+}
+
+DS18B20_error_t ds18b20__Configure(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_config_t * const config, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    const uint8_t registers[DS18B20_SP_REGISTERS_SIZE] = 
+    { 
+        config->upperAlarm, config->lowerAlarm, ds18b20_resolution_to_config_byte(config->resolution) 
+    };
+    if (ds18b20_isMirrored(onewire, deviceIndex, registers))
+    {
+        return DS18B20_OK;
+    }
+
+    uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
+    memcpy(&scratchpad[DS18B20_SP_TEMP_HIGH_BYTE], registers, DS18B20_SP_REGISTERS_SIZE);
+
+    ds18b20_invalidateRegisters(onewire, deviceIndex);
+    status = ds18b20_selectDevice(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_write_scratchpad(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    status = ds18b20_selectDevice(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__FindNextAlarm(DS18B20_onewire_t * const onewire, size_t * const deviceIndexOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || !deviceIndexOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_rom_t alarmRom;
+    status = ds18b20_searchAlarm(onewire, &alarmRom, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return ds18b20__FindDeviceByRom(onewire, alarmRom, deviceIndexOut);
+}
+
+DS18B20_error_t ds18b20__VerifyRoms(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t * const roms, const size_t romsNo, 
+    bool * const presentOut, size_t * const presentNoOut)
+{
+    if (!onewire || !roms || !presentOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    size_t presentNo = 0;
+    for (size_t i = 0; i < romsNo; ++i)
+    {
+        DS18B20_error_t status = ds18b20_verify_rom(onewire, roms[i], &presentOut[i]);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        presentNo += presentOut[i];
+    }
+
+    if (presentNoOut)
+    {
+        *presentNoOut = presentNo;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__VerifyDevices(const DS18B20_onewire_t * const onewire, uint32_t * const presentOut, size_t * const presentNoOut)
+{
+    if (!onewire || !presentOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(presentOut, DS18B20_DEFAULT_VALUE, DS18B20_ALARM_BITMAP_WORDS(onewire->devicesNo) * sizeof(uint32_t));
+    size_t presentNo = 0;
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        bool present;
+        DS18B20_error_t status = ds18b20_verify_rom(onewire, ds18b20_device_rom(onewire, deviceIndex), &present);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        if (present)
+        {
+            presentOut[deviceIndex / DS18B20_ALARM_BITMAP_WORD_BITS] |= 1UL << (deviceIndex % DS18B20_ALARM_BITMAP_WORD_BITS);
+            ++presentNo;
+        }
+    }
+
+    if (presentNoOut)
+    {
+        *presentNoOut = presentNo;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__FindAllAlarms(const DS18B20_onewire_t * const onewire, uint32_t * const alarmsOut, size_t * const alarmsNoOut, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || !alarmsOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(alarmsOut, DS18B20_DEFAULT_VALUE, DS18B20_ALARM_BITMAP_WORDS(onewire->devicesNo) * sizeof(uint32_t));
+    size_t alarmsNo = 0;
+    size_t cyclesNo = 0;
+
+    DS18B20_search_t search;
+    ds18b20_search_start(&search);
+    while (DS18B20_OK == (status = ds18b20_search_next(onewire, &search, true)))
+    {
+        ++cyclesNo;
+        if (checksum && DS18B20_OK != ds18b20_validate_crc8(search.rom, DS18B20_ROM_SIZE_TO_VALIDATE, 
+            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, search.rom[DS18B20_ROM_CRC_BYTE]))
+        {
+            return DS18B20_CRC_FAIL;
+        }
+
+        size_t deviceIndex;
+        if (DS18B20_OK == ds18b20__FindDeviceByRom(onewire, search.rom, &deviceIndex))
+        {
+            alarmsOut[deviceIndex / DS18B20_ALARM_BITMAP_WORD_BITS] |= 1UL << (deviceIndex % DS18B20_ALARM_BITMAP_WORD_BITS);
+            ++alarmsNo;
+        }
+    }
+
+    // No devices replying to the first cycle means no alarms at all
+    if (DS18B20_NO_MORE_DEVICES != status && !(DS18B20_NO_DEVICES == status && !cyclesNo))
+    {
+        return status;
+    }
+
+    if (alarmsNoOut)
+    {
+        *alarmsNoOut = alarmsNo;
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__BuildRomIndex(DS18B20_onewire_t * const onewire, size_t * const slots, const size_t slotsNo)
+{
+    if (!onewire || !slots || slotsNo <= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    for (size_t i = 0; i < slotsNo; ++i)
+    {
+        slots[i] = DS18B20_ROM_INDEX_EMPTY;
+    }
+
+    // Linear probing - there is always at least one empty slot, so every probe sequence ends
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        size_t slot = ds18b20_hashRom(ds18b20_device_rom(onewire, deviceIndex)) % slotsNo;
+        while (DS18B20_ROM_INDEX_EMPTY != slots[slot])
+        {
+            slot = (slot + 1) % slotsNo;
+        }
+        slots[slot] = deviceIndex;
+    }
+
+    onewire->romIndex = slots;
+    onewire->romIndexSize = slotsNo;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__FindDeviceByRom(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t rom, size_t * const deviceIndexOut)
+{
+    if (!onewire || !rom || !deviceIndexOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!onewire->romIndex)
+    {
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            if (0 == memcmp(ds18b20_device_rom(onewire, deviceIndex), rom, DS18B20_ROM_SIZE))
+            {
+                *deviceIndexOut = deviceIndex;
+                return DS18B20_OK;
+            }
+        }
+        return DS18B20_DEVICE_NOT_FOUND;
+    }
+
+    size_t slot = ds18b20_hashRom(rom) % onewire->romIndexSize;
+    while (DS18B20_ROM_INDEX_EMPTY != onewire->romIndex[slot])
+    {
+        size_t deviceIndex = onewire->romIndex[slot];
+        if (0 == memcmp(ds18b20_device_rom(onewire, deviceIndex), rom, DS18B20_ROM_SIZE))
+        {
+            *deviceIndexOut = deviceIndex;
+            return DS18B20_OK;
+        }
+        slot = (slot + 1) % onewire->romIndexSize;
+    }
+
+    return DS18B20_DEVICE_NOT_FOUND;
+}
+
+DS18B20_error_t ds18b20__StoreRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    return ds18b20__StoreRegistersWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD);
+}
+
+DS18B20_error_t ds18b20__StoreRegistersWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    uint16_t waitPeriodMs = DS18B20_SCRATCHPAD_COPY_DELAY_MS;
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = waitPeriodMs;
+    }
+    else if (DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex))
+    {
+        return DS18B20_INV_OP;
+    }
+    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    // EEPROM has limited lifetime and copying stalls the bus, so it is skipped if nothing would change
+    if (ds18b20_isStored(onewire, deviceIndex))
+    {
+        return DS18B20_OK;
+    }
+
+    status = ds18b20_selectDevice(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_copy_scratchpad(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+
+    if (DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex))
+    {
+        ds18b20_parasite_end_pullup(onewire);
+    }
+    ds18b20_mirrorEeprom(onewire, deviceIndex);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__RestoreRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
+{
+    return ds18b20__RestoreRegistersWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__RestoreRegistersWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || deviceIndex >= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    uint16_t waitPeriodMs = DS18B20_EEPROM_RESTORE_DELAY_MS;
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = waitPeriodMs;
+    }
+    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    status = ds18b20_selectDevice(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_recall_e2(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+
+    status = ds18b20_selectDevice(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    ds18b20_mirrorEeprom(onewire, deviceIndex);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__ConfigureAll(const DS18B20_onewire_t * const onewire, const DS18B20_config_t * const config, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire || !config)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    // Devices not handled by this instance must keep their registers, so handled ones are addressed separately
+    if (!ds18b20_ownsBus(onewire))
+    {
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            status = ds18b20__Configure(onewire, deviceIndex, config, checksum);
+            if (DS18B20_OK != status)
+            {
+                return status;
+            }
+        }
+        return DS18B20_OK;
+    }
+
+    DS18B20_scratchpad_t scratchpad;
+    scratchpad[DS18B20_SP_TEMP_HIGH_BYTE] = config->upperAlarm;
+    scratchpad[DS18B20_SP_TEMP_LOW_BYTE] = config->lowerAlarm;
+    scratchpad[DS18B20_SP_CONFIG_BYTE] = ds18b20_resolution_to_config_byte(config->resolution);
+
+    size_t mirroredNo = 0;
+    while (mirroredNo < onewire->devicesNo && ds18b20_isMirrored(onewire, mirroredNo, &scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]))
+    {
+        ++mirroredNo;
+    }
+    if (onewire->devicesNo == mirroredNo)
+    {
+        return DS18B20_OK;
+    }
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        ds18b20_invalidateRegisters(onewire, deviceIndex);
+    }
+
+    status = ds18b20_skip_select_all(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_write_scratchpad_all(onewire, scratchpad);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    return ds18b20_readAllRegisters(onewire, scratchpad, checksum);
+}
+
+DS18B20_error_t ds18b20__StoreRegistersAll(const DS18B20_onewire_t * const onewire)
+{
+    return ds18b20__StoreRegistersAllWithChecking(onewire, DS18B20_NO_CHECK_PERIOD);
+}
+
+DS18B20_error_t ds18b20__StoreRegistersAllWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!ds18b20_ownsBus(onewire))
+    {
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            status = ds18b20__StoreRegistersWithChecking(onewire, deviceIndex, checkPeriodMs);
+            if (DS18B20_OK != status)
+            {
+                return status;
+            }
+        }
+        return DS18B20_OK;
+    }
+
+    uint16_t waitPeriodMs = DS18B20_SCRATCHPAD_COPY_DELAY_MS;
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = waitPeriodMs;
+    }
+    else if (ds18b20_bus_parasite(onewire))
+    {
+        return DS18B20_INV_OP;
+    }
+    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    size_t storedNo = 0;
+    while (storedNo < onewire->devicesNo && ds18b20_isStored(onewire, storedNo))
+    {
+        ++storedNo;
+    }
+    if (onewire->devicesNo == storedNo)
+    {
+        return DS18B20_OK;
+    }
+
+    status = ds18b20_skip_select_all(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_copy_scratchpad_all(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    // All devices hold the line low until they finish, so the status check reports the slowest one
+    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+
+    if (ds18b20_bus_parasite(onewire))
+    {
+        ds18b20_parasite_end_pullup(onewire);
+    }
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        ds18b20_mirrorEeprom(onewire, deviceIndex);
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__RestoreRegistersAll(const DS18B20_onewire_t * const onewire, const bool checksum)
+{
+    return ds18b20__RestoreRegistersAllWithChecking(onewire, DS18B20_NO_CHECK_PERIOD, checksum);
+}
+
+DS18B20_error_t ds18b20__RestoreRegistersAllWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!ds18b20_ownsBus(onewire))
+    {
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            status = ds18b20__RestoreRegistersWithChecking(onewire, deviceIndex, checkPeriodMs, checksum);
+            if (DS18B20_OK != status)
+            {
+                return status;
+            }
+        }
+        return DS18B20_OK;
+    }
+
+    uint16_t waitPeriodMs = DS18B20_EEPROM_RESTORE_DELAY_MS;
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = waitPeriodMs;
+    }
+    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    status = ds18b20_skip_select_all(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_recall_e2(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+
+    status = ds18b20_readAllRegisters(onewire, NULL, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        ds18b20_mirrorEeprom(onewire, deviceIndex);
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_initOneWire(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t devicesNo, const bool checksum)
+{
+    DS18B20_error_t status = ds18b20_attachTransport(onewire, transport, transportContext, devices, storage, devicesNo);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    onewire->busDevicesNo = devicesNo;
+
+    // Manually calling restart search for the first time, because internal values have not been set yet.
+    status = ds18b20_restart_search(onewire, false);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    for (size_t deviceIndex = 0; deviceIndex < devicesNo; ++deviceIndex)
+    {
+        // Clear rom
+        memset(ds18b20_device_rom(onewire, deviceIndex), DS18B20_DEFAULT_VALUE, DS18B20_ROM_SIZE);
+
+        if (DS18B20_1W_SINGLEDEVICE != devicesNo)
+        {
+            // Search ROM from next device and set it.
+            status = ds18b20_searchRom(onewire, deviceIndex, checksum);
+            if (DS18B20_OK != status)
+            {
+                return status;
+            }
+        }
+        else
+        {
+            // Read ROM from device and set it.
+            status = ds18b20_readRom(onewire, checksum);
+            if (DS18B20_OK != status)
+            {
+                return status;
+            }
+        }
+    }
+
+    return ds18b20_initDevices(onewire, checksum, NULL);
+}
+
+static DS18B20_error_t ds18b20_discoverOneWire(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum)
+{
+    *devicesNoOut = 0;
+
+    DS18B20_error_t status = ds18b20_attachTransport(onewire, transport, transportContext, devices, storage, capacity);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    status = ds18b20_restart_search(onewire, false);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    // Enumerate the whole bus - devices of other families are counted as well, so skipping ROM is never used for them
+    size_t busDevicesNo = 0;
+    size_t devicesNo = 0;
+    DS18B20_rom_t rom;
+    while (DS18B20_OK == (status = ds18b20_search_rom(onewire, &rom, false)))
+    {
+        ++busDevicesNo;
+        if (checksum && DS18B20_OK != ds18b20_validate_crc8(rom, DS18B20_ROM_SIZE_TO_VALIDATE, DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, rom[DS18B20_ROM_CRC_BYTE]))
+        {
+            return DS18B20_CRC_FAIL;
+        }
+        if (DS18B20_ANY_FAMILY != familyCode && familyCode != rom[DS18B20_ROM_FAMILY_CODE_BYTE])
+        {
+            continue;
+        }
+        if (devicesNo < capacity)
+        {
+            memcpy(ds18b20_device_rom(onewire, devicesNo), rom, DS18B20_ROM_SIZE);
+        }
+        ++devicesNo;
+    }
+    if (DS18B20_NO_MORE_DEVICES != status)
+    {
+        return status;
+    }
+
+    *devicesNoOut = devicesNo;
+    if (!devicesNo)
+    {
+        return DS18B20_DEVICE_NOT_FOUND;
+    }
+    onewire->devicesNo = devicesNo < capacity ? devicesNo : capacity;
+    onewire->busDevicesNo = busDevicesNo;
+
+    return ds18b20_initDevices(onewire, checksum, NULL);
+}
+
+static DS18B20_error_t ds18b20_attachTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, DS18B20_storage_t * const storage, const size_t devicesNo)
+{
+    if (!transport || !transport->reset || !transport->write_bit || !transport->read_bit 
+        || !transport->start_pullup || !transport->end_pullup || !transport->get_millis || !transport->delay_ms)
+    {
+        return DS18B20_INV_CONF;
+    }
+
+    onewire->transport = transport;
+    onewire->transportContext = transportContext;
+    onewire->devices = devices;
+    onewire->storage = storage;
+    onewire->devicesNo = devicesNo;
+    onewire->romIndex = NULL;
+    onewire->romIndexSize = 0;
+    onewire->integrityStates = NULL;
+    onewire->timingStates = NULL;
+    onewire->resolutionStates = NULL;
+    onewire->mirrors = NULL;
+    onewire->cache = NULL;
+    onewire->busParasite = false;
+    ds18b20_port_spinlock_init(&onewire->lock);
+    onewire->critical = DS18B20_CRITICAL_SLOT;
+
+    if (transport->init)
+    {
+        return transport->init(onewire);
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_initDevices(DS18B20_onewire_t * const onewire, const bool checksum, const uint8_t * const records)
+{
+    DS18B20_error_t status;
+
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        // Clear scratchpad
+        memset(ds18b20_device_scratchpad(onewire, deviceIndex), DS18B20_DEFAULT_VALUE, DS18B20_SP_SIZE);
+        if (onewire->storage)
+        {
+            onewire->storage->flags[deviceIndex] = DS18B20_DEFAULT_VALUE;
+        }
+
+        // Default resolution after power-up is 12-bit, but prefer to check it and set it.
+        status = ds18b20_selectDevice(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+
+        // Nobody drives the line after selecting missing device, so its configuration is read as all ones
+        const uint8_t config = ds18b20_device_scratchpad(onewire, deviceIndex)[DS18B20_SP_CONFIG_BYTE];
+        if (records && DS18B20_SP_CONFIG_RESERVED_VALUE != (config & DS18B20_SP_CONFIG_RESERVED_MASK))
+        {
+            return DS18B20_VERIFY_FAIL;
+        }
+    }
+
+    // Read power mode of the whole bus at once, devices are probed separately only if any of them is parasite powered.
+    DS18B20_powermode_t busPowerMode;
+    status = ds18b20_skip_select_all(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    status = ds18b20_read_powermode_all(onewire, &busPowerMode);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    onewire->busParasite = DS18B20_PM_PARASITE == busPowerMode;
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        if (records)
+        {
+            const uint8_t flags = records[deviceIndex * DS18B20_TOPOLOGY_RECORD_SIZE + DS18B20_ROM_SIZE];
+            ds18b20_device_set_powermode(onewire, deviceIndex, (flags >> DS18B20_STORAGE_POWERMODE_SHIFT) & 1);
+            continue;
+        }
+        if (DS18B20_PM_PARASITE != busPowerMode || DS18B20_1W_SINGLEDEVICE == onewire->busDevicesNo)
+        {
+            ds18b20_device_set_powermode(onewire, deviceIndex, busPowerMode);
+            continue;
+        }
+
+        status = ds18b20_selectDevice(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        status = ds18b20_read_powermode(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+
+    if (records && (DS18B20_PM_PARASITE == busPowerMode) != ds18b20_any_parasite(onewire))
+    {
+        return DS18B20_VERIFY_FAIL;
+    }
+
+    // If parasite mode then perform first temperature convertion, because it will not be reliable.
+    // All devices convert at once, so the bus waits for the slowest one only.
+    if (ds18b20_any_parasite(onewire))
+    {
+        status = ds18b20_requestTemperatures(onewire, DS18B20_NO_CHECK_PERIOD);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_importTopology(const DS18B20_onewire_t * const onewire, const uint8_t * const blob, const size_t blobSize, const bool checksum)
+{
+    if (DS18B20_TOPOLOGY_SIZE(onewire->devicesNo) != blobSize || DS18B20_TOPOLOGY_MAGIC != blob[0] || DS18B20_TOPOLOGY_VERSION != blob[1]
+        || onewire->devicesNo != (size_t) (blob[2] | (blob[3] << 8)) || ds18b20_crc8(blob, blobSize - 1) != blob[blobSize - 1])
+    {
+        return DS18B20_VERIFY_FAIL;
+    }
+
+    const uint8_t * const records = &blob[DS18B20_TOPOLOGY_HEADER_SIZE];
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        memcpy(ds18b20_device_rom(onewire, deviceIndex), &records[deviceIndex * DS18B20_TOPOLOGY_RECORD_SIZE], DS18B20_ROM_SIZE);
+    }
+
+    if (DS18B20_1W_SINGLEDEVICE == onewire->devicesNo)
+    {
+        DS18B20_error_t status = ds18b20_readRom(onewire, checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        if (memcmp(ds18b20_device_rom(onewire, 0), records, DS18B20_ROM_SIZE))
+        {
+            return DS18B20_VERIFY_FAIL;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+static uint32_t ds18b20_hashRom(const DS18B20_rom_t rom)
+{
+    // Family code is shared by devices of the same type and CRC is derived from the rest, so only serial number is hashed
+    uint32_t hash = DS18B20_ROM_HASH_BASIS;
+    for (uint8_t i = DS18B20_ROM_FAMILY_CODE_BYTE + 1; i < DS18B20_ROM_CRC_BYTE; ++i)
+    {
+        hash = (hash ^ rom[i]) * DS18B20_ROM_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+static void ds18b20_waitWithChecking(const DS18B20_onewire_t * const onewire, uint16_t waitPeriodMs, const uint16_t checkPeriodMs)
+{
+    while (true)
+    {
+        ds18b20_delay_ms(onewire, checkPeriodMs);
+
+        if (DS18B20_WAITING_END >= (int16_t)(waitPeriodMs - checkPeriodMs) || ds18b20_read_bit(onewire))
+        {
+            break;
+        }
+
+        waitPeriodMs -= checkPeriodMs;
+    }
+}
+
+static DS18B20_error_t ds18b20_readRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint8_t bytesToRead, const bool checksum)
+{
+    DS18B20_error_t status;
+    if (checksum)
+    {
+        status = ds18b20_read_scratchpad_with_crc(onewire, deviceIndex);
+    }
+    else
+    {
+        status = ds18b20_read_scratchpad_with_stop(onewire, deviceIndex, bytesToRead);
+    }
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    
+    const uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
+    if (checksum || bytesToRead > DS18B20_SP_CONFIG_BYTE)
+    {
+        ds18b20_device_set_resolution(onewire, deviceIndex, ds18b20_config_byte_to_resolution(scratchpad[DS18B20_SP_CONFIG_BYTE]));
+    }
+    if (onewire->storage)
+    {
+        // Shared scratchpad will be overwritten by the next operation, so temperature is kept apart
+        onewire->storage->temperatures[deviceIndex] = ds18b20_convert_temperature_bytes_raw(
+            scratchpad[DS18B20_SP_TEMP_MSB_BYTE], scratchpad[DS18B20_SP_TEMP_LSB_BYTE], ds18b20_device_resolution(onewire, deviceIndex));
+    }
+    DS18B20_mirror_t * const mirror = ds18b20_mirror(onewire, deviceIndex);
+    if (mirror && (checksum || bytesToRead > DS18B20_SP_CONFIG_BYTE))
+    {
+        memcpy(mirror->registers, &scratchpad[DS18B20_SP_TEMP_HIGH_BYTE], DS18B20_SP_REGISTERS_SIZE);
+        mirror->registersGeneration = onewire->mirrorGeneration;
+    }
+
+    return DS18B20_OK;
+}
+
+static bool ds18b20_ownsBus(const DS18B20_onewire_t * const onewire)
+{
+    return onewire->busDevicesNo == onewire->devicesNo;
+}
+
+static DS18B20_error_t ds18b20_readAllRegisters(const DS18B20_onewire_t * const onewire, const DS18B20_scratchpad_t expected, const bool checksum)
+{
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        DS18B20_error_t status = ds18b20_selectDevice(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+
+        const uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
+        if (expected && (expected[DS18B20_SP_TEMP_HIGH_BYTE] != scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]
+            || expected[DS18B20_SP_TEMP_LOW_BYTE] != scratchpad[DS18B20_SP_TEMP_LOW_BYTE]
+            || ds18b20_config_byte_to_resolution(expected[DS18B20_SP_CONFIG_BYTE]) != ds18b20_device_resolution(onewire, deviceIndex)))
+        {
+            return DS18B20_VERIFY_FAIL;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_readRom(const DS18B20_onewire_t * const onewire, const bool checksum)
+{
+    DS18B20_error_t status = ds18b20_read_rom(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    
+    if (checksum)
+    {
+        return ds18b20_validate_crc8(ds18b20_device_rom(onewire, 0), DS18B20_ROM_SIZE_TO_VALIDATE, 
+            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, ds18b20_device_rom(onewire, 0)[DS18B20_ROM_CRC_BYTE]);
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_searchRom(DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
+{
+    DS18B20_error_t status = ds18b20_search_rom(onewire, NULL, false);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    
+    if (checksum)
+    {
+        return ds18b20_validate_crc8(ds18b20_device_rom(onewire, deviceIndex), DS18B20_ROM_SIZE_TO_VALIDATE, 
+            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, ds18b20_device_rom(onewire, deviceIndex)[DS18B20_ROM_CRC_BYTE]);
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_searchAlarm(DS18B20_onewire_t * const onewire, DS18B20_rom_t * buffer, const bool checksum)
+{
+    DS18B20_error_t status = ds18b20_search_rom(onewire, buffer, true);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+    
+    if (checksum)
+    {
+        return ds18b20_validate_crc8(*buffer, DS18B20_ROM_SIZE_TO_VALIDATE, 
+            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, (*buffer)[DS18B20_ROM_CRC_BYTE]);
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_selectDevice(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    DS18B20_error_t status;
+    if (DS18B20_1W_SINGLEDEVICE != onewire->busDevicesNo)
+    {
+        status = ds18b20_select(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        status = ds18b20_skip_select(onewire);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_requestTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (DS18B20_NO_CHECK_PERIOD != checkPeriodMs)
+    {
+        if (DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex))
+        {
+            return DS18B20_INV_OP;
+        }
+        if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+        {
+            return DS18B20_INV_ARG;
+        }
+    }
+
+    DS18B20_convertion_t convertion;
+    status = ds18b20_startTemperature(onewire, deviceIndex, &convertion);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    // Resolution is known only after the convertion has started (adaptive resolution mode may change it)
+    DS18B20_resolution_t resolution = ds18b20_device_resolution(onewire, deviceIndex);
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = ds18b20_millis_to_wait_for_convertion(resolution);
+    }
+
+    ds18b20_waitForConvertion(onewire, &convertion, ds18b20_timing(onewire, deviceIndex), resolution, checkPeriodMs);
+
+    ds18b20_finishConvertion(onewire, &convertion);
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_requestTemperatures(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs)
+{
+    DS18B20_error_t status;
+    if (DS18B20_NO_CHECK_PERIOD != checkPeriodMs)
+    {
+        if (ds18b20_bus_parasite(onewire))
+        {
+            return DS18B20_INV_OP;
+        }
+        if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+        {
+            return DS18B20_INV_ARG;
+        }
+    }
+
+    DS18B20_convertion_t convertion;
+    status = ds18b20_startTemperatures(onewire, &convertion);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    // Resolutions are known only after the convertion has started (adaptive resolution mode may change them)
+    DS18B20_resolution_t resolution = ds18b20_max_resolution(onewire);
+    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    {
+        checkPeriodMs = ds18b20_millis_to_wait_for_convertion(resolution);
+    }
+
+    // All devices hold the line low until they finish,
+    // so the status check reports the end of the slowest convertion.
+    ds18b20_waitForConvertion(onewire, &convertion, ds18b20_timing(onewire, onewire->devicesNo), resolution, checkPeriodMs);
+
+    ds18b20_finishConvertion(onewire, &convertion);
+
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_startTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion)
+{
+    DS18B20_error_t status = ds18b20_applyResolution(onewire, deviceIndex);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
     status = ds18b20_selectDevice(onewire, deviceIndex);
     if (DS18B20_OK != status)
     {
         return status;
     }
-    status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_TEMPERATURE_BYTES, checksum);
+    status = ds18b20_convert_temperature(onewire, deviceIndex);
     if (DS18B20_OK != status)
     {
         return status;
     }
 
-    *temperatureOut = ds18b20_convert_temperature_bytes(
-        onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_MSB_BYTE], 
-        onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_LSB_BYTE],
-        onewire->devices[deviceIndex].resolution
-    );
+    DS18B20_resolution_t resolution = ds18b20_device_resolution(onewire, deviceIndex);
+    DS18B20_timing_state_t *timing = ds18b20_timing(onewire, deviceIndex);
+    convertion->startMs = ds18b20_get_millis(onewire);
+    convertion->strongPullup = DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex);
+    convertion->ready = false;
+
+    if (convertion->strongPullup)
+    {
+        // Device cannot report the end of convertion, so strong pullup lasts until the learned deadline
+        convertion->deadlineMs = convertion->startMs + ds18b20_deadlineMillis(onewire, timing, resolution);
+        convertion->expectedMs = convertion->deadlineMs;
+    }
+    else
+    {
+        convertion->deadlineMs = convertion->startMs + ds18b20_millis_to_wait_for_convertion(resolution);
+        convertion->expectedMs = convertion->startMs + ds18b20_expectedMillis(timing, resolution);
+    }
 
     return DS18B20_OK;
 }
 
-DS18B20_error_t ds18b20__Configure(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_config_t * const config, const bool checksum)
+static DS18B20_error_t ds18b20_startTemperatures(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion)
 {
     DS18B20_error_t status;
-    if (!onewire || deviceIndex >= onewire->devicesNo)
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
     {
-        return DS18B20_INV_ARG;
+        status = ds18b20_applyResolution(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
     }
 
-    onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_HIGH_BYTE] = config->upperAlarm;
-    onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_LOW_BYTE] = config->lowerAlarm;
-    onewire->devices[deviceIndex].scratchpad[DS18B20_SP_CONFIG_BYTE] = ds18b20_resolution_to_config_byte(config->resolution);
-
-    status = ds18b20_selectDevice(onewire, deviceIndex);
+    status = ds18b20_skip_select_all(onewire);
     if (DS18B20_OK != status)
     {
         return status;
     }
-    status = ds18b20_write_scratchpad(onewire, deviceIndex);
+    status = ds18b20_convert_temperature_all(onewire);
     if (DS18B20_OK != status)
     {
         return status;
     }
 
-    status = ds18b20_selectDevice(onewire, deviceIndex);
-    if (DS18B20_OK != status)
+    DS18B20_resolution_t resolution = ds18b20_max_resolution(onewire);
+    convertion->startMs = ds18b20_get_millis(onewire);
+    convertion->expectedMs = convertion->startMs + ds18b20_expectedMillis(ds18b20_timing(onewire, onewire->devicesNo), resolution);
+    convertion->deadlineMs = convertion->startMs + ds18b20_millis_to_wait_for_convertion(resolution);
+    convertion->strongPullup = ds18b20_bus_parasite(onewire);
+    convertion->ready = false;
+
+    if (convertion->strongPullup && onewire->timingStates)
     {
-        return status;
+        // Bus cannot report the end of convertion, so strong pullup lasts until the slowest device is done
+        uint16_t deadlineMs = 0;
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            uint16_t deviceDeadlineMs = ds18b20_deadlineMillis(onewire, &onewire->timingStates[deviceIndex], ds18b20_device_resolution(onewire, deviceIndex));
+            if (deviceDeadlineMs > deadlineMs)
+            {
+                deadlineMs = deviceDeadlineMs;
+            }
+        }
+        convertion->deadlineMs = convertion->startMs + deadlineMs;
+        convertion->expectedMs = convertion->deadlineMs;
     }
-    status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
-    if (DS18B20_OK != status)
+    // Devices not handled by this instance may use any resolution, so they are powered until the longest convertion ends
+    if (convertion->strongPullup && !ds18b20_ownsBus(onewire))
     {
-        return status;
+        convertion->deadlineMs = convertion->startMs + ds18b20_millis_to_wait_for_convertion(DS18B20_RESOLUTION_12);
+        convertion->expectedMs = convertion->deadlineMs;
     }
 
     return DS18B20_OK;
 }
 
-DS18B20_error_t ds18b20__FindNextAlarm(DS18B20_onewire_t * const onewire, size_t * const deviceIndexOut, const bool checksum)
+static void ds18b20_finishConvertion(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion)
 {
-    DS18B20_error_t status;
-    if (!onewire || !deviceIndexOut)
+    if (convertion->strongPullup)
     {
-        return DS18B20_INV_ARG;
+        ds18b20_parasite_end_pullup(onewire);
+        convertion->strongPullup = false;
     }
 
-    DS18B20_rom_t alarmRom;
-    memset(alarmRom, DS18B20_DEFAULT_VALUE, DS18B20_ROM_SIZE);
-    status = ds18b20_searchAlarm(onewire, &alarmRom, checksum);
-    if (DS18B20_OK != status)
+    convertion->ready = true;
+}
+
+static void ds18b20_waitForConvertion(const DS18B20_onewire_t * const onewire, const DS18B20_convertion_t * const convertion, 
+    DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution, const uint16_t checkPeriodMs)
+{
+    if (convertion->strongPullup)
     {
-        return status;
+        // Devices cannot report the end of convertion while powered by strong pullup,
+        // time passed since the start (e.g. while the task was preempted) is not slept again
+        int32_t remainingMs = (int32_t)(convertion->deadlineMs - ds18b20_get_millis(onewire));
+        if (0 < remainingMs)
+        {
+            ds18b20_delay_ms(onewire, remainingMs);
+        }
+        return;
+    }
+    uint16_t waitPeriodMs = ds18b20_millis_to_wait_for_convertion(resolution);
+    if (!timing)
+    {
+        ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+        return;
     }
 
-    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    // Sleep through most of the convertion, then poll closely to catch its end
+    uint16_t pollPeriodMs = DS18B20_CHECK_PERIOD_MIN_MS;
+    if (timing->samples)
+    {
+        uint32_t earlyUs = DS18B20_TIMING_WAKE_DEVIATIONS * timing->deviationUs;
+        uint32_t wakeUs = timing->meanUs > earlyUs ? timing->meanUs - earlyUs : 0;
+        ds18b20_delay_ms(onewire, (wakeUs >> (DS18B20_RESOLUTION_12 - resolution)) / DS18B20_US_PER_MS);
+        pollPeriodMs = DS18B20_TIMING_POLL_PERIOD_MS;
+    }
+
+    while (true)
     {
-        uint8_t i = 0;
-        while (DS18B20_ROM_SIZE > i)
+        uint32_t elapsedMs = ds18b20_get_millis(onewire) - convertion->startMs;
+        if (ds18b20_read_bit(onewire))
         {
-            if (onewire->devices[deviceIndex].rom[i] != alarmRom[i])
-            {
-                break;
-            }
-            ++i;
+            ds18b20_learnConvertionTime(timing, elapsedMs, resolution);
+            return;
         }
-        
-        if (i >= DS18B20_ROM_SIZE)
+        if (elapsedMs >= waitPeriodMs)
         {
-            *deviceIndexOut = deviceIndex;
-            return DS18B20_OK;
+            return;
         }
-    }
 
-    return DS18B20_DEVICE_NOT_FOUND;
+        ds18b20_delay_ms(onewire, pollPeriodMs);
+    }
 }
 
-DS18B20_error_t ds18b20__StoreRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+static DS18B20_timing_state_t *ds18b20_timing(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
 {
-    return ds18b20__StoreRegistersWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD);
+    return onewire->timingStates ? &onewire->timingStates[deviceIndex] : NULL;
 }
 
-DS18B20_error_t ds18b20__StoreRegistersWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
+static uint16_t ds18b20_expectedMillis(const DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution)
 {
-    DS18B20_error_t status;
-    if (!onewire || deviceIndex >= onewire->devicesNo)
+    if (!timing || !timing->samples)
     {
-        return DS18B20_INV_ARG;
+        return ds18b20_millis_to_wait_for_convertion(resolution);
     }
 
-    uint16_t waitPeriodMs = DS18B20_SCRATCHPAD_COPY_DELAY_MS;
-    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    uint16_t worstMs = ds18b20_millis_to_wait_for_convertion(resolution);
+    uint32_t expectedMs = (timing->meanUs >> (DS18B20_RESOLUTION_12 - resolution)) / DS18B20_US_PER_MS;
+    return expectedMs < worstMs ? expectedMs : worstMs;
+}
+
+static uint16_t ds18b20_deadlineMillis(const DS18B20_onewire_t * const onewire, const DS18B20_timing_state_t * const timing, const DS18B20_resolution_t resolution)
+{
+    uint16_t worstMs = ds18b20_millis_to_wait_for_convertion(resolution);
+    if (!timing || !timing->samples)
     {
-        checkPeriodMs = waitPeriodMs;
+        return worstMs;
     }
-    else if (DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode)
+
+    uint32_t deadlineUs = (timing->meanUs + DS18B20_TIMING_DEADLINE_DEVIATIONS * timing->deviationUs) >> (DS18B20_RESOLUTION_12 - resolution);
+    uint32_t deadlineMs = (deadlineUs + DS18B20_US_PER_MS - 1) / DS18B20_US_PER_MS + onewire->timingMarginMs;
+    return deadlineMs < worstMs ? deadlineMs : worstMs;
+}
+
+static void ds18b20_learnConvertionTime(DS18B20_timing_state_t * const timing, const uint32_t elapsedMs, const DS18B20_resolution_t resolution)
+{
+    uint32_t measuredUs = (elapsedMs * DS18B20_US_PER_MS) << (DS18B20_RESOLUTION_12 - resolution);
+    if (!timing->samples)
     {
-        return DS18B20_INV_OP;
+        timing->meanUs = measuredUs;
+        timing->deviationUs = measuredUs >> DS18B20_TIMING_DEVIATION_INIT_SHIFT;
     }
-    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    else
     {
-        return DS18B20_INV_ARG;
+        int32_t error = (int32_t)(measuredUs - timing->meanUs);
+        uint32_t absError = error < 0 ? -error : error;
+        timing->meanUs += error / (1 << DS18B20_TIMING_MEAN_GAIN_SHIFT);
+        timing->deviationUs += ((int32_t)(absError - timing->deviationUs)) / (1 << DS18B20_TIMING_DEVIATION_GAIN_SHIFT);
     }
 
-    status = ds18b20_selectDevice(onewire, deviceIndex);
-    if (DS18B20_OK != status)
+    if (UINT16_MAX > timing->samples)
     {
-        return status;
+        ++timing->samples;
     }
-    status = ds18b20_copy_scratchpad(onewire, deviceIndex);
+}
+
+static DS18B20_error_t ds18b20_readTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
+{
+    DS18B20_temperature_raw_t raw;
+    DS18B20_error_t status = ds18b20_readTemperatureRaw(onewire, deviceIndex, &raw, checksum);
     if (DS18B20_OK != status)
     {
         return status;
     }
 
-    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
-
-    if (DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode)
-    {
-        ds18b20_parasite_end_pullup(onewire);
-    }
+    *temperatureOut = ds18b20_convert_temperature_raw(raw);
 
     return DS18B20_OK;
 }
 
-DS18B20_error_t ds18b20__RestoreRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
-{
-    return ds18b20__RestoreRegistersWithChecking(onewire, deviceIndex, DS18B20_NO_CHECK_PERIOD, checksum);
-}
-
-DS18B20_error_t ds18b20__RestoreRegistersWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs, const bool checksum)
+static DS18B20_error_t ds18b20_readTemperatureBytes(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
 {
-    DS18B20_error_t status;
-    if (!onewire || deviceIndex >= onewire->devicesNo)
+    DS18B20_error_t status = ds18b20_readTemperatureWithIntegrity(onewire, deviceIndex, checksum);
+    if (DS18B20_OK == status && onewire->resolutionStates)
     {
-        return DS18B20_INV_ARG;
+        ds18b20_trackResolution(onewire, deviceIndex);
     }
-
-    uint16_t waitPeriodMs = DS18B20_EEPROM_RESTORE_DELAY_MS;
-    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
+    // Power-on reset value suggests that the device has lost power and reloaded its registers from EEPROM
+    if (DS18B20_OK == status && DS18B20_SP_TEMP_DEFAULT_VALUE == ds18b20_lastTemperature(onewire, deviceIndex))
     {
-        checkPeriodMs = waitPeriodMs;
+        ds18b20_invalidateRegisters(onewire, deviceIndex);
     }
-    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
+    if (DS18B20_OK == status)
     {
-        return DS18B20_INV_ARG;
+        ds18b20_cacheTemperature(onewire, deviceIndex);
     }
 
-    status = ds18b20_selectDevice(onewire, deviceIndex);
-    if (DS18B20_OK != status)
-    {
-        return status;
-    }
-    status = ds18b20_recall_e2(onewire);
-    if (DS18B20_OK != status)
+    return status;
+}
+
+static DS18B20_error_t ds18b20_readTemperatureWithIntegrity(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
+{
+    if (!onewire->integrityStates)
     {
-        return status;
+        return ds18b20_readTemperatureRegisters(onewire, deviceIndex, checksum);
     }
 
-    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+    // Short reads are used as long as readings look plausible, suspicious ones are verified with CRC
+    DS18B20_integrity_state_t * const state = &onewire->integrityStates[deviceIndex];
+    bool fullRead = checksum || state->fullReadsLeft;
+    DS18B20_error_t status = ds18b20_readTemperatureRegisters(onewire, deviceIndex, fullRead);
+    if (DS18B20_OK == status && !fullRead)
+    {
+        if (ds18b20_isPlausible(onewire, state, ds18b20_lastTemperature(onewire, deviceIndex)))
+        {
+            state->lastTemperature = ds18b20_lastTemperature(onewire, deviceIndex);
+            return DS18B20_OK;
+        }
 
-    status = ds18b20_selectDevice(onewire, deviceIndex);
+        // Scratchpad still holds the same temperature, so it can be read again without new convertion
+        fullRead = true;
+        state->fullReadsLeft = onewire->integrity.escalationReads;
+        status = ds18b20_readTemperatureRegisters(onewire, deviceIndex, true);
+    }
     if (DS18B20_OK != status)
     {
+        state->fullReadsLeft = onewire->integrity.escalationReads;
         return status;
     }
-    status = ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_CONFIGURATION_BYTES, checksum);
-    if (DS18B20_OK != status)
+
+    if (state->fullReadsLeft)
     {
-        return status;
+        --state->fullReadsLeft;
     }
+    state->lastTemperature = ds18b20_lastTemperature(onewire, deviceIndex);
 
     return DS18B20_OK;
 }
 
-static void ds18b20_waitWithChecking(const DS18B20_onewire_t * const onewire, uint16_t waitPeriodMs, const uint16_t checkPeriodMs)
+static void ds18b20_trackResolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
 {
-    while (true)
+    DS18B20_resolution_state_t * const state = &onewire->resolutionStates[deviceIndex];
+    DS18B20_temperature_raw_t temperature = ds18b20_lastTemperature(onewire, deviceIndex);
+    if (!state->started)
     {
-        vTaskDelay(pdMS_TO_TICKS(checkPeriodMs));
+        state->lastTemperature = temperature;
+        state->started = true;
+        return;
+    }
 
-        if (DS18B20_WAITING_END >= (int16_t)(waitPeriodMs - checkPeriodMs) || ds18b20_read_bit(onewire))
+    // Flicker by a single step of the current resolution is quantization, not noise
+    int32_t change = ((int32_t) temperature - state->lastTemperature) * (1 << DS18B20_RESOLUTION_FRACTION_SHIFT);
+    int32_t step = (1 << (DS18B20_RESOLUTION_12 - ds18b20_device_resolution(onewire, deviceIndex))) << DS18B20_RESOLUTION_FRACTION_SHIFT;
+    int32_t deviation = change > state->trend ? change - state->trend : state->trend - change;
+    deviation = deviation > step ? deviation - step : 0;
+
+    state->trend += (change - state->trend) / (1 << DS18B20_RESOLUTION_GAIN_SHIFT);
+    state->noise += (deviation - (int32_t) state->noise) / (1 << DS18B20_RESOLUTION_GAIN_SHIFT);
+    state->lastTemperature = temperature;
+
+    uint32_t trend = state->trend < 0 ? -state->trend : state->trend;
+    DS18B20_resolution_t resolution = ds18b20_chooseResolution(&onewire->resolutionPolicy, trend > state->noise ? trend : state->noise);
+    if (resolution < state->resolution)
+    {
+        // Fast changes are followed at once
+        state->resolution = resolution;
+        state->settledReadings = 0;
+    }
+    else if (resolution > state->resolution)
+    {
+        if (++state->settledReadings >= onewire->resolutionPolicy.settleReadings)
         {
-            break;
+            state->resolution = resolution;
+            state->settledReadings = 0;
         }
-
-        waitPeriodMs -= checkPeriodMs;
+    }
+    else
+    {
+        state->settledReadings = 0;
     }
 }
 
-static DS18B20_error_t ds18b20_readRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint8_t bytesToRead, const bool checksum)
+static DS18B20_resolution_t ds18b20_chooseResolution(const DS18B20_resolution_policy_t * const policy, const uint32_t activity)
 {
-    DS18B20_error_t status = ds18b20_read_scratchpad_with_stop(onewire, deviceIndex, bytesToRead);
-    if (DS18B20_OK != status)
+    uint32_t step = (activity >> DS18B20_RESOLUTION_FRACTION_SHIFT) / policy->stepsPerChange;
+    DS18B20_resolution_t resolution = DS18B20_RESOLUTION_12;
+    while (DS18B20_RESOLUTION_09 < resolution && (1u << (DS18B20_RESOLUTION_12 - resolution + 1)) <= step)
     {
-        return status;
+        --resolution;
     }
-    
-    if (bytesToRead > DS18B20_SP_CONFIG_BYTE)
+    while (DS18B20_RESOLUTION_09 < resolution && ds18b20_millis_to_wait_for_convertion(resolution) > policy->maxConvertionMs)
     {
-        onewire->devices[deviceIndex].resolution = ds18b20_config_byte_to_resolution(onewire->devices[deviceIndex].scratchpad[DS18B20_SP_CONFIG_BYTE]);
+        --resolution;
     }
 
-    if (checksum)
+    return resolution < policy->minResolution ? policy->minResolution : resolution;
+}
+
+static DS18B20_error_t ds18b20_applyResolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (!onewire->resolutionStates || onewire->resolutionStates[deviceIndex].resolution == ds18b20_device_resolution(onewire, deviceIndex))
     {
-        return ds18b20_validate_crc8(onewire->devices[deviceIndex].scratchpad, DS18B20_SP_SIZE_TO_VALIDATE, 
-            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, onewire->devices[deviceIndex].scratchpad[DS18B20_SP_CRC_BYTE]);
+        return DS18B20_OK;
     }
 
-    return DS18B20_OK;
-}
+    DS18B20_error_t status;
+    if (onewire->storage)
+    {
+        // Shared scratchpad may hold alarm registers of another device
+        status = ds18b20_selectDevice(onewire, deviceIndex);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+        status = ds18b20_readRegisters(onewire, deviceIndex, DS18B20_READ_CONFIGURATION_BYTES, false);
+        if (DS18B20_OK != status)
+        {
+            return status;
+        }
+    }
 
-static DS18B20_error_t ds18b20_readRom(const DS18B20_onewire_t * const onewire, const bool checksum)
-{
-    DS18B20_error_t status = ds18b20_read_rom(onewire);
+    DS18B20_resolution_t resolution = onewire->resolutionStates[deviceIndex].resolution;
+    ds18b20_device_scratchpad(onewire, deviceIndex)[DS18B20_SP_CONFIG_BYTE] = ds18b20_resolution_to_config_byte(resolution);
+    ds18b20_invalidateRegisters(onewire, deviceIndex);
+    status = ds18b20_selectDevice(onewire, deviceIndex);
     if (DS18B20_OK != status)
     {
         return status;
     }
-    
-    if (checksum)
+    status = ds18b20_write_scratchpad(onewire, deviceIndex);
+    if (DS18B20_OK != status)
     {
-        return ds18b20_validate_crc8(onewire->devices->rom, DS18B20_ROM_SIZE_TO_VALIDATE, 
-            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, onewire->devices->rom[DS18B20_ROM_CRC_BYTE]);
+        return status;
     }
+    ds18b20_device_set_resolution(onewire, deviceIndex, resolution);
 
     return DS18B20_OK;
 }
 
-static DS18B20_error_t ds18b20_searchRom(DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
+static DS18B20_mirror_t *ds18b20_mirror(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
 {
-    DS18B20_error_t status = ds18b20_search_rom(onewire, NULL, false);
-    if (DS18B20_OK != status)
+    return onewire->mirrors ? &onewire->mirrors[deviceIndex] : NULL;
+}
+
+static bool ds18b20_isMirrored(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint8_t * const registers)
+{
+    const DS18B20_mirror_t * const mirror = ds18b20_mirror(onewire, deviceIndex);
+
+    // Unused bits of configuration register are fixed by the device, so only resolution is compared
+    return mirror && onewire->mirrorGeneration == mirror->registersGeneration
+        && registers[0] == mirror->registers[0]
+        && registers[1] == mirror->registers[1]
+        && ds18b20_config_byte_to_resolution(registers[2]) == ds18b20_config_byte_to_resolution(mirror->registers[2]);
+}
+
+static bool ds18b20_isStored(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    const DS18B20_mirror_t * const mirror = ds18b20_mirror(onewire, deviceIndex);
+
+    return mirror && onewire->mirrorGeneration == mirror->eepromGeneration
+        && ds18b20_isMirrored(onewire, deviceIndex, mirror->eeprom);
+}
+
+static void ds18b20_mirrorEeprom(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    DS18B20_mirror_t * const mirror = ds18b20_mirror(onewire, deviceIndex);
+    if (!mirror)
     {
-        return status;
+        return;
     }
-    
-    if (checksum)
+
+    if (onewire->mirrorGeneration == mirror->registersGeneration)
     {
-        return ds18b20_validate_crc8(onewire->devices[deviceIndex].rom, DS18B20_ROM_SIZE_TO_VALIDATE, 
-            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, onewire->devices[deviceIndex].rom[DS18B20_ROM_CRC_BYTE]);
+        memcpy(mirror->eeprom, mirror->registers, DS18B20_SP_REGISTERS_SIZE);
+        mirror->eepromGeneration = onewire->mirrorGeneration;
+    }
+    else
+    {
+        mirror->eepromGeneration = DS18B20_MIRROR_STALE;
     }
-
-    return DS18B20_OK;
 }
 
-static DS18B20_error_t ds18b20_searchAlarm(DS18B20_onewire_t * const onewire, DS18B20_rom_t * buffer, const bool checksum)
+static void ds18b20_invalidateRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
 {
-    DS18B20_error_t status = ds18b20_search_rom(onewire, buffer, true);
-    if (DS18B20_OK != status)
+    DS18B20_mirror_t * const mirror = ds18b20_mirror(onewire, deviceIndex);
+    if (mirror)
     {
-        return status;
+        mirror->registersGeneration = DS18B20_MIRROR_STALE;
     }
-    
-    if (checksum)
+}
+
+static bool ds18b20_isFresh(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, const uint32_t nowMs)
+{
+    return onewire->cache && onewire->cache[deviceIndex].valid 
+        && nowMs - onewire->cache[deviceIndex].capturedMs <= maxAgeMs;
+}
+
+static void ds18b20_cacheTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (!onewire->cache)
     {
-        return ds18b20_validate_crc8(*buffer, DS18B20_ROM_SIZE_TO_VALIDATE, 
-            DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, (*buffer)[DS18B20_ROM_CRC_BYTE]);
+        return;
     }
 
-    return DS18B20_OK;
+    DS18B20_cache_entry_t * const entry = &onewire->cache[deviceIndex];
+    entry->temperature = ds18b20_lastTemperature(onewire, deviceIndex);
+    entry->capturedMs = ds18b20_get_millis(onewire);
+    entry->valid = true;
 }
 
-static DS18B20_error_t ds18b20_selectDevice(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+static DS18B20_error_t ds18b20_refreshCache(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, const bool checksum)
 {
-    DS18B20_error_t status;
-    if (DS18B20_1W_SINGLEDEVICE != onewire->devicesNo)
+    const uint32_t nowMs = ds18b20_get_millis(onewire);
+    size_t deviceIndex = 0;
+    while (deviceIndex < onewire->devicesNo && ds18b20_isFresh(onewire, deviceIndex, maxAgeMs, nowMs))
     {
-        status = ds18b20_select(onewire, deviceIndex);
-        if (DS18B20_OK != status)
-        {
-            return status;
-        }
+        ++deviceIndex;
     }
-    else
+    if (onewire->devicesNo == deviceIndex)
     {
-        status = ds18b20_skip_select(onewire);
+        return DS18B20_OK;
+    }
+
+    DS18B20_error_t status = ds18b20__RequestTemperaturesC(onewire);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    // Freshness is judged at the time of the call, so devices which were fresh keep their cached temperatures
+    for (; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        if (ds18b20_isFresh(onewire, deviceIndex, maxAgeMs, nowMs))
+        {
+            continue;
+        }
+        status = ds18b20_readTemperatureBytes(onewire, deviceIndex, checksum);
         if (DS18B20_OK != status)
         {
             return status;
@@ -561,40 +2875,61 @@ static DS18B20_error_t ds18b20_selectDevice(const DS18B20_onewire_t * const onew
     return DS18B20_OK;
 }
 
-static DS18B20_error_t ds18b20_requestTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs)
+static DS18B20_error_t ds18b20_readTemperatureRegisters(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const bool checksum)
 {
-    DS18B20_error_t status;
-    uint16_t waitPeriodMs = ds18b20_millis_to_wait_for_convertion(onewire->devices[deviceIndex].resolution);
-    if (DS18B20_NO_CHECK_PERIOD == checkPeriodMs)
-    {
-        checkPeriodMs = waitPeriodMs;
-    }
-    else if (DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode)
-    {
-        return DS18B20_INV_OP;
-    }
-    else if (DS18B20_CHECK_PERIOD_MIN_MS > checkPeriodMs)
-    {
-        return DS18B20_INV_ARG;
-    }
-
-    status = ds18b20_selectDevice(onewire, deviceIndex);
+    DS18B20_error_t status = ds18b20_selectDevice(onewire, deviceIndex);
     if (DS18B20_OK != status)
     {
         return status;
     }
-    status = ds18b20_convert_temperature(onewire, deviceIndex);
+
+    return ds18b20_readRegisters(onewire, deviceIndex, checksum ? DS18B20_SP_SIZE : DS18B20_READ_TEMPERATURE_BYTES, checksum);
+}
+
+static DS18B20_temperature_raw_t ds18b20_lastTemperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    const uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
+    return ds18b20_convert_temperature_bytes_raw(
+        scratchpad[DS18B20_SP_TEMP_MSB_BYTE], 
+        scratchpad[DS18B20_SP_TEMP_LSB_BYTE],
+        ds18b20_device_resolution(onewire, deviceIndex)
+    );
+}
+
+static bool ds18b20_isPlausible(const DS18B20_onewire_t * const onewire, const DS18B20_integrity_state_t * const state, const DS18B20_temperature_raw_t temperature)
+{
+    int32_t change = (int32_t) temperature - state->lastTemperature;
+
+    return DS18B20_SP_TEMP_DEFAULT_VALUE != temperature
+        && temperature >= onewire->integrity.minTemperature
+        && temperature <= onewire->integrity.maxTemperature
+        && change <= onewire->integrity.maxChange
+        && change >= -onewire->integrity.maxChange;
+}
+
+static DS18B20_error_t ds18b20_readTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum)
+{
+    DS18B20_error_t status = ds18b20_readTemperatureBytes(onewire, deviceIndex, checksum);
     if (DS18B20_OK != status)
     {
         return status;
     }
 
-    ds18b20_waitWithChecking(onewire, waitPeriodMs, checkPeriodMs);
+    *temperatureOut = ds18b20_lastTemperature(onewire, deviceIndex);
+
+    return DS18B20_OK;
+}
 
-    if (DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode)
+static void ds18b20_convertTemperatures(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut)
+{
+    if (onewire->storage)
     {
-        ds18b20_parasite_end_pullup(onewire);
+        for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+        {
+            temperaturesOut[deviceIndex] = ds18b20_convert_temperature_raw(onewire->storage->temperatures[deviceIndex]);
+        }
+        return;
     }
 
-    return DS18B20_OK;
-}
\ No newline at end of file
+    ds18b20_convert_temperatures_devices(onewire->devices, temperaturesOut, onewire->devicesNo);
+}
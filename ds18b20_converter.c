@@ -29,14 +29,14 @@
 /** Specifies which configuration bits mean resolution (after shifting) */
 #define DS18B20_CONFIG_BYTE_CONVERTER_MASK      0x03
 
-/** Base temperature value (0) after convertion when it came out negative */
-#define DS18B20_TEMP_CONVERTER_NEGATIVE_BASE    4096
-/** The most significant byte divider value for temperature convertion to get the number sign */
-#define DS18B20_TEMP_CONVERTER_MSB_DIVIDER      128
-/** The most significant byte multiplier value for temperature convertion to get human-readable result */
+/** The most significant byte multiplier value for temperature convertion to get raw result */
 #define DS18B20_TEMP_CONVERTER_MSB_MULTIPLIER   256
-/** The least significant byte divider value for temperature convertion to get human-readable result */
-#define DS18B20_TEMP_CONVERTER_LSB_DIVIDER      16
+/** The raw temperature divider value for temperature convertion to get human-readable result */
+#define DS18B20_TEMP_CONVERTER_RAW_DIVIDER      16
+/** The raw temperature multiplier value for temperature convertion to get thousandths of Celsius (1000 / 16 = 125 / 2) */
+#define DS18B20_TEMP_CONVERTER_MILLI_MULTIPLIER 125
+/** The raw temperature divider value for temperature convertion to get thousandths of Celsius */
+#define DS18B20_TEMP_CONVERTER_MILLI_DIVIDER    2
 
 /** Mask value intended to ignore temperature's undefined bits for resolution 09 */
 #define DS18B20_RESOLUTION_09_MASK              0xF8
@@ -47,6 +47,11 @@
 /** Mask value intended to ignore temperature's undefined bits for resolution 12 */
 #define DS18B20_RESOLUTION_12_MASK              0xFF
 
+/** Mask intended to ignore temperature's undefined bits for given resolution without table look-up (one undefined bit less for each higher resolution) */
+#define DS18B20_RESOLUTION_BATCH_MASK(resolution)   ((uint16_t) (0xFFFF << (DS18B20_RESOLUTION_12 - (resolution))))
+/** Multiplier value for temperature convertion of raw values into human-readable results (exact inverse of 16) */
+#define DS18B20_TEMP_CONVERTER_RAW_MULTIPLIER   0.0625f
+
 /** Look-up table for temperature's undefined bits masks and resolutions */
 static const uint8_t resolution_masks[DS18B20_RESOLUTION_COUNT] =
 {
@@ -57,13 +62,58 @@ static const uint8_t resolution_masks[DS18B20_RESOLUTION_COUNT] =
 };
 
 DS18B20_temperature_out_t ds18b20_convert_temperature_bytes(const uint8_t msb, uint8_t lsb, const DS18B20_resolution_t resolution)
+{
+    return ds18b20_convert_temperature_raw(ds18b20_convert_temperature_bytes_raw(msb, lsb, resolution));
+}
+
+DS18B20_temperature_raw_t ds18b20_convert_temperature_bytes_raw(const uint8_t msb, uint8_t lsb, const DS18B20_resolution_t resolution)
 {
     // Ignore undefined bits for specified resolution
     lsb &= resolution_masks[resolution];
-    return (DS18B20_temperature_out_t) 
-                ((int16_t) (lsb + (msb * DS18B20_TEMP_CONVERTER_MSB_MULTIPLIER))) 
-                    / DS18B20_TEMP_CONVERTER_LSB_DIVIDER 
-                - DS18B20_TEMP_CONVERTER_NEGATIVE_BASE * (msb / DS18B20_TEMP_CONVERTER_MSB_DIVIDER);
+    // Register holds sign-extended two's complement value, so no sign correction is needed
+    return (DS18B20_temperature_raw_t) (uint16_t) (lsb + (msb * DS18B20_TEMP_CONVERTER_MSB_MULTIPLIER));
+}
+
+DS18B20_temperature_out_t ds18b20_convert_temperature_raw(const DS18B20_temperature_raw_t raw)
+{
+    return (DS18B20_temperature_out_t) raw / DS18B20_TEMP_CONVERTER_RAW_DIVIDER;
+}
+
+DS18B20_temperature_milli_t ds18b20_convert_temperature_raw_to_milli(const DS18B20_temperature_raw_t raw)
+{
+    return (DS18B20_temperature_milli_t) raw * DS18B20_TEMP_CONVERTER_MILLI_MULTIPLIER / DS18B20_TEMP_CONVERTER_MILLI_DIVIDER;
+}
+
+void ds18b20_convert_temperatures_bytes(const uint8_t * const msbs, const uint8_t * const lsbs, const DS18B20_resolution_t * const resolutions, 
+                                            DS18B20_temperature_out_t * const temperaturesOut, const size_t temperaturesNo)
+{
+    // No table look-ups nor branches inside the loop, so it can be vectorized by the compiler
+    for (size_t i = 0; i < temperaturesNo; ++i)
+    {
+        int16_t raw = (int16_t) ((msbs[i] * DS18B20_TEMP_CONVERTER_MSB_MULTIPLIER + lsbs[i]) & DS18B20_RESOLUTION_BATCH_MASK(resolutions[i]));
+        temperaturesOut[i] = raw * DS18B20_TEMP_CONVERTER_RAW_MULTIPLIER;
+    }
+}
+
+void ds18b20_convert_temperatures_raw(const DS18B20_temperature_raw_t * const raws, const DS18B20_resolution_t * const resolutions, 
+                                        DS18B20_temperature_out_t * const temperaturesOut, const size_t temperaturesNo)
+{
+    for (size_t i = 0; i < temperaturesNo; ++i)
+    {
+        int16_t raw = (int16_t) (raws[i] & DS18B20_RESOLUTION_BATCH_MASK(resolutions[i]));
+        temperaturesOut[i] = raw * DS18B20_TEMP_CONVERTER_RAW_MULTIPLIER;
+    }
+}
+
+void ds18b20_convert_temperatures_devices(const DS18B20_t * const devices, DS18B20_temperature_out_t * const temperaturesOut, const size_t devicesNo)
+{
+    for (size_t i = 0; i < devicesNo; ++i)
+    {
+        int16_t raw = (int16_t) ((devices[i].scratchpad[DS18B20_SP_TEMP_MSB_BYTE] * DS18B20_TEMP_CONVERTER_MSB_MULTIPLIER 
+                                    + devices[i].scratchpad[DS18B20_SP_TEMP_LSB_BYTE]) 
+                                & DS18B20_RESOLUTION_BATCH_MASK(devices[i].resolution));
+        temperaturesOut[i] = raw * DS18B20_TEMP_CONVERTER_RAW_MULTIPLIER;
+    }
 }
 
 uint8_t ds18b20_resolution_to_config_byte(const DS18B20_resolution_t resolution)
@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_gpio.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp32/rom/ets_sys.h"
+
+#include "ds18b20_low.h"
+#include "ds18b20_timeslots.h"
+#include "ds18b20_helpers.h"
+
+/**
+ * @brief Resets selected GPIO to be ready for One-Wire communication.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_gpio_init(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Sends reset signal and waits for the presence signal.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return uint8_t Returns 1 if any device replied to the signal, otherwise returns 0
+ */
+static uint8_t ds18b20_gpio_reset(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Generates write timeslot for the given bit value.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param bit Bit value to be written, any value other than 0 is treated as 1
+ */
+static void ds18b20_gpio_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit);
+
+/**
+ * @brief Generates read timeslot and samples the bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return uint8_t Value read from the bus - 0 or 1
+ */
+static uint8_t ds18b20_gpio_read_bit(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Drives the bus high to start strong pullup.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ */
+static void ds18b20_gpio_start_pullup(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Releases the bus to end strong pullup.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ */
+static void ds18b20_gpio_end_pullup(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Returns time since boot measured by ESP timer, not quantized to FreeRTOS ticks.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return uint32_t Current time (in milliseconds)
+ */
+static uint32_t ds18b20_gpio_get_millis(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Suspends the calling FreeRTOS task for whole ticks and busy-waits the rest of the delay.
+ * 
+ * Delays shorter than a tick are not rounded down to zero and the task never wakes up before the delay passes,
+ * which matters when it ends strong pullup.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param delayMs Time to wait (in milliseconds)
+ */
+static void ds18b20_gpio_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs);
+
+const DS18B20_transport_t ds18b20_gpio_transport =
+{
+    .init = ds18b20_gpio_init,
+    .reset = ds18b20_gpio_reset,
+    .write_bit = ds18b20_gpio_write_bit,
+    .read_bit = ds18b20_gpio_read_bit,
+    .start_pullup = ds18b20_gpio_start_pullup,
+    .end_pullup = ds18b20_gpio_end_pullup,
+    .get_millis = ds18b20_gpio_get_millis,
+    .delay_ms = ds18b20_gpio_delay_ms
+};
+
+static DS18B20_error_t ds18b20_gpio_init(const DS18B20_onewire_t * const onewire)
+{
+    if (ESP_OK != gpio_reset_pin(onewire->bus))
+    {
+        return DS18B20_INV_CONF;
+    }
+
+    return DS18B20_OK;
+}
+
+static uint8_t ds18b20_gpio_reset(const DS18B20_onewire_t * const onewire)
+{
+    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
+    
+    gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
+    ets_delay_us(RESET_DELAY0_US);
+    gpio_set_level(onewire->bus, DS18B20_LEVEL_HIGH);
+    gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
+    ets_delay_us(RESET_DELAY1_US);
+    uint8_t presence = !gpio_get_level(onewire->bus);
+    ets_delay_us(RESET_DELAY2_US);
+
+    return presence;
+}
+
+static void ds18b20_gpio_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit)
+{
+    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
+    
+    gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
+    ets_delay_us(bit ? WRITE_BIT1_DELAY0_US : WRITE_BIT0_DELAY0_US);
+    gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
+    ets_delay_us(bit ? WRITE_BIT1_DELAY1_US : WRITE_BIT0_DELAY1_US);
+}
+
+static uint8_t ds18b20_gpio_read_bit(const DS18B20_onewire_t * const onewire)
+{
+    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
+    
+    gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
+    ets_delay_us(READ_BIT_DELAY0_US);
+    gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
+    ets_delay_us(READ_BIT_DELAY1_US);
+    uint8_t data = gpio_get_level(onewire->bus);
+    ets_delay_us(READ_BIT_DELAY2_US);
+    
+    return data;
+}
+
+static void ds18b20_gpio_start_pullup(const DS18B20_onewire_t * const onewire)
+{
+    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
+    gpio_set_level(onewire->bus, DS18B20_LEVEL_HIGH);
+}
+
+static void ds18b20_gpio_end_pullup(const DS18B20_onewire_t * const onewire)
+{
+    gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
+}
+
+static uint32_t ds18b20_gpio_get_millis(const DS18B20_onewire_t * const onewire)
+{
+    return ds18b20_port_millis();
+}
+
+static void ds18b20_gpio_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs)
+{
+    ds18b20_port_sleep_ms(delayMs);
+}
\ No newline at end of file
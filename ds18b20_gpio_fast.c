@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_gpio_fast.h"
+#include "ds18b20_gpio_fast_slots.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp32/rom/ets_sys.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "soc/gpio_reg.h"
+
+#include "ds18b20_low.h"
+#include "ds18b20_helpers.h"
+
+/** Number of GPIOs in single register bank */
+#define DS18B20_GPIO_BANK_SIZE      32
+
+/**
+ * @brief Returns value of CPU cycle counter.
+ * 
+ * @return uint32_t CPU cycle counter value
+ */
+static IRAM_ATTR uint32_t ds18b20_gpio_fast_get_cycles(void)
+{
+    return esp_cpu_get_ccount();
+}
+
+/**
+ * @brief Routes selected GPIO for register driven One-Wire communication and releases the bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_gpio_fast_transport_init(const DS18B20_onewire_t * const onewire)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+    if (ESP_OK != gpio_reset_pin(fast->bus) 
+        || ESP_OK != gpio_set_level(fast->bus, DS18B20_LEVEL_LOW)
+        || ESP_OK != gpio_set_direction(fast->bus, GPIO_MODE_INPUT_OUTPUT))
+    {
+        return DS18B20_INV_CONF;
+    }
+    *fast->regs.enableClear = fast->mask;
+
+    return DS18B20_OK;
+}
+
+static uint32_t ds18b20_gpio_fast_get_millis(const DS18B20_onewire_t * const onewire)
+{
+    return ds18b20_port_millis();
+}
+
+static void ds18b20_gpio_fast_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs)
+{
+    ds18b20_port_sleep_ms(delayMs);
+}
+
+const DS18B20_transport_t ds18b20_gpio_fast_transport =
+{
+    .init = ds18b20_gpio_fast_transport_init,
+    .reset = ds18b20_gpio_fast_reset,
+    .write_bit = ds18b20_gpio_fast_write_bit,
+    .read_bit = ds18b20_gpio_fast_read_bit,
+    .start_pullup = ds18b20_gpio_fast_start_pullup,
+    .end_pullup = ds18b20_gpio_fast_end_pullup,
+    .get_millis = ds18b20_gpio_fast_get_millis,
+    .delay_ms = ds18b20_gpio_fast_delay_ms
+};
+
+/**
+ * @brief Routes GPIOs of all lanes for register driven One-Wire communication and releases them.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_gpio_lockstep_init(const DS18B20_lockstep_t * const lockstep)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+    if (lockstep->lanesMask & ~fast->mask)
+    {
+        return DS18B20_INV_CONF;
+    }
+
+    for (int pin = 0; pin < DS18B20_GPIO_BANK_SIZE; ++pin)
+    {
+        if (!(lockstep->lanesMask & (1UL << pin)))
+        {
+            continue;
+        }
+        if (ESP_OK != gpio_reset_pin(pin) 
+            || ESP_OK != gpio_set_level(pin, DS18B20_LEVEL_LOW)
+            || ESP_OK != gpio_set_direction(pin, GPIO_MODE_INPUT_OUTPUT))
+        {
+            return DS18B20_INV_CONF;
+        }
+    }
+    *fast->regs.enableClear = lockstep->lanesMask;
+
+    return DS18B20_OK;
+}
+
+static uint32_t ds18b20_gpio_lockstep_get_millis(const DS18B20_lockstep_t * const lockstep)
+{
+    return ds18b20_port_millis();
+}
+
+static void ds18b20_gpio_lockstep_delay_ms(const DS18B20_lockstep_t * const lockstep, const uint32_t delayMs)
+{
+    ds18b20_port_sleep_ms(delayMs);
+}
+
+const DS18B20_lockstep_transport_t ds18b20_gpio_lockstep_transport =
+{
+    .init = ds18b20_gpio_lockstep_init,
+    .reset = ds18b20_gpio_lockstep_reset,
+    .write_bits = ds18b20_gpio_lockstep_write_bits,
+    .read_bits = ds18b20_gpio_lockstep_read_bits,
+    .start_pullup = ds18b20_gpio_lockstep_start_pullup,
+    .end_pullup = ds18b20_gpio_lockstep_end_pullup,
+    .get_millis = ds18b20_gpio_lockstep_get_millis,
+    .delay_ms = ds18b20_gpio_lockstep_delay_ms
+};
+
+DS18B20_error_t ds18b20_gpio_fast_init(DS18B20_gpio_fast_t * const fast, const int bus)
+{
+    if (!fast || !GPIO_IS_VALID_OUTPUT_GPIO(bus))
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    fast->bus = bus;
+    fast->mask = 1UL << (bus % DS18B20_GPIO_BANK_SIZE);
+    if (bus < DS18B20_GPIO_BANK_SIZE)
+    {
+        fast->regs.enableSet = (volatile uint32_t *) GPIO_ENABLE_W1TS_REG;
+        fast->regs.enableClear = (volatile uint32_t *) GPIO_ENABLE_W1TC_REG;
+        fast->regs.outSet = (volatile uint32_t *) GPIO_OUT_W1TS_REG;
+        fast->regs.outClear = (volatile uint32_t *) GPIO_OUT_W1TC_REG;
+        fast->regs.in = (volatile const uint32_t *) GPIO_IN_REG;
+    }
+    else
+    {
+        fast->regs.enableSet = (volatile uint32_t *) GPIO_ENABLE1_W1TS_REG;
+        fast->regs.enableClear = (volatile uint32_t *) GPIO_ENABLE1_W1TC_REG;
+        fast->regs.outSet = (volatile uint32_t *) GPIO_OUT1_W1TS_REG;
+        fast->regs.outClear = (volatile uint32_t *) GPIO_OUT1_W1TC_REG;
+        fast->regs.in = (volatile const uint32_t *) GPIO_IN1_REG;
+    }
+    fast->cyclesPerUs = ets_get_cpu_frequency();
+    fast->get_cycles = ds18b20_gpio_fast_get_cycles;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_gpio_fast_init_lanes(DS18B20_gpio_fast_t * const fast, const uint32_t lanes)
+{
+    if (!fast || !lanes)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    for (int pin = 0; pin < DS18B20_GPIO_BANK_SIZE; ++pin)
+    {
+        if ((lanes & (1UL << pin)) && !GPIO_IS_VALID_OUTPUT_GPIO(pin))
+        {
+            return DS18B20_INV_ARG;
+        }
+    }
+
+    fast->bus = -1;
+    fast->mask = lanes;
+    fast->regs.enableSet = (volatile uint32_t *) GPIO_ENABLE_W1TS_REG;
+    fast->regs.enableClear = (volatile uint32_t *) GPIO_ENABLE_W1TC_REG;
+    fast->regs.outSet = (volatile uint32_t *) GPIO_OUT_W1TS_REG;
+    fast->regs.outClear = (volatile uint32_t *) GPIO_OUT_W1TC_REG;
+    fast->regs.in = (volatile const uint32_t *) GPIO_IN_REG;
+    fast->cyclesPerUs = ets_get_cpu_frequency();
+    fast->get_cycles = ds18b20_gpio_fast_get_cycles;
+
+    return DS18B20_OK;
+}
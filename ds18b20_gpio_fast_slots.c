@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_gpio_fast_slots.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#endif /* ESP_PLATFORM */
+
+#include "ds18b20_timeslots.h"
+
+/**
+ * @brief Busy-waits until specified time passes since the given point.
+ * 
+ * Measuring every delay from the beginning of the timeslot prevents skew from accumulating.
+ * 
+ * @param fast Pointer to fast GPIO transport context
+ * @param start Value of CPU cycle counter at the beginning of the timeslot
+ * @param us Time since the beginning of the timeslot (in microseconds)
+ */
+static inline IRAM_ATTR void ds18b20_gpio_fast_wait_until(const DS18B20_gpio_fast_t * const fast, const uint32_t start, const uint32_t us)
+{
+    const uint32_t cycles = us * fast->cyclesPerUs;
+    while ((uint32_t) (fast->get_cycles() - start) < cycles);
+}
+
+IRAM_ATTR uint8_t ds18b20_gpio_fast_reset(const DS18B20_onewire_t * const onewire)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US);
+    *fast->regs.enableClear = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US + RESET_DELAY1_US);
+    uint8_t presence = !(*fast->regs.in & fast->mask);
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US + RESET_DELAY1_US + RESET_DELAY2_US);
+
+    return presence;
+}
+
+IRAM_ATTR void ds18b20_gpio_fast_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+    const uint32_t lowUs = bit ? WRITE_BIT1_DELAY0_US : WRITE_BIT0_DELAY0_US;
+    const uint32_t slotUs = bit ? (WRITE_BIT1_DELAY0_US + WRITE_BIT1_DELAY1_US) : (WRITE_BIT0_DELAY0_US + WRITE_BIT0_DELAY1_US);
+
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, lowUs);
+    *fast->regs.enableClear = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, slotUs);
+}
+
+IRAM_ATTR uint8_t ds18b20_gpio_fast_read_bit(const DS18B20_onewire_t * const onewire)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US);
+    *fast->regs.enableClear = fast->mask;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US);
+    uint8_t data = (*fast->regs.in & fast->mask) ? 1 : 0;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US + READ_BIT_DELAY2_US);
+
+    return data;
+}
+
+void ds18b20_gpio_fast_start_pullup(const DS18B20_onewire_t * const onewire)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+    *fast->regs.outSet = fast->mask;
+    *fast->regs.enableSet = fast->mask;
+}
+
+void ds18b20_gpio_fast_end_pullup(const DS18B20_onewire_t * const onewire)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_fast_of(onewire);
+    *fast->regs.enableClear = fast->mask;
+    *fast->regs.outClear = fast->mask;
+}
+
+IRAM_ATTR uint32_t ds18b20_gpio_lockstep_reset(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US);
+    *fast->regs.enableClear = lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US + RESET_DELAY1_US);
+    uint32_t presence = ~*fast->regs.in & lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, RESET_DELAY0_US + RESET_DELAY1_US + RESET_DELAY2_US);
+
+    return presence;
+}
+
+IRAM_ATTR void ds18b20_gpio_lockstep_write_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+
+    // Lanes writing 1 are released early, the others keep the bus low for the whole write 0 period
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, WRITE_BIT1_DELAY0_US);
+    *fast->regs.enableClear = lanes & bits;
+    ds18b20_gpio_fast_wait_until(fast, start, WRITE_BIT0_DELAY0_US);
+    *fast->regs.enableClear = lanes & ~bits;
+    ds18b20_gpio_fast_wait_until(fast, start, WRITE_BIT0_DELAY0_US + WRITE_BIT0_DELAY1_US);
+}
+
+IRAM_ATTR uint32_t ds18b20_gpio_lockstep_read_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+
+    const uint32_t start = fast->get_cycles();
+    *fast->regs.enableSet = lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US);
+    *fast->regs.enableClear = lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US);
+    uint32_t data = *fast->regs.in & lanes;
+    ds18b20_gpio_fast_wait_until(fast, start, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US + READ_BIT_DELAY2_US);
+
+    return data;
+}
+
+void ds18b20_gpio_lockstep_start_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+    *fast->regs.outSet = lanes;
+    *fast->regs.enableSet = lanes;
+}
+
+void ds18b20_gpio_lockstep_end_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    const DS18B20_gpio_fast_t *fast = ds18b20_gpio_lockstep_of(lockstep);
+    *fast->regs.enableClear = lanes;
+    *fast->regs.outClear = lanes;
+}
\ No newline at end of file
@@ -0,0 +1,577 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_lockstep.h"
+
+#include <string.h>
+
+#include "ds18b20_commands.h"
+#include "ds18b20_registers.h"
+#include "ds18b20_rom.h"
+#include "ds18b20_specifications.h"
+#include "ds18b20_validator.h"
+#include "ds18b20_converter.h"
+
+#define DS18B20_NO_SEARCH_CONFLICTS         -1
+/** Period of status checks of externally powered lanes during convertion (ms) */
+#define DS18B20_LOCKSTEP_POLL_PERIOD_MS     1
+/** Number of scratchpad bytes read without checksum (up to configuration register holding resolution) */
+#define DS18B20_LOCKSTEP_SP_BYTES_NO_CRC    (DS18B20_SP_CONFIG_BYTE + 1)
+
+/**
+ * @brief Returns mask of the single lane.
+ * 
+ * @param lane Bit number of the lane
+ * @return uint32_t Lane mask
+ */
+static inline uint32_t ds18b20_lockstep_lane(const size_t lane)
+{
+    return 1UL << lane;
+}
+
+/**
+ * @brief Sends reset signal on the given lanes.
+ * 
+ * Lanes without presence signal get DS18B20_DISCONNECTED status.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @return uint32_t Mask of lanes with presence signal
+ */
+static uint32_t ds18b20_lockstep_reset(DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+/**
+ * @brief Generates single write timeslot on the given lanes.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param bits Bit value of each lane
+ */
+static void ds18b20_lockstep_write_bits(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits);
+
+/**
+ * @brief Generates single read timeslot on the given lanes.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @return uint32_t Mask of lanes sampled high
+ */
+static uint32_t ds18b20_lockstep_read_bits(DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+/**
+ * @brief Writes the same byte on the given lanes.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param byte Byte value
+ */
+static void ds18b20_lockstep_write_byte(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint8_t byte);
+
+/**
+ * @brief Reads bytes from the given lanes, each lane into its own buffer.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param buffers Buffers indexed by lane bit number
+ * @param bytesNo Number of bytes to read
+ */
+static void ds18b20_lockstep_read_bytes(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, DS18B20_scratchpad_t * const buffers, const size_t bytesNo);
+
+/**
+ * @brief Selects device with the given index on every of the given lanes using Match ROM command.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes (after reset signal)
+ * @param deviceIndex Index of the device on each lane
+ */
+static void ds18b20_lockstep_match_rom(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const size_t deviceIndex);
+
+/**
+ * @brief Performs single search cycle on the given lanes, each lane following its own search state.
+ * 
+ * Lanes without devices get DS18B20_DISCONNECTED or DS18B20_NO_DEVICES status and their search is finished.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param searches Search states indexed by lane bit number
+ * @return uint32_t Mask of lanes on which a ROM address has been found
+ */
+static uint32_t ds18b20_lockstep_search(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, DS18B20_search_t * const searches);
+
+/**
+ * @brief Returns mask of lanes with discovered devices.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return uint32_t Mask of populated lanes
+ */
+static uint32_t ds18b20_lockstep_populated(const DS18B20_lockstep_t * const lockstep);
+
+/**
+ * @brief Sets status of the given lanes.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param status Status code to set
+ */
+static void ds18b20_lockstep_set_status(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const DS18B20_error_t status);
+
+/**
+ * @brief Returns status of the first failed lane.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return DS18B20_error_t Status code of the last operation
+ */
+static DS18B20_error_t ds18b20_lockstep_status(const DS18B20_lockstep_t * const lockstep);
+
+DS18B20_error_t ds18b20__InitLockstep(DS18B20_lockstep_t * const lockstep, const DS18B20_lockstep_transport_t * const transport, void * const transportContext, 
+    DS18B20_lockstep_lane_t * const lanes, const size_t lanesNo)
+{
+    if (!lockstep || !transport || !lanes || !lanesNo || lanesNo > DS18B20_LOCKSTEP_MAX_LANES)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    lockstep->lanesMask = 0;
+    for (size_t lane = 0; lane < lanesNo; ++lane)
+    {
+        if (lanes[lane].capacity && (!lanes[lane].roms || !lanes[lane].temperatures))
+        {
+            return DS18B20_INV_ARG;
+        }
+        if (lanes[lane].capacity)
+        {
+            lockstep->lanesMask |= ds18b20_lockstep_lane(lane);
+        }
+        lanes[lane].devicesNo = 0;
+        lanes[lane].powerMode = DS18B20_PM_EXTERNAL_SUPPLY;
+        lanes[lane].status = DS18B20_OK;
+    }
+
+    lockstep->transport = transport;
+    lockstep->transportContext = transportContext;
+    lockstep->lanes = lanes;
+    lockstep->lanesNo = lanesNo;
+    ds18b20_port_spinlock_init(&lockstep->lock);
+
+    if (transport->init)
+    {
+        return transport->init(lockstep);
+    }
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__LockstepDiscover(DS18B20_lockstep_t * const lockstep, const bool checksum)
+{
+    if (!lockstep)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_search_t searches[DS18B20_LOCKSTEP_MAX_LANES];
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        lockstep->lanes[lane].devicesNo = 0;
+        lockstep->lanes[lane].powerMode = DS18B20_PM_EXTERNAL_SUPPLY;
+        ds18b20_search_start(&searches[lane]);
+    }
+    ds18b20_lockstep_set_status(lockstep, lockstep->lanesMask, DS18B20_OK);
+
+    uint32_t searching = lockstep->lanesMask;
+    while (searching)
+    {
+        uint32_t found = ds18b20_lockstep_search(lockstep, searching, searches);
+        searching &= found;
+
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            if (!(found & ds18b20_lockstep_lane(lane)))
+            {
+                continue;
+            }
+
+            DS18B20_lockstep_lane_t *current = &lockstep->lanes[lane];
+            const uint8_t *rom = searches[lane].rom;
+            if (checksum && DS18B20_OK != ds18b20_validate_crc8(rom, DS18B20_ROM_SIZE_TO_VALIDATE, DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, rom[DS18B20_ROM_CRC_BYTE]))
+            {
+                current->status = DS18B20_CRC_FAIL;
+            }
+            else if (current->devicesNo == current->capacity)
+            {
+                current->status = DS18B20_INV_CONF;
+            }
+            else
+            {
+                memcpy(current->roms[current->devicesNo++], rom, DS18B20_ROM_SIZE);
+            }
+
+            if (DS18B20_OK != current->status || searches[lane].finished)
+            {
+                searching &= ~ds18b20_lockstep_lane(lane);
+            }
+        }
+    }
+
+    // Single Read Power Supply of all lanes - any parasite powered device pulls its lane low
+    uint32_t populated = ds18b20_lockstep_populated(lockstep);
+    uint32_t present = ds18b20_lockstep_reset(lockstep, populated);
+    ds18b20_lockstep_write_byte(lockstep, present, DS18B20_SKIP_ROM);
+    ds18b20_lockstep_write_byte(lockstep, present, DS18B20_READ_POWER_SUPPLY);
+    uint32_t external = ds18b20_lockstep_read_bits(lockstep, present);
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (present & ~external & ds18b20_lockstep_lane(lane))
+        {
+            lockstep->lanes[lane].powerMode = DS18B20_PM_PARASITE;
+        }
+    }
+
+    return ds18b20_lockstep_status(lockstep);
+}
+
+DS18B20_error_t ds18b20__LockstepConvert(DS18B20_lockstep_t * const lockstep)
+{
+    if (!lockstep)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    uint32_t populated = ds18b20_lockstep_populated(lockstep);
+    ds18b20_lockstep_set_status(lockstep, populated, DS18B20_OK);
+
+    uint32_t present = ds18b20_lockstep_reset(lockstep, populated);
+    uint32_t parasite = 0;
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (DS18B20_PM_PARASITE == lockstep->lanes[lane].powerMode)
+        {
+            parasite |= ds18b20_lockstep_lane(lane);
+        }
+    }
+    parasite &= present;
+
+    ds18b20_lockstep_write_byte(lockstep, present, DS18B20_SKIP_ROM);
+    ds18b20_lockstep_write_byte(lockstep, present, DS18B20_CONVERT_T);
+    if (parasite)
+    {
+        lockstep->transport->start_pullup(lockstep, parasite);
+    }
+    const uint32_t startMs = lockstep->transport->get_millis(lockstep);
+
+    // Strong pullup of parasite lanes is not disturbed by read timeslots generated on the other lanes
+    uint32_t pending = present & ~parasite;
+    while (pending)
+    {
+        pending &= ~ds18b20_lockstep_read_bits(lockstep, pending);
+        if (!pending)
+        {
+            break;
+        }
+        if (lockstep->transport->get_millis(lockstep) - startMs >= DS18B20_RESOLUTION_12_DELAY_MS)
+        {
+            ds18b20_lockstep_set_status(lockstep, pending, DS18B20_NOT_READY);
+            break;
+        }
+        lockstep->transport->delay_ms(lockstep, DS18B20_LOCKSTEP_POLL_PERIOD_MS);
+    }
+
+    if (parasite)
+    {
+        uint32_t elapsedMs = lockstep->transport->get_millis(lockstep) - startMs;
+        if (elapsedMs < DS18B20_RESOLUTION_12_DELAY_MS)
+        {
+            lockstep->transport->delay_ms(lockstep, DS18B20_RESOLUTION_12_DELAY_MS - elapsedMs);
+        }
+        lockstep->transport->end_pullup(lockstep, parasite);
+    }
+
+    return ds18b20_lockstep_status(lockstep);
+}
+
+DS18B20_error_t ds18b20__LockstepReadTemperaturesRaw(DS18B20_lockstep_t * const lockstep, const bool checksum)
+{
+    if (!lockstep)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    uint32_t populated = ds18b20_lockstep_populated(lockstep);
+    ds18b20_lockstep_set_status(lockstep, populated, DS18B20_OK);
+
+    size_t maxDevicesNo = 0;
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (lockstep->lanes[lane].devicesNo > maxDevicesNo)
+        {
+            maxDevicesNo = lockstep->lanes[lane].devicesNo;
+        }
+    }
+
+    const size_t bytesNo = checksum ? DS18B20_SP_SIZE : DS18B20_LOCKSTEP_SP_BYTES_NO_CRC;
+    DS18B20_scratchpad_t scratchpads[DS18B20_LOCKSTEP_MAX_LANES];
+    for (size_t deviceIndex = 0; deviceIndex < maxDevicesNo; ++deviceIndex)
+    {
+        uint32_t lanes = 0;
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            if (deviceIndex < lockstep->lanes[lane].devicesNo)
+            {
+                lanes |= ds18b20_lockstep_lane(lane);
+            }
+        }
+
+        uint32_t present = ds18b20_lockstep_reset(lockstep, lanes & populated);
+        ds18b20_lockstep_match_rom(lockstep, present, deviceIndex);
+        ds18b20_lockstep_write_byte(lockstep, present, DS18B20_READ_SCRATCHPAD);
+        ds18b20_lockstep_read_bytes(lockstep, present, scratchpads, bytesNo);
+
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            if (!(present & ds18b20_lockstep_lane(lane)))
+            {
+                continue;
+            }
+
+            const uint8_t *scratchpad = scratchpads[lane];
+            if (checksum && DS18B20_OK != ds18b20_validate_crc8(scratchpad, DS18B20_SP_SIZE_TO_VALIDATE, DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, scratchpad[DS18B20_SP_CRC_BYTE]))
+            {
+                lockstep->lanes[lane].status = DS18B20_CRC_FAIL;
+                continue;
+            }
+            lockstep->lanes[lane].temperatures[deviceIndex] = ds18b20_convert_temperature_bytes_raw(scratchpad[DS18B20_SP_TEMP_MSB_BYTE], 
+                scratchpad[DS18B20_SP_TEMP_LSB_BYTE], ds18b20_config_byte_to_resolution(scratchpad[DS18B20_SP_CONFIG_BYTE]));
+        }
+    }
+
+    return ds18b20_lockstep_status(lockstep);
+}
+
+static uint32_t ds18b20_lockstep_reset(DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    if (!lanes)
+    {
+        return 0;
+    }
+
+    ds18b20_port_enter_critical(&lockstep->lock);
+        uint32_t present = lockstep->transport->reset(lockstep, lanes) & lanes;
+    ds18b20_port_exit_critical(&lockstep->lock);
+
+    ds18b20_lockstep_set_status(lockstep, lanes & ~present, DS18B20_DISCONNECTED);
+    return present;
+}
+
+static void ds18b20_lockstep_write_bits(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits)
+{
+    ds18b20_port_enter_critical(&lockstep->lock);
+        lockstep->transport->write_bits(lockstep, lanes, bits & lanes);
+    ds18b20_port_exit_critical(&lockstep->lock);
+}
+
+static uint32_t ds18b20_lockstep_read_bits(DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    ds18b20_port_enter_critical(&lockstep->lock);
+        uint32_t bits = lockstep->transport->read_bits(lockstep, lanes) & lanes;
+    ds18b20_port_exit_critical(&lockstep->lock);
+
+    return bits;
+}
+
+static void ds18b20_lockstep_write_byte(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint8_t byte)
+{
+    if (!lanes)
+    {
+        return;
+    }
+
+    for (uint8_t bitNo = 0; bitNo < 8; ++bitNo)
+    {
+        ds18b20_lockstep_write_bits(lockstep, lanes, ((byte >> bitNo) & 1) ? lanes : 0);
+    }
+}
+
+static void ds18b20_lockstep_read_bytes(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, DS18B20_scratchpad_t * const buffers, const size_t bytesNo)
+{
+    if (!lanes)
+    {
+        return;
+    }
+
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        memset(buffers[lane], 0, bytesNo);
+    }
+
+    for (size_t byteNo = 0; byteNo < bytesNo; ++byteNo)
+    {
+        for (uint8_t bitNo = 0; bitNo < 8; ++bitNo)
+        {
+            uint32_t highs = ds18b20_lockstep_read_bits(lockstep, lanes);
+            for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+            {
+                if (highs & ds18b20_lockstep_lane(lane))
+                {
+                    buffers[lane][byteNo] |= 1 << bitNo;
+                }
+            }
+        }
+    }
+}
+
+static void ds18b20_lockstep_match_rom(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const size_t deviceIndex)
+{
+    if (!lanes)
+    {
+        return;
+    }
+
+    ds18b20_lockstep_write_byte(lockstep, lanes, DS18B20_MATCH_ROM);
+    for (uint8_t romBitNo = 0; romBitNo < DS18B20_ROM_SIZE * 8; ++romBitNo)
+    {
+        uint32_t bits = 0;
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            if ((lanes & ds18b20_lockstep_lane(lane)) 
+                && (lockstep->lanes[lane].roms[deviceIndex][romBitNo / 8] & (1 << (romBitNo % 8))))
+            {
+                bits |= ds18b20_lockstep_lane(lane);
+            }
+        }
+        ds18b20_lockstep_write_bits(lockstep, lanes, bits);
+    }
+}
+
+static uint32_t ds18b20_lockstep_search(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, DS18B20_search_t * const searches)
+{
+    uint32_t active = ds18b20_lockstep_reset(lockstep, lanes);
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (lanes & ~active & ds18b20_lockstep_lane(lane))
+        {
+            searches[lane].finished = true;
+        }
+    }
+
+    ds18b20_lockstep_write_byte(lockstep, active, DS18B20_SEARCH_ROM);
+
+    int8_t lastZeros[DS18B20_LOCKSTEP_MAX_LANES];
+    memset(lastZeros, DS18B20_NO_SEARCH_CONFLICTS, sizeof(lastZeros));
+    for (uint8_t romBitNo = 0; romBitNo < DS18B20_ROM_SIZE * 8 && active; ++romBitNo)
+    {
+        const uint8_t byteNo = romBitNo / 8;
+        const uint8_t bitMask = 1 << (romBitNo % 8);
+
+        uint32_t bitsRead = ds18b20_lockstep_read_bits(lockstep, active);
+        uint32_t complementsRead = ds18b20_lockstep_read_bits(lockstep, active);
+
+        // No devices connected to the lane (data: 11)
+        uint32_t empty = bitsRead & complementsRead;
+        // All devices of the lane have same bit (data: 01 or 10), otherwise decide like single bus search
+        uint32_t bitsSet = bitsRead & ~empty;
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            const uint32_t mask = ds18b20_lockstep_lane(lane);
+            if (empty & mask)
+            {
+                lockstep->lanes[lane].status = DS18B20_NO_DEVICES;
+                searches[lane].finished = true;
+                continue;
+            }
+            if (!(active & mask) || (bitsRead | complementsRead) & mask)
+            {
+                continue;
+            }
+
+            // Devices with conflicting bits (data: 00)
+            DS18B20_search_t *search = &searches[lane];
+            bool bitSet = (romBitNo < search->lastConflict) 
+                ? 0 != (search->rom[byteNo] & bitMask)    // Follow the path of the previous cycle
+                : romBitNo == search->lastConflict;       // Take bit = 1 at the last conflict, otherwise take bit = 0
+            if (bitSet)
+            {
+                bitsSet |= mask;
+            }
+            else
+            {
+                lastZeros[lane] = romBitNo;
+            }
+        }
+        active &= ~empty;
+
+        ds18b20_lockstep_write_bits(lockstep, active, bitsSet);
+        for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+        {
+            const uint32_t mask = ds18b20_lockstep_lane(lane);
+            if (active & mask)
+            {
+                searches[lane].rom[byteNo] = (bitsSet & mask) ? (searches[lane].rom[byteNo] | bitMask) : (searches[lane].rom[byteNo] & ~bitMask);
+            }
+        }
+    }
+
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (active & ds18b20_lockstep_lane(lane))
+        {
+            searches[lane].lastConflict = lastZeros[lane];
+            searches[lane].finished = DS18B20_NO_SEARCH_CONFLICTS == lastZeros[lane];
+        }
+    }
+
+    return active;
+}
+
+static uint32_t ds18b20_lockstep_populated(const DS18B20_lockstep_t * const lockstep)
+{
+    uint32_t populated = 0;
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (lockstep->lanes[lane].devicesNo)
+        {
+            populated |= ds18b20_lockstep_lane(lane);
+        }
+    }
+
+    return populated & lockstep->lanesMask;
+}
+
+static void ds18b20_lockstep_set_status(DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const DS18B20_error_t status)
+{
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if (lanes & ds18b20_lockstep_lane(lane))
+        {
+            lockstep->lanes[lane].status = status;
+        }
+    }
+}
+
+static DS18B20_error_t ds18b20_lockstep_status(const DS18B20_lockstep_t * const lockstep)
+{
+    for (size_t lane = 0; lane < lockstep->lanesNo; ++lane)
+    {
+        if ((lockstep->lanesMask & ds18b20_lockstep_lane(lane)) && DS18B20_OK != lockstep->lanes[lane].status)
+        {
+            return lockstep->lanes[lane].status;
+        }
+    }
+
+    return DS18B20_OK;
+}
@@ -20,32 +20,26 @@
  */
 #include "ds18b20_low.h"
 
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "driver/gpio.h"
-#include "esp32/rom/ets_sys.h"
+#include <string.h>
 
 #include "ds18b20_commands.h"
 #include "ds18b20_registers.h"
 #include "ds18b20_specifications.h"
-#include "ds18b20_timeslots.h"
 #include "ds18b20_helpers.h"
+#include "ds18b20_validator.h"
 
 /** Means that no devices has been found yet during search procedure */
 #define DS18B20_NO_SEARCHED_DEVICES 0
 /** Means that no conflicts occurred during the last search cycle */
 #define DS18B20_NO_SEARCH_CONFLICTS -1
+/** Position of the last conflict which makes search follow the given ROM address at every bit */
+#define DS18B20_VERIFY_FOLLOW_ALL_BITS  (DS18B20_ROM_SIZE * 8)
 
 /** Means that bit was read incorrectly */
 #define DS18B20_INVALID_READ        2
 /** Means that DS18B20 device did not replied to the reset signal */
 #define DS18B20_ABSENCE             0
 
-/** Macro which disables FreeRTOS interrupts */
-#define noInterrupts()              portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;taskENTER_CRITICAL(&mux)
-/** Macro which enables back FreeRTOS interrupts */
-#define interrupts()                taskEXIT_CRITICAL(&mux)
-
 /** Look-up table for maximum temperature convertion waiting time and resolutions */
 static const uint16_t resolution_delays_ms[DS18B20_RESOLUTION_COUNT] =
 {
@@ -55,6 +49,63 @@ static const uint16_t resolution_delays_ms[DS18B20_RESOLUTION_COUNT] =
     [DS18B20_RESOLUTION_12] DS18B20_RESOLUTION_12_DELAY_MS
 };
 
+/**
+ * @brief Returns spinlock of the bus, which is modified even for read-only bus instances.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_spinlock_t* Pointer to modifiable spinlock of the bus
+ */
+static inline DS18B20_spinlock_t *ds18b20_lock(const DS18B20_onewire_t * const onewire)
+{
+    return (DS18B20_spinlock_t *) &onewire->lock;
+}
+
+/**
+ * @brief Enters critical section if the operation of given scope should be guarded and the caller does not guard the bus already.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param scope Scope of the operation
+ * @return true Critical section has been entered and needs to be exited with ds18b20_exit_critical()
+ * @return false Critical section has not been entered
+ */
+static inline bool ds18b20_enter_critical(const DS18B20_onewire_t * const onewire, const DS18B20_critical_t scope)
+{
+    if (scope > onewire->critical || ds18b20_port_holds_critical(&onewire->lock))
+    {
+        return false;
+    }
+
+    ds18b20_port_enter_critical(ds18b20_lock(onewire));
+    return true;
+}
+
+/**
+ * @brief Exits critical section if it has been entered.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param entered Value returned by ds18b20_enter_critical()
+ */
+static inline void ds18b20_exit_critical(const DS18B20_onewire_t * const onewire, const bool entered)
+{
+    if (!entered)
+    {
+        return;
+    }
+
+    ds18b20_port_exit_critical(ds18b20_lock(onewire));
+}
+
+/**
+ * @brief Finishes transaction started with reset signal, if critical sections are scoped to whole transactions.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ */
+static inline void ds18b20_end_transaction(const DS18B20_onewire_t * const onewire)
+{
+    // Slots and bytes are always finished here, so the caller can only hold critical section of the transaction
+    ds18b20_exit_critical(onewire, DS18B20_CRITICAL_TRANSACTION == onewire->critical && ds18b20_port_holds_critical(&onewire->lock));
+}
+
 void ds18b20_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit)
 {
     if (!onewire)
@@ -62,22 +113,24 @@ void ds18b20_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bi
         return;
     }
 
-    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
-    
-    noInterrupts();
-        gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
-        ets_delay_us(bit ? WRITE_BIT1_DELAY0_US : WRITE_BIT0_DELAY0_US);
-        gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
-        ets_delay_us(bit ? WRITE_BIT1_DELAY1_US : WRITE_BIT0_DELAY1_US);
-    interrupts();
+    bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
+        onewire->transport->write_bit(onewire, bit);
+    ds18b20_exit_critical(onewire, entered);
 }
 
 void ds18b20_write_byte(const DS18B20_onewire_t * const onewire, const uint8_t byte)
 {
-    for (uint8_t mask = 1; mask != 0; mask <<= 1)
+    if (!onewire)
     {
-        ds18b20_write_bit(onewire, byte & mask);
+        return;
     }
+
+    bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_BYTE);
+        for (uint8_t mask = 1; mask != 0; mask <<= 1)
+        {
+            ds18b20_write_bit(onewire, byte & mask);
+        }
+    ds18b20_exit_critical(onewire, entered);
 }
 
 uint8_t ds18b20_read_bit(const DS18B20_onewire_t * const onewire)
@@ -87,31 +140,30 @@ uint8_t ds18b20_read_bit(const DS18B20_onewire_t * const onewire)
         return DS18B20_INVALID_READ;
     }
     
-    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
-    
-    noInterrupts();
-        gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
-        ets_delay_us(READ_BIT_DELAY0_US);
-        gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
-        ets_delay_us(READ_BIT_DELAY1_US);
-        uint8_t data = gpio_get_level(onewire->bus);
-        ets_delay_us(READ_BIT_DELAY2_US);
-    interrupts();
-    
+    bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
+        uint8_t data = onewire->transport->read_bit(onewire);
+    ds18b20_exit_critical(onewire, entered);
+
     return data;
 }
 
 uint8_t ds18b20_read_byte(const DS18B20_onewire_t * const onewire)
 {
     uint8_t data = 0;
-
-    for (uint8_t mask = 1; mask != 0; mask <<= 1)
+    if (!onewire)
     {
-        if (ds18b20_read_bit(onewire))
+        return data;
+    }
+
+    bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_BYTE);
+        for (uint8_t mask = 1; mask != 0; mask <<= 1)
         {
-            data |= mask;
+            if (ds18b20_read_bit(onewire))
+            {
+                data |= mask;
+            }
         }
-    }
+    ds18b20_exit_critical(onewire, entered);
 
     return data;
 }
@@ -123,17 +175,12 @@ uint8_t ds18b20_reset(const DS18B20_onewire_t * const onewire)
         return DS18B20_ABSENCE;
     }
     
-    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
-    
-    noInterrupts();
-        gpio_set_level(onewire->bus, DS18B20_LEVEL_LOW);
-        ets_delay_us(RESET_DELAY0_US);
-        gpio_set_level(onewire->bus, DS18B20_LEVEL_HIGH);
-        gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
-        ets_delay_us(RESET_DELAY1_US);
-        uint8_t presence = !gpio_get_level(onewire->bus);
-        ets_delay_us(RESET_DELAY2_US);
-    interrupts();
+    // Critical section of the transaction lasts until its function command is finished
+    ds18b20_enter_critical(onewire, DS18B20_CRITICAL_TRANSACTION);
+
+    bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
+        uint8_t presence = onewire->transport->reset(onewire);
+    ds18b20_exit_critical(onewire, entered);
 
     return presence;
 }
@@ -145,8 +192,7 @@ void ds18b20_parasite_start_pullup(const DS18B20_onewire_t * const onewire)
         return;
     }
 
-    gpio_set_direction(onewire->bus, GPIO_MODE_OUTPUT);
-    gpio_set_level(onewire->bus, DS18B20_LEVEL_HIGH);
+    onewire->transport->start_pullup(onewire);
 }
 
 void ds18b20_parasite_end_pullup(const DS18B20_onewire_t * const onewire)
@@ -156,7 +202,7 @@ void ds18b20_parasite_end_pullup(const DS18B20_onewire_t * const onewire)
         return;
     }
 
-    gpio_set_direction(onewire->bus, GPIO_MODE_INPUT);
+    onewire->transport->end_pullup(onewire);
 }
 
 DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_rom_t * buffer, const bool alarmSearchMode)
@@ -190,18 +236,21 @@ DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_ro
 
     if (!buffer)
     {   // Buffer can only be set if this is not alarm search.
-        if (!alarmSearchMode)
+        if (alarmSearchMode)
         {
-            buffer = &onewire->devices[onewire->lastSearchedDeviceNumber].rom;
+            return DS18B20_INV_ARG;
         }
-        else
+        if (onewire->lastSearchedDeviceNumber >= onewire->devicesNo)
         {
-            return DS18B20_INV_ARG;
+            return DS18B20_INV_OP;
         }
+        buffer = (DS18B20_rom_t *) ds18b20_device_rom(onewire, onewire->lastSearchedDeviceNumber);
     }
+    memset(*buffer, 0, DS18B20_ROM_SIZE);
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
 
@@ -222,6 +271,7 @@ DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_ro
 
             if (bitRead && complementRead)
             {   // No devices connected to bus (data: 11)
+                ds18b20_end_transaction(onewire);
                 status = ds18b20_restart_search(onewire, alarmSearchMode);
                 if (DS18B20_OK != status)
                 {
@@ -234,7 +284,7 @@ DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_ro
             {   // Devices with conflicting bits (data: 00)
                 if (romBitNo < onewire->lastSearchConflict)
                 {   // Make decision like the last time
-                    bitSet = 0 != (onewire->devices[onewire->lastSearchedDeviceNumber - 1].rom[byteNo] & bitMask);
+                    bitSet = 0 != (onewire->lastSearchedRom[byteNo] & bitMask);
                     if (!bitSet)
                     {
                         onewire->lastSearchConflictUnresolved = romBitNo;
@@ -272,11 +322,111 @@ DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_ro
         }
     }
 
+    memcpy(onewire->lastSearchedRom, *buffer, DS18B20_ROM_SIZE);
     ++onewire->lastSearchedDeviceNumber;
+    ds18b20_end_transaction(onewire);
 
     return DS18B20_OK;
 }
 
+DS18B20_error_t ds18b20_search_next(const DS18B20_onewire_t * const onewire, DS18B20_search_t * const search, const bool alarmSearchMode)
+{
+    if (!onewire || !search)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (search->finished)
+    {
+        return DS18B20_NO_MORE_DEVICES;
+    }
+
+    if (!ds18b20_reset(onewire))
+    {
+        ds18b20_end_transaction(onewire);
+        return DS18B20_DISCONNECTED;
+    }
+
+    ds18b20_write_byte(onewire, alarmSearchMode ? DS18B20_ALARM_SEARCH : DS18B20_SEARCH_ROM);
+
+    int8_t lastZero = DS18B20_NO_SEARCH_CONFLICTS;
+    for (uint8_t romBitNo = 0; romBitNo < DS18B20_ROM_SIZE * 8; ++romBitNo)
+    {
+        uint8_t *romByte = &search->rom[romBitNo / 8];
+        uint8_t bitMask = 1 << (romBitNo % 8);
+
+        uint8_t bitRead = ds18b20_read_bit(onewire);
+        uint8_t complementRead = ds18b20_read_bit(onewire);
+        uint8_t bitSet;
+
+        if (bitRead && complementRead)
+        {   // No devices connected to bus (data: 11)
+            ds18b20_end_transaction(onewire);
+            search->finished = true;
+            return DS18B20_NO_DEVICES;
+        }
+
+        if (!bitRead && !complementRead)
+        {   // Devices with conflicting bits (data: 00)
+            if (romBitNo < search->lastConflict)
+            {   // Follow the path of the previous cycle
+                bitSet = 0 != (*romByte & bitMask);
+            }
+            else
+            {   // Take bit = 1 at the last conflict, otherwise take bit = 0
+                bitSet = romBitNo == search->lastConflict;
+            }
+
+            if (!bitSet)
+            {
+                lastZero = romBitNo;
+            }
+        }
+        else
+        {   // All devices have same bit (data: 01 or 10)
+            bitSet = bitRead;
+        }
+
+        ds18b20_write_bit(onewire, bitSet);
+        *romByte = bitSet ? (*romByte | bitMask) : (*romByte & ~bitMask);
+    }
+
+    ds18b20_end_transaction(onewire);
+    search->lastConflict = lastZero;
+    search->finished = DS18B20_NO_SEARCH_CONFLICTS == lastZero;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_verify_rom(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t rom, bool * const presentOut)
+{
+    if (!onewire || !rom || !presentOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    // Conflict at every bit is resolved by following the given ROM address, 
+    // so the search ends with it only if the device holding it has replied to all bits.
+    DS18B20_search_t search;
+    memcpy(search.rom, rom, DS18B20_ROM_SIZE);
+    search.lastConflict = DS18B20_VERIFY_FOLLOW_ALL_BITS;
+    search.finished = false;
+
+    DS18B20_error_t status = ds18b20_search_next(onewire, &search, false);
+    if (DS18B20_NO_DEVICES == status || DS18B20_DISCONNECTED == status)
+    {
+        *presentOut = false;
+        return DS18B20_OK;
+    }
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    *presentOut = 0 == memcmp(search.rom, rom, DS18B20_ROM_SIZE);
+    return DS18B20_OK;
+}
+
 DS18B20_error_t ds18b20_read_rom(const DS18B20_onewire_t * const onewire)
 {
     if (!onewire)
@@ -284,13 +434,14 @@ DS18B20_error_t ds18b20_read_rom(const DS18B20_onewire_t * const onewire)
         return DS18B20_INV_ARG;
     }
 
-    if (onewire->devicesNo > DS18B20_1W_SINGLEDEVICE)
+    if (onewire->busDevicesNo > DS18B20_1W_SINGLEDEVICE)
     {
         return DS18B20_INV_OP;
     }
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
 
@@ -298,13 +449,15 @@ DS18B20_error_t ds18b20_read_rom(const DS18B20_onewire_t * const onewire)
 
     for (uint8_t i = 0; i < DS18B20_ROM_SIZE; ++i)
     {
-        onewire->devices->rom[i] = ds18b20_read_byte(onewire);
+        ds18b20_device_rom(onewire, 0)[i] = ds18b20_read_byte(onewire);
     }
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
@@ -317,13 +470,15 @@ DS18B20_error_t ds18b20_select(const DS18B20_onewire_t * const onewire, const si
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
 
+    const uint8_t * const rom = ds18b20_device_rom(onewire, deviceIndex);
     ds18b20_write_byte(onewire, DS18B20_MATCH_ROM);
     for (uint8_t i = 0; i < DS18B20_ROM_SIZE; ++i)
     {
-        ds18b20_write_byte(onewire, onewire->devices[deviceIndex].rom[i]);
+        ds18b20_write_byte(onewire, rom[i]);
     }
 
     return DS18B20_OK;
@@ -336,13 +491,32 @@ DS18B20_error_t ds18b20_skip_select(const DS18B20_onewire_t * const onewire)
         return DS18B20_INV_ARG;
     }
 
-    if (onewire->devicesNo > DS18B20_1W_SINGLEDEVICE)
+    if (onewire->busDevicesNo > DS18B20_1W_SINGLEDEVICE)
     {
         return DS18B20_INV_OP;
     }
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
+        return DS18B20_DISCONNECTED;
+    }
+    
+    ds18b20_write_byte(onewire, DS18B20_SKIP_ROM);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_skip_select_all(const DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!ds18b20_reset(onewire))
+    {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
     
@@ -358,19 +532,45 @@ DS18B20_error_t ds18b20_convert_temperature(const DS18B20_onewire_t * const onew
         return DS18B20_INV_ARG;
     }
     
-    uint8_t isParasite = DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode;
+    uint8_t isParasite = DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex);
     if (!isParasite)
     {
         ds18b20_write_byte(onewire, DS18B20_CONVERT_T);
     }
     else
     {
-        noInterrupts();
+        // Strong pullup has to be enabled right after the command, whatever the scope of critical sections is
+        bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
+            ds18b20_write_byte(onewire, DS18B20_CONVERT_T);
+            ds18b20_parasite_start_pullup(onewire);
+        ds18b20_exit_critical(onewire, entered);
+    }
+
+    ds18b20_end_transaction(onewire);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_convert_temperature_all(const DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+    
+    if (!ds18b20_bus_parasite(onewire))
+    {
+        ds18b20_write_byte(onewire, DS18B20_CONVERT_T);
+    }
+    else
+    {
+        // Strong pullup has to be enabled right after the command, whatever the scope of critical sections is
+        bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
             ds18b20_write_byte(onewire, DS18B20_CONVERT_T);
             ds18b20_parasite_start_pullup(onewire);
-        interrupts();
+        ds18b20_exit_critical(onewire, entered);
     }
 
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
@@ -381,11 +581,29 @@ DS18B20_error_t ds18b20_write_scratchpad(const DS18B20_onewire_t * const onewire
         return DS18B20_INV_ARG;
     }
 
+    const uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
     ds18b20_write_byte(onewire, DS18B20_WRITE_SCRATCHPAD);
-    ds18b20_write_byte(onewire, onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]);
-    ds18b20_write_byte(onewire, onewire->devices[deviceIndex].scratchpad[DS18B20_SP_TEMP_LOW_BYTE]);
-    ds18b20_write_byte(onewire, onewire->devices[deviceIndex].scratchpad[DS18B20_SP_CONFIG_BYTE]);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_TEMP_LOW_BYTE]);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_CONFIG_BYTE]);
 
+    ds18b20_end_transaction(onewire);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_write_scratchpad_all(const DS18B20_onewire_t * const onewire, const DS18B20_scratchpad_t scratchpad)
+{
+    if (!onewire || !scratchpad)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_write_byte(onewire, DS18B20_WRITE_SCRATCHPAD);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_TEMP_LOW_BYTE]);
+    ds18b20_write_byte(onewire, scratchpad[DS18B20_SP_CONFIG_BYTE]);
+
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
@@ -406,20 +624,50 @@ DS18B20_error_t ds18b20_read_scratchpad_with_stop(const DS18B20_onewire_t * cons
         bytesToRead = DS18B20_SP_SIZE;
     }
 
+    uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
     ds18b20_write_byte(onewire, DS18B20_READ_SCRATCHPAD);
 
     for (uint8_t i = 0; i < bytesToRead; ++i)
     {
-        onewire->devices[deviceIndex].scratchpad[i] = ds18b20_read_byte(onewire);
+        scratchpad[i] = ds18b20_read_byte(onewire);
     }
 
     if (!ds18b20_reset(onewire))
     {
+        ds18b20_end_transaction(onewire);
         return DS18B20_DISCONNECTED;
     }
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
+DS18B20_error_t ds18b20_read_scratchpad_with_crc(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (!onewire || deviceIndex >= onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    uint8_t * const scratchpad = ds18b20_device_scratchpad(onewire, deviceIndex);
+    ds18b20_write_byte(onewire, DS18B20_READ_SCRATCHPAD);
+
+    // CRC byte is folded in as well, so valid data always leaves zero checksum
+    uint8_t crc = DS18B20_CRC8_INIT_VALUE;
+    for (uint8_t i = 0; i < DS18B20_SP_SIZE; ++i)
+    {
+        scratchpad[i] = ds18b20_read_byte(onewire);
+        crc = ds18b20_crc8_update(crc, scratchpad[i]);
+    }
+
+    if (!ds18b20_reset(onewire))
+    {
+        ds18b20_end_transaction(onewire);
+        return DS18B20_DISCONNECTED;
+    }
+    ds18b20_end_transaction(onewire);
+    return (DS18B20_CRC8_INIT_VALUE == crc) ? DS18B20_OK : DS18B20_CRC_FAIL;
+}
+
 DS18B20_error_t ds18b20_copy_scratchpad(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
 {
     if (!onewire || deviceIndex >= onewire->devicesNo)
@@ -427,19 +675,45 @@ DS18B20_error_t ds18b20_copy_scratchpad(const DS18B20_onewire_t * const onewire,
         return DS18B20_INV_ARG;
     }
 
-    uint8_t isParasite = DS18B20_PM_PARASITE == onewire->devices[deviceIndex].powerMode;
+    uint8_t isParasite = DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex);
     if (!isParasite)
     {
         ds18b20_write_byte(onewire, DS18B20_COPY_SCRATCHPAD);
     }
     else
     {
-        noInterrupts();
+        // Strong pullup has to be enabled right after the command, whatever the scope of critical sections is
+        bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
             ds18b20_write_byte(onewire, DS18B20_COPY_SCRATCHPAD);
             ds18b20_parasite_start_pullup(onewire);
-        interrupts();
+        ds18b20_exit_critical(onewire, entered);
     }
 
+    ds18b20_end_transaction(onewire);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_copy_scratchpad_all(const DS18B20_onewire_t * const onewire)
+{
+    if (!onewire)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!ds18b20_bus_parasite(onewire))
+    {
+        ds18b20_write_byte(onewire, DS18B20_COPY_SCRATCHPAD);
+    }
+    else
+    {
+        // Strong pullup has to be enabled right after the command, whatever the scope of critical sections is
+        bool entered = ds18b20_enter_critical(onewire, DS18B20_CRITICAL_SLOT);
+            ds18b20_write_byte(onewire, DS18B20_COPY_SCRATCHPAD);
+            ds18b20_parasite_start_pullup(onewire);
+        ds18b20_exit_critical(onewire, entered);
+    }
+
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
@@ -452,6 +726,7 @@ DS18B20_error_t ds18b20_recall_e2(const DS18B20_onewire_t * const onewire)
 
     ds18b20_write_byte(onewire, DS18B20_RECALL_E2);
 
+    ds18b20_end_transaction(onewire);
     return DS18B20_OK;
 }
 
@@ -464,8 +739,39 @@ DS18B20_error_t ds18b20_read_powermode(const DS18B20_onewire_t * const onewire,
     
     ds18b20_write_byte(onewire, DS18B20_READ_POWER_SUPPLY);
 
-    onewire->devices[deviceIndex].powerMode = ds18b20_read_bit(onewire);
+    ds18b20_device_set_powermode(onewire, deviceIndex, ds18b20_read_bit(onewire));
     
+    ds18b20_end_transaction(onewire);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_read_powermode_all(const DS18B20_onewire_t * const onewire, DS18B20_powermode_t * const powerModeOut)
+{
+    if (!onewire || !powerModeOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_write_byte(onewire, DS18B20_READ_POWER_SUPPLY);
+
+    // Every parasite powered device pulls the line low, so one reply covers the whole bus
+    *powerModeOut = ds18b20_read_bit(onewire);
+
+    ds18b20_end_transaction(onewire);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20_search_start(DS18B20_search_t * const search)
+{
+    if (!search)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    memset(search->rom, 0, DS18B20_ROM_SIZE);
+    search->lastConflict = DS18B20_NO_SEARCH_CONFLICTS;
+    search->finished = false;
+
     return DS18B20_OK;
 }
 
@@ -487,4 +793,110 @@ DS18B20_error_t ds18b20_restart_search(DS18B20_onewire_t * const onewire, const
 uint16_t ds18b20_millis_to_wait_for_convertion(const DS18B20_resolution_t resolution)
 {
     return resolution_delays_ms[resolution];
-}
\ No newline at end of file
+}
+
+uint32_t ds18b20_get_millis(const DS18B20_onewire_t * const onewire)
+{
+    return onewire->transport->get_millis(onewire);
+}
+
+void ds18b20_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs)
+{
+    onewire->transport->delay_ms(onewire, delayMs);
+}
+
+bool ds18b20_any_parasite(const DS18B20_onewire_t * const onewire)
+{
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        if (DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, deviceIndex))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ds18b20_bus_parasite(const DS18B20_onewire_t * const onewire)
+{
+    return onewire->busParasite || ds18b20_any_parasite(onewire);
+}
+
+DS18B20_resolution_t ds18b20_max_resolution(const DS18B20_onewire_t * const onewire)
+{
+    DS18B20_resolution_t resolution = DS18B20_RESOLUTION_09;
+    for (size_t deviceIndex = 0; deviceIndex < onewire->devicesNo; ++deviceIndex)
+    {
+        DS18B20_resolution_t deviceResolution = ds18b20_device_resolution(onewire, deviceIndex);
+        if (deviceResolution > resolution)
+        {
+            resolution = deviceResolution;
+        }
+    }
+
+    return resolution;
+}
+
+uint8_t *ds18b20_device_rom(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (onewire->storage)
+    {
+        return onewire->storage->roms[deviceIndex];
+    }
+
+    return onewire->devices[deviceIndex].rom;
+}
+
+uint8_t *ds18b20_device_scratchpad(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (onewire->storage)
+    {
+        return onewire->storage->scratchpad;
+    }
+
+    return onewire->devices[deviceIndex].scratchpad;
+}
+
+DS18B20_resolution_t ds18b20_device_resolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (onewire->storage)
+    {
+        return (DS18B20_resolution_t) (onewire->storage->flags[deviceIndex] & DS18B20_STORAGE_RESOLUTION_MASK);
+    }
+
+    return onewire->devices[deviceIndex].resolution;
+}
+
+void ds18b20_device_set_resolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_resolution_t resolution)
+{
+    if (onewire->storage)
+    {
+        onewire->storage->flags[deviceIndex] = (onewire->storage->flags[deviceIndex] & ~DS18B20_STORAGE_RESOLUTION_MASK) | resolution;
+        return;
+    }
+
+    onewire->devices[deviceIndex].resolution = resolution;
+}
+
+DS18B20_powermode_t ds18b20_device_powermode(const DS18B20_onewire_t * const onewire, const size_t deviceIndex)
+{
+    if (onewire->storage)
+    {
+        return (DS18B20_powermode_t) ((onewire->storage->flags[deviceIndex] >> DS18B20_STORAGE_POWERMODE_SHIFT) & 1);
+    }
+
+    return onewire->devices[deviceIndex].powerMode;
+}
+
+void ds18b20_device_set_powermode(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_powermode_t powerMode)
+{
+    if (onewire->storage)
+    {
+        onewire->storage->flags[deviceIndex] = (onewire->storage->flags[deviceIndex] & ~(1 << DS18B20_STORAGE_POWERMODE_SHIFT)) 
+                                                | ((powerMode & 1) << DS18B20_STORAGE_POWERMODE_SHIFT);
+        return;
+    }
+
+    onewire->devices[deviceIndex].powerMode = powerMode;
+}
@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_manager.h"
+
+/** Period of status checks of buses which should have already finished their convertions (ms) */
+#define DS18B20_MANAGER_POLL_PERIOD_MS  1
+
+/**
+ * @brief Starts temperature convertion on all buses, one right after another.
+ * 
+ * Status of each bus which has started is set to DS18B20_NOT_READY until its results are collected.
+ * 
+ * @param manager Pointer to manager instance
+ */
+static void ds18b20_manager_start(DS18B20_manager_t * const manager);
+
+/**
+ * @brief Waits until convertion on any of the buses which have not been collected yet is finished.
+ * 
+ * Buses are not asked about the status before their convertions are expected to end.
+ * 
+ * @param manager Pointer to manager instance
+ * @param busIndexOut Pointer to variable where index of the ready bus will be saved eventually
+ * @return true Convertion on some bus is ready
+ * @return false All buses have already been collected (or failed)
+ */
+static bool ds18b20_manager_next(DS18B20_manager_t * const manager, size_t * const busIndexOut);
+
+/**
+ * @brief Returns index of the first reading of the given bus in consolidated results.
+ * 
+ * @param manager Pointer to manager instance
+ * @param busIndex Index of the bus
+ * @return size_t Index of the first reading
+ */
+static size_t ds18b20_manager_offset(const DS18B20_manager_t * const manager, const size_t busIndex);
+
+/**
+ * @brief Returns status of the first failed bus of the last sweep.
+ * 
+ * @param manager Pointer to manager instance
+ * @return DS18B20_error_t Status code of the sweep
+ */
+static DS18B20_error_t ds18b20_manager_status(const DS18B20_manager_t * const manager);
+
+DS18B20_error_t ds18b20__InitManager(DS18B20_manager_t * const manager, const DS18B20_onewire_t * const * const buses, const size_t busesNo, 
+    DS18B20_convertion_t * const convertions, DS18B20_error_t * const statuses)
+{
+    if (!manager || !buses || !busesNo || !convertions || !statuses)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    manager->devicesNo = 0;
+    for (size_t busIndex = 0; busIndex < busesNo; ++busIndex)
+    {
+        if (!buses[busIndex])
+        {
+            return DS18B20_INV_ARG;
+        }
+        manager->devicesNo += buses[busIndex]->devicesNo;
+        statuses[busIndex] = DS18B20_OK;
+    }
+
+    manager->buses = buses;
+    manager->convertions = convertions;
+    manager->statuses = statuses;
+    manager->busesNo = busesNo;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SweepTemperaturesC(DS18B20_manager_t * const manager, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum)
+{
+    if (!manager || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_manager_start(manager);
+
+    size_t busIndex;
+    while (ds18b20_manager_next(manager, &busIndex))
+    {
+        manager->statuses[busIndex] = ds18b20__CollectTemperaturesC(manager->buses[busIndex], &manager->convertions[busIndex], 
+            &temperaturesOut[ds18b20_manager_offset(manager, busIndex)], checksum);
+    }
+
+    return ds18b20_manager_status(manager);
+}
+
+DS18B20_error_t ds18b20__SweepTemperaturesRaw(DS18B20_manager_t * const manager, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum)
+{
+    if (!manager || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_manager_start(manager);
+
+    size_t busIndex;
+    while (ds18b20_manager_next(manager, &busIndex))
+    {
+        manager->statuses[busIndex] = ds18b20__CollectTemperaturesRaw(manager->buses[busIndex], &manager->convertions[busIndex], 
+            &temperaturesOut[ds18b20_manager_offset(manager, busIndex)], checksum);
+    }
+
+    return ds18b20_manager_status(manager);
+}
+
+static void ds18b20_manager_start(DS18B20_manager_t * const manager)
+{
+    for (size_t busIndex = 0; busIndex < manager->busesNo; ++busIndex)
+    {
+        DS18B20_error_t status = ds18b20__StartTemperaturesC(manager->buses[busIndex], &manager->convertions[busIndex]);
+        manager->statuses[busIndex] = (DS18B20_OK == status) ? DS18B20_NOT_READY : status;
+    }
+}
+
+static bool ds18b20_manager_next(DS18B20_manager_t * const manager, size_t * const busIndexOut)
+{
+    const DS18B20_onewire_t * const clock = manager->buses[0];
+    while (true)
+    {
+        bool pending = false;
+        uint32_t waitMs = UINT32_MAX;
+        for (size_t busIndex = 0; busIndex < manager->busesNo; ++busIndex)
+        {
+            if (DS18B20_NOT_READY != manager->statuses[busIndex])
+            {
+                continue;
+            }
+            pending = true;
+
+            int32_t remainingMs = (int32_t)(manager->convertions[busIndex].expectedMs - ds18b20_get_millis(clock));
+            if (remainingMs > 0)
+            {
+                waitMs = (uint32_t) remainingMs < waitMs ? (uint32_t) remainingMs : waitMs;
+                continue;
+            }
+
+            bool ready;
+            DS18B20_error_t status = ds18b20__IsConvertionReady(manager->buses[busIndex], &manager->convertions[busIndex], &ready);
+            if (DS18B20_OK != status)
+            {
+                manager->statuses[busIndex] = status;
+                continue;
+            }
+            if (ready)
+            {
+                *busIndexOut = busIndex;
+                return true;
+            }
+            waitMs = DS18B20_MANAGER_POLL_PERIOD_MS;
+        }
+
+        if (!pending)
+        {
+            return false;
+        }
+        if (UINT32_MAX != waitMs)
+        {
+            ds18b20_delay_ms(clock, waitMs);
+        }
+    }
+}
+
+static size_t ds18b20_manager_offset(const DS18B20_manager_t * const manager, const size_t busIndex)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < busIndex; ++i)
+    {
+        offset += manager->buses[i]->devicesNo;
+    }
+
+    return offset;
+}
+
+static DS18B20_error_t ds18b20_manager_status(const DS18B20_manager_t * const manager)
+{
+    for (size_t busIndex = 0; busIndex < manager->busesNo; ++busIndex)
+    {
+        if (DS18B20_OK != manager->statuses[busIndex])
+        {
+            return manager->statuses[busIndex];
+        }
+    }
+
+    return DS18B20_OK;
+}
@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_nvs.h"
+
+#include "nvs.h"
+
+/**
+ * @brief Loads topology blob from NVS namespace.
+ * 
+ * @param context NVS namespace name
+ * @param blob Buffer for the blob
+ * @param capacity Size of the buffer in bytes
+ * @param sizeOut Pointer to variable where the size of the loaded blob will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_nvs_load(void * const context, uint8_t * const blob, const size_t capacity, size_t * const sizeOut);
+
+/**
+ * @brief Saves topology blob into NVS namespace and commits it.
+ * 
+ * @param context NVS namespace name
+ * @param blob Blob to save
+ * @param size Size of the blob in bytes
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_nvs_save(void * const context, const uint8_t * const blob, const size_t size);
+
+const DS18B20_topology_store_t ds18b20_nvs_topology_store =
+{
+    .load = ds18b20_nvs_load,
+    .save = ds18b20_nvs_save
+};
+
+static DS18B20_error_t ds18b20_nvs_load(void * const context, uint8_t * const blob, const size_t capacity, size_t * const sizeOut)
+{
+    nvs_handle_t handle;
+    if (ESP_OK != nvs_open((const char *) context, NVS_READONLY, &handle))
+    {
+        return DS18B20_STORE_FAIL;
+    }
+
+    size_t size = capacity;
+    esp_err_t err = nvs_get_blob(handle, DS18B20_NVS_TOPOLOGY_KEY, blob, &size);
+    nvs_close(handle);
+    if (ESP_OK != err)
+    {
+        return DS18B20_STORE_FAIL;
+    }
+
+    *sizeOut = size;
+    return DS18B20_OK;
+}
+
+static DS18B20_error_t ds18b20_nvs_save(void * const context, const uint8_t * const blob, const size_t size)
+{
+    nvs_handle_t handle;
+    if (ESP_OK != nvs_open((const char *) context, NVS_READWRITE, &handle))
+    {
+        return DS18B20_STORE_FAIL;
+    }
+
+    esp_err_t err = nvs_set_blob(handle, DS18B20_NVS_TOPOLOGY_KEY, blob, size);
+    if (ESP_OK == err)
+    {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    return (ESP_OK == err) ? DS18B20_OK : DS18B20_STORE_FAIL;
+}
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_shared.h"
+
+#include <string.h>
+
+/**
+ * @brief Reads temperature of the device, unless it has been read at least as strictly since the request arrived (called with the lock taken).
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param deviceIndex Index of the selected device
+ * @param arrived Generation of the device reading when the request arrived
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the reading
+ */
+static DS18B20_error_t ds18b20_shared_read_device(DS18B20_shared_t * const shared, const size_t deviceIndex, const unsigned int arrived, const bool checksum);
+
+/**
+ * @brief Reads temperatures of all devices, unless the bus has been read at least as strictly since the request arrived (called with the lock taken).
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param arrived Generation of the bus reading when the request arrived
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the reading
+ */
+static DS18B20_error_t ds18b20_shared_read_all(DS18B20_shared_t * const shared, const unsigned int arrived, const bool checksum);
+
+DS18B20_error_t ds18b20__InitSharedBus(DS18B20_shared_t * const shared, const DS18B20_onewire_t * const onewire, 
+    DS18B20_shared_reading_t * const readings, DS18B20_temperature_raw_t * const temperatures)
+{
+    if (!shared || !onewire || !readings || !temperatures)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    for (size_t i = 0; i < onewire->devicesNo; ++i)
+    {
+        atomic_init(&readings[i].generation, 0);
+        readings[i].status = DS18B20_NOT_READY;
+        readings[i].checksum = false;
+        temperatures[i] = 0;
+    }
+
+    if (!ds18b20_port_mutex_init(&shared->mutex))
+    {
+        return DS18B20_INV_CONF;
+    }
+
+    shared->onewire = onewire;
+    shared->readings = readings;
+    shared->temperatures = temperatures;
+    atomic_init(&shared->generation, 0);
+    shared->status = DS18B20_NOT_READY;
+    shared->checksum = false;
+    shared->convertions = 0;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__LockSharedBus(DS18B20_shared_t * const shared)
+{
+    if (!shared)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_port_mutex_lock(&shared->mutex);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__UnlockSharedBus(DS18B20_shared_t * const shared)
+{
+    if (!shared)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    ds18b20_port_mutex_unlock(&shared->mutex);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SharedGetTemperatureC(DS18B20_shared_t * const shared, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum)
+{
+    if (!temperatureOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    DS18B20_temperature_raw_t raw;
+    DS18B20_error_t status = ds18b20__SharedGetTemperatureRaw(shared, deviceIndex, &raw, checksum);
+    if (DS18B20_OK != status)
+    {
+        return status;
+    }
+
+    *temperatureOut = ds18b20__RawToC(raw);
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SharedGetTemperatureRaw(DS18B20_shared_t * const shared, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum)
+{
+    if (!shared || !temperatureOut || deviceIndex >= shared->onewire->devicesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    const unsigned int arrived = atomic_load(&shared->readings[deviceIndex].generation);
+
+    ds18b20_port_mutex_lock(&shared->mutex);
+        DS18B20_error_t status = ds18b20_shared_read_device(shared, deviceIndex, arrived, checksum);
+        *temperatureOut = shared->temperatures[deviceIndex];
+    ds18b20_port_mutex_unlock(&shared->mutex);
+
+    return status;
+}
+
+DS18B20_error_t ds18b20__SharedGetTemperaturesC(DS18B20_shared_t * const shared, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum)
+{
+    if (!shared || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    const unsigned int arrived = atomic_load(&shared->generation);
+
+    ds18b20_port_mutex_lock(&shared->mutex);
+        DS18B20_error_t status = ds18b20_shared_read_all(shared, arrived, checksum);
+        for (size_t i = 0; DS18B20_OK == status && i < shared->onewire->devicesNo; ++i)
+        {
+            temperaturesOut[i] = ds18b20__RawToC(shared->temperatures[i]);
+        }
+    ds18b20_port_mutex_unlock(&shared->mutex);
+
+    return status;
+}
+
+DS18B20_error_t ds18b20__SharedGetTemperaturesRaw(DS18B20_shared_t * const shared, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum)
+{
+    if (!shared || !temperaturesOut)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    const unsigned int arrived = atomic_load(&shared->generation);
+
+    ds18b20_port_mutex_lock(&shared->mutex);
+        DS18B20_error_t status = ds18b20_shared_read_all(shared, arrived, checksum);
+        if (DS18B20_OK == status)
+        {
+            memcpy(temperaturesOut, shared->temperatures, shared->onewire->devicesNo * sizeof(DS18B20_temperature_raw_t));
+        }
+    ds18b20_port_mutex_unlock(&shared->mutex);
+
+    return status;
+}
+
+static DS18B20_error_t ds18b20_shared_read_device(DS18B20_shared_t * const shared, const size_t deviceIndex, const unsigned int arrived, const bool checksum)
+{
+    DS18B20_shared_reading_t *reading = &shared->readings[deviceIndex];
+
+    // Reading finished while waiting for the lock was already in progress when the request arrived
+    if (arrived != atomic_load(&reading->generation) && (reading->checksum || !checksum))
+    {
+        return reading->status;
+    }
+
+    reading->status = ds18b20__GetTemperatureRaw(shared->onewire, deviceIndex, &shared->temperatures[deviceIndex], checksum);
+    reading->checksum = checksum;
+    ++shared->convertions;
+    atomic_fetch_add(&reading->generation, 1);
+
+    return reading->status;
+}
+
+static DS18B20_error_t ds18b20_shared_read_all(DS18B20_shared_t * const shared, const unsigned int arrived, const bool checksum)
+{
+    if (arrived != atomic_load(&shared->generation) && (shared->checksum || !checksum))
+    {
+        return shared->status;
+    }
+
+    // Requests for single devices waiting for the lock are served with this reading as well
+    shared->status = ds18b20__GetTemperaturesRaw(shared->onewire, shared->temperatures, checksum);
+    shared->checksum = checksum;
+    ++shared->convertions;
+    for (size_t i = 0; i < shared->onewire->devicesNo; ++i)
+    {
+        shared->readings[i].status = shared->status;
+        shared->readings[i].checksum = checksum;
+        atomic_fetch_add(&shared->readings[i].generation, 1);
+    }
+    atomic_fetch_add(&shared->generation, 1);
+
+    return shared->status;
+}
\ No newline at end of file
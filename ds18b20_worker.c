@@ -0,0 +1,268 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_worker.h"
+
+/**
+ * @brief Main function of the worker thread - performs queued requests until the worker is stopped.
+ * 
+ * @param arg Pointer to worker instance
+ */
+static void ds18b20_worker_run(void *arg);
+
+/**
+ * @brief Takes the oldest request from the ring (called by the worker thread only).
+ * 
+ * @param worker Pointer to worker instance
+ * @return DS18B20_request_t* Pointer to the request, NULL if the ring is empty
+ */
+static DS18B20_request_t *ds18b20_worker_pop(DS18B20_worker_t * const worker);
+
+/**
+ * @brief Performs the request on its bus and delivers completion.
+ * 
+ * @param worker Pointer to worker instance
+ * @param request Pointer to the request
+ */
+static void ds18b20_worker_perform(DS18B20_worker_t * const worker, DS18B20_request_t * const request);
+
+DS18B20_error_t ds18b20__InitWorkerConfigDefault(DS18B20_worker_config_t * const config)
+{
+    if (!config)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    config->core = DS18B20_WORKER_CORE_ANY;
+    config->priority = DS18B20_WORKER_PRIORITY_DEFAULT;
+    config->stackSize = DS18B20_WORKER_STACK_SIZE_DEFAULT;
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__InitWorker(DS18B20_worker_t * const worker, const DS18B20_onewire_t * const * const buses, const size_t busesNo, 
+    DS18B20_worker_slot_t * const slots, const size_t slotsNo)
+{
+    if (!worker || !buses || !busesNo || !slots || !slotsNo || (slotsNo & (slotsNo - 1)))
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    for (size_t busIndex = 0; busIndex < busesNo; ++busIndex)
+    {
+        if (!buses[busIndex])
+        {
+            return DS18B20_INV_ARG;
+        }
+    }
+
+    // Slot with sequence equal to the position is free for the producer of this lap
+    for (size_t i = 0; i < slotsNo; ++i)
+    {
+        atomic_init(&slots[i].sequence, i);
+        slots[i].request = NULL;
+    }
+
+    worker->buses = buses;
+    worker->busesNo = busesNo;
+    worker->slots = slots;
+    worker->slotsMask = slotsNo - 1;
+    atomic_init(&worker->head, 0);
+    worker->tail = 0;
+    atomic_init(&worker->started, false);
+    atomic_init(&worker->stopping, false);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__StartWorker(DS18B20_worker_t * const worker, const DS18B20_worker_config_t * const config)
+{
+    if (!worker || !config)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (atomic_load(&worker->started))
+    {
+        return DS18B20_INV_OP;
+    }
+
+    atomic_store(&worker->stopping, false);
+    if (!ds18b20_port_thread_start(&worker->thread, ds18b20_worker_run, worker, config->core, config->priority, config->stackSize))
+    {
+        return DS18B20_INV_CONF;
+    }
+    atomic_store(&worker->started, true);
+    // Request submitted after the worker has found the ring empty, but before it could be notified, would be left waiting
+    ds18b20_port_notify(ds18b20_port_thread_target(&worker->thread));
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__StopWorker(DS18B20_worker_t * const worker)
+{
+    if (!worker)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    if (!atomic_load(&worker->started))
+    {
+        return DS18B20_INV_OP;
+    }
+
+    atomic_store(&worker->stopping, true);
+    ds18b20_port_notify(ds18b20_port_thread_target(&worker->thread));
+    ds18b20_port_thread_join(&worker->thread);
+    atomic_store(&worker->started, false);
+
+    return DS18B20_OK;
+}
+
+DS18B20_error_t ds18b20__SubmitRequest(DS18B20_worker_t * const worker, DS18B20_request_t * const request)
+{
+    if (!worker || !request || request->type >= DS18B20_REQUEST_COUNT || request->busIndex >= worker->busesNo)
+    {
+        return DS18B20_INV_ARG;
+    }
+
+    request->status = DS18B20_NOT_READY;
+    atomic_store_explicit(&request->done, false, memory_order_relaxed);
+
+    // Producers race for the head position, winner owns the slot until it publishes the request
+    size_t position = atomic_load_explicit(&worker->head, memory_order_relaxed);
+    DS18B20_worker_slot_t *slot;
+    while (true)
+    {
+        slot = &worker->slots[position & worker->slotsMask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t lag = (intptr_t) sequence - (intptr_t) position;
+        if (0 == lag)
+        {
+            if (atomic_compare_exchange_weak_explicit(&worker->head, &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {   // Slot still holds request of the previous lap
+            return DS18B20_QUEUE_FULL;
+        }
+        else
+        {
+            position = atomic_load_explicit(&worker->head, memory_order_relaxed);
+        }
+    }
+
+    slot->request = request;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+    // Requests queued before the start are found by the worker after the notification sent by ds18b20__StartWorker(),
+    // fence orders publishing the request before the check, so either this or that notification wakes the worker
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&worker->started))
+    {
+        ds18b20_port_notify(ds18b20_port_thread_target(&worker->thread));
+    }
+    return DS18B20_OK;
+}
+
+bool ds18b20__IsRequestDone(DS18B20_request_t * const request)
+{
+    return request && atomic_load_explicit(&request->done, memory_order_acquire);
+}
+
+static void ds18b20_worker_run(void *arg)
+{
+    DS18B20_worker_t *worker = (DS18B20_worker_t *) arg;
+    while (true)
+    {
+        DS18B20_request_t *request = ds18b20_worker_pop(worker);
+        if (request)
+        {
+            ds18b20_worker_perform(worker, request);
+            continue;
+        }
+
+        if (atomic_load(&worker->stopping))
+        {
+            break;
+        }
+        ds18b20_port_wait_notification(ds18b20_port_thread_target(&worker->thread));
+    }
+
+    ds18b20_port_thread_exit(&worker->thread);
+}
+
+static DS18B20_request_t *ds18b20_worker_pop(DS18B20_worker_t * const worker)
+{
+    DS18B20_worker_slot_t *slot = &worker->slots[worker->tail & worker->slotsMask];
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != worker->tail + 1)
+    {
+        return NULL;
+    }
+
+    DS18B20_request_t *request = slot->request;
+    // Free the slot for the producer of the next lap
+    atomic_store_explicit(&slot->sequence, worker->tail + worker->slotsMask + 1, memory_order_release);
+    ++worker->tail;
+
+    return request;
+}
+
+static void ds18b20_worker_perform(DS18B20_worker_t * const worker, DS18B20_request_t * const request)
+{
+    const DS18B20_onewire_t *onewire = worker->buses[request->busIndex];
+    DS18B20_error_t status;
+    switch (request->type)
+    {
+        case DS18B20_REQUEST_CONVERT:
+            status = ds18b20__RequestTemperaturesC(onewire);
+            break;
+        case DS18B20_REQUEST_READ:
+            status = ds18b20__GetTemperaturesRaw(onewire, request->temperaturesOut, request->checksum);
+            break;
+        case DS18B20_REQUEST_CONFIGURE:
+            status = ds18b20__Configure(onewire, request->deviceIndex, request->config, request->checksum);
+            break;
+        case DS18B20_REQUEST_SEARCH:
+            status = ds18b20__FindAllAlarms(onewire, request->alarmsOut, request->alarmsNoOut, request->checksum);
+            break;
+        default:
+            status = DS18B20_INV_ARG;
+            break;
+    }
+
+    // Notification target is read before publishing completion, the request may be reused right after that
+    DS18B20_request_callback_t callback = request->callback;
+    void *context = request->callbackContext;
+    DS18B20_notify_t notify = request->notify;
+
+    request->status = status;
+    if (callback)
+    {
+        callback(request, context);
+    }
+    atomic_store_explicit(&request->done, true, memory_order_release);
+    if (notify)
+    {
+        ds18b20_port_notify(notify);
+    }
+}
@@ -33,6 +33,7 @@
 #include "ds18b20_low.h"
 #include "ds18b20_types_res.h"
 #include "ds18b20_error_codes.h"
+#include "ds18b20_topology.h"
 
 /** Means that function will not check if device has ended specified operation - it will wait the maximum defined time */
 #define DS18B20_NO_CHECK_PERIOD         0
@@ -42,8 +43,17 @@
 #define DS18B20_TEMP_MIN                -55
 /** The maximum temperature value the device can measure */
 #define DS18B20_TEMP_MAX                125
+/** Family code value which disables filtering of devices during discovery */
+#define DS18B20_ANY_FAMILY              0x00
+/** Number of devices described by single word of alarm bitmap */
+#define DS18B20_ALARM_BITMAP_WORD_BITS  32
+/** Number of words of alarm bitmap required for given number of devices */
+#define DS18B20_ALARM_BITMAP_WORDS(devicesNo)   (((devicesNo) + DS18B20_ALARM_BITMAP_WORD_BITS - 1) / DS18B20_ALARM_BITMAP_WORD_BITS)
+/** Recommended number of ROM index slots for given number of devices */
+#define DS18B20_ROM_INDEX_SIZE(devicesNo)   (2 * (devicesNo))
 
 typedef struct DS18B20_config_t DS18B20_config_t;
+typedef struct DS18B20_convertion_t DS18B20_convertion_t;
 
 /**
  * @brief Describes configuration options for DS18B20.
@@ -57,11 +67,27 @@ struct DS18B20_config_t
     DS18B20_resolution_t                resolution; /**< Temperature convertion resolution to configure */
 };
 
+/**
+ * @brief Describes temperature convertion which has been started, but its result has not been collected yet.
+ * 
+ * @note Structure will be initialized using ds18b20__StartTemperatureC() or ds18b20__StartTemperaturesC() method.
+ */
+struct DS18B20_convertion_t
+{
+    uint32_t                            startMs; /**< Time when the convertion has been requested (in milliseconds) */
+    uint32_t                            expectedMs; /**< Time when the convertion is expected to be finished according to learned convertion time (in milliseconds) */
+    uint32_t                            deadlineMs; /**< Time when the convertion is guaranteed to be finished (in milliseconds) */
+    bool                                strongPullup; /**< Indicates if strong pullup is enabled during the convertion (parasite power mode) */
+    bool                                ready; /**< Indicates if the convertion has already been finished */
+};
+
+#ifdef ESP_PLATFORM
 /**
  * @brief Initializes One-Wire instance and DS18B20 device instances.
  * 
  * Prepares given GPIO to communicate with One-Wire protocol, searches for specified amount of devices,
  * reads and sets their ROM addresses for proper identification, power modes and scratchpad memory.
+ * Power modes are probed with a single broadcast, devices are probed one by one only if any of them is parasite powered.
  * @note This method need to be called before using any other high-level driver functions.
  * 
  * @param onewire Pointer to One-Wire bus characteristics instance to initialize
@@ -72,6 +98,196 @@ struct DS18B20_config_t
  * @return DS18B20_error_t Status code of the operation
  */
 DS18B20_error_t ds18b20__InitOneWire(DS18B20_onewire_t * const onewire, const int bus, DS18B20_t * const devices, const size_t devicesNo, const bool checksum);
+#endif /* ESP_PLATFORM */
+
+/**
+ * @brief Initializes One-Wire instance using the specified transport and DS18B20 device instances.
+ * 
+ * Works the same way as ds18b20__InitOneWire(), but the bus is driven by the given transport implementation
+ * instead of bit-banging GPIO, e.g. by simulated bus.
+ * @note This method or ds18b20__InitOneWire() need to be called before using any other high-level driver functions.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances to initialize
+ * @param devicesNo Number of devices to initialize
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitOneWireWithTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t devicesNo, const bool checksum);
+
+#ifdef ESP_PLATFORM
+/**
+ * @brief Initializes One-Wire instance discovering the number of connected devices.
+ * 
+ * Prepares given GPIO to communicate with One-Wire protocol and enumerates all devices connected to the bus.
+ * Devices with matching family code are stored in the given array (up to its capacity) and initialized 
+ * the same way as in ds18b20__InitOneWire() method.
+ * @note This method or ds18b20__InitOneWire() need to be called before using any other high-level driver functions.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param bus Chosen GPIO for One-Wire bus
+ * @param devices Array of device characteristics instances to fill
+ * @param capacity Number of elements in devices array
+ * @param familyCode Family code of devices to handle (e.g. 0x28 for DS18B20) or DS18B20_ANY_FAMILY
+ * @param devicesNoOut Pointer to variable where the number of found matching devices will be saved (it can exceed capacity - only first devices are handled then)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DiscoverOneWire(DS18B20_onewire_t * const onewire, const int bus, DS18B20_t * const devices, const size_t capacity, 
+    const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum);
+#endif /* ESP_PLATFORM */
+
+/**
+ * @brief Initializes One-Wire instance using custom transport and discovering the number of connected devices.
+ * 
+ * Works the same way as ds18b20__DiscoverOneWire() method, but communicates through given physical layer.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances to fill
+ * @param capacity Number of elements in devices array
+ * @param familyCode Family code of devices to handle (e.g. 0x28 for DS18B20) or DS18B20_ANY_FAMILY
+ * @param devicesNoOut Pointer to variable where the number of found matching devices will be saved (it can exceed capacity - only first devices are handled then)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DiscoverOneWireWithTransport(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum);
+
+/**
+ * @brief Initializes packed storage of devices with arrays provided by the user.
+ * 
+ * Every array needs one element per each device. Storage takes @ref DS18B20_STORAGE_BYTES_PER_DEVICE bytes per device
+ * instead of the size of @ref DS18B20_t and keeps data of the whole bus read during every operation close together.
+ * 
+ * @param storage Pointer to storage instance to initialize
+ * @param roms Array for ROM addresses of the devices
+ * @param temperatures Array for temperatures read from the devices
+ * @param flags Array for packed resolutions and power modes of the devices
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitStorage(DS18B20_storage_t * const storage, DS18B20_rom_t * const roms, DS18B20_temperature_raw_t * const temperatures, uint8_t * const flags);
+
+/**
+ * @brief Initializes One-Wire instance using custom transport and packed storage of devices instead of DS18B20 device instances.
+ * 
+ * Works the same way as ds18b20__InitOneWireWithTransport(). 
+ * All the other methods work the same way for both kinds of device storage.
+ * @note In order to access the device as @ref DS18B20_t, please use ds18b20__GetDeviceView() method.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param storage Pointer to storage initialized with ds18b20__InitStorage() method
+ * @param devicesNo Number of devices to initialize
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitOneWireWithStorage(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_storage_t * const storage, const size_t devicesNo, const bool checksum);
+
+/**
+ * @brief Initializes One-Wire instance using custom transport and packed storage of devices while discovering the number of connected devices.
+ * 
+ * Works the same way as ds18b20__DiscoverOneWireWithTransport().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param storage Pointer to storage initialized with ds18b20__InitStorage() method
+ * @param capacity Number of devices storage arrays can hold
+ * @param familyCode Family code of devices to handle (e.g. 0x28 for DS18B20) or DS18B20_ANY_FAMILY
+ * @param devicesNoOut Pointer to variable where the number of found matching devices will be saved (it can exceed capacity - only first devices are handled then)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DiscoverOneWireWithStorage(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_storage_t * const storage, const size_t capacity, const uint8_t familyCode, size_t * const devicesNoOut, const bool checksum);
+
+/**
+ * @brief Initializes topology cache with store and buffer provided by the user.
+ * 
+ * @param topology Pointer to topology instance to initialize
+ * @param store Pointer to store keeping the blob between restarts
+ * @param storeContext Data specific for the used store implementation
+ * @param blob Buffer for the blob, it needs at least @ref DS18B20_TOPOLOGY_SIZE bytes for the number of devices on the bus
+ * @param blobSize Size of the buffer in bytes
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitTopology(DS18B20_topology_t * const topology, const DS18B20_topology_store_t * const store, void * const storeContext, 
+    uint8_t * const blob, const size_t blobSize);
+
+/**
+ * @brief Initializes One-Wire instance using custom transport and topology saved during the previous start.
+ * 
+ * Cached ROM addresses are verified while reading scratchpad memory of the devices, which has to be done anyway,
+ * and cached power modes are checked against single broadcast probe, so ROM search is skipped entirely.
+ * If the blob is missing or any device does not match it, initialization falls back to ds18b20__InitOneWireWithTransport() 
+ * and the discovered topology is saved for the next start.
+ * @note Devices added to the bus are noticed only if the number of devices to initialize changes as well.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance to initialize
+ * @param transport Pointer to transport implementing physical layer of the bus
+ * @param transportContext Data specific for the used transport implementation
+ * @param devices Array of device characteristics instances to initialize
+ * @param devicesNo Number of devices to initialize
+ * @param topology Pointer to topology initialized with ds18b20__InitTopology() method
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitOneWireWithTopology(DS18B20_onewire_t * const onewire, const DS18B20_transport_t * const transport, void * const transportContext, 
+    DS18B20_t * const devices, const size_t devicesNo, DS18B20_topology_t * const topology, const bool checksum);
+
+/**
+ * @brief Writes topology of One-Wire bus (ROM addresses, power modes and resolutions of all devices) into the given buffer.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param blob Buffer for the blob
+ * @param blobSize Size of the buffer in bytes, at least @ref DS18B20_TOPOLOGY_SIZE bytes for the number of devices
+ * @param sizeOut Pointer to variable where the size of the blob will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__ExportTopology(const DS18B20_onewire_t * const onewire, uint8_t * const blob, const size_t blobSize, size_t * const sizeOut);
+
+/**
+ * @brief Exports topology of One-Wire bus and saves it in the store of the topology cache.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param topology Pointer to topology initialized with ds18b20__InitTopology() method
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SaveTopology(const DS18B20_onewire_t * const onewire, const DS18B20_topology_t * const topology);
+
+/**
+ * @brief Copies characteristics of the selected device into DS18B20 device instance, whatever kind of storage is used by One-Wire bus.
+ * 
+ * If packed storage is used, only temperature and configuration bytes of scratchpad are filled.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param viewOut Pointer to device instance where characteristics will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetDeviceView(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_t * const viewOut);
+
+/**
+ * @brief Sets scope of critical sections used while communicating on One-Wire bus.
+ * 
+ * Every bus has its own spinlock, so different buses can be used simultaneously from both cores.
+ * By default every timeslot is generated in separate critical section. Wider scopes decrease 
+ * locking overhead, but interrupts stay disabled longer (a whole transaction may take several milliseconds).
+ * Transaction scope also excludes other tasks using the same bus from the other core until the transaction is finished.
+ * Scope cannot be changed from inside of critical section, otherwise it waits for the current transaction to be finished.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param critical Scope of critical sections
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SetCriticalScope(DS18B20_onewire_t * const onewire, const DS18B20_critical_t critical);
 
 /**
  * @brief Initializes configuration options of DS18B20 with the default values (power-on reset values).
@@ -145,12 +361,477 @@ DS18B20_error_t ds18b20__GetTemperatureC(const DS18B20_onewire_t * const onewire
  */
 DS18B20_error_t ds18b20__GetTemperatureCWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, uint16_t checkPeriodMs, const bool checksum);
 
+/**
+ * @brief Only requests all DS18B20 connected to One-Wire bus for temperature convertion without reading their values.
+ * 
+ * Sends a single broadcast convertion request to every device on the bus at once.
+ * Waits the maximum possible time required to perform this operation for the highest resolution used on the bus.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__RequestTemperaturesC(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Only requests all DS18B20 connected to One-Wire bus for temperature convertion without reading their values while periodically checking if performing operation by the devices has ended.
+ * 
+ * Sends a single broadcast convertion request to every device on the bus at once.
+ * Waits until this operation has finished by periodically checking its status.
+ * This method cannot be used if any of connected DS18B20 is working in parasite mode!
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checkPeriodMs Specifies how often the status of the temperature convertion will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for temperature convertion
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__RequestTemperaturesCWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs);
+
+/**
+ * @brief Reads the current temperatures all devices connected to One-Wire bus have measured (in Celsius).
+ * 
+ * Requests all DS18B20 from One-Wire bus for temperature convertion at once. 
+ * Waits the maximum possible time required to perform this operation for the highest resolution used on the bus.
+ * Reads measured temperatures from memory of each device in turn and converts them into human-readable values. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Reads the current temperatures all devices connected to One-Wire bus have measured (in Celsius) while periodically checking if performing operation by the devices has ended.
+ * 
+ * Requests all DS18B20 from One-Wire bus for temperature convertion at once.
+ * Waits until this operation has finished by periodically checking its status.
+ * Reads measured temperatures from memory of each device in turn and converts them into human-readable values. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * This method cannot be used if any of connected DS18B20 is working in parasite mode!
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checkPeriodMs Specifies how often the status of the temperature convertion will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for temperature convertion
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesCWithChecking(const DS18B20_onewire_t * const onewire, DS18B20_temperature_out_t * const temperaturesOut, uint16_t checkPeriodMs, const bool checksum);
+
+/**
+ * @brief Starts temperature convertion of chosen DS18B20 and returns immediately without waiting for it to finish.
+ * 
+ * Saves the time when the convertion is guaranteed to be finished, so the calling task can do other work in the meantime.
+ * If learning of convertion time is enabled, the time when the convertion is expected to be finished is saved as well.
+ * If selected device is working in parasite mode, no other One-Wire bus activity may take place until its temperature is collected.
+ * @note In order to read the temperature, please use ds18b20__IsConvertionReady() and ds18b20__CollectTemperatureC() methods.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param convertion Pointer to convertion instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StartTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion);
+
+/**
+ * @brief Starts temperature convertion of all DS18B20 connected to One-Wire bus and returns immediately without waiting for it to finish.
+ * 
+ * Sends a single broadcast convertion request to every device on the bus at once.
+ * Saves the time when the convertion is guaranteed to be finished for the highest resolution used on the bus
+ * (and expected to be finished if learning of convertion time is enabled).
+ * If any of connected devices is working in parasite mode, no other One-Wire bus activity may take place until temperatures are collected.
+ * @note In order to read temperatures, please use ds18b20__IsConvertionReady() and ds18b20__CollectTemperaturesC() methods.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to convertion instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StartTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion);
+
+/**
+ * @brief Checks without blocking if started temperature convertion has already been finished.
+ * 
+ * Compares the current time with the convertion deadline. 
+ * If the deadline has not passed yet and strong pullup is not enabled, status of the devices is additionally checked with a single read timeslot.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to started convertion instance
+ * @param readyOut Pointer to variable where the result of checking will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__IsConvertionReady(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, bool * const readyOut);
+
+/**
+ * @brief Reads the temperature measured (in Celsius) during started convertion of chosen DS18B20.
+ * 
+ * Reads measured temperature from the device memory where it has been stored and converts it into human-readable value. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * If the convertion has not been finished yet, nothing is read and status code of the operation will indicate this with the proper value.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param convertion Pointer to started convertion instance
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__CollectTemperatureC(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion, DS18B20_temperature_out_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Reads the temperatures measured (in Celsius) by all devices connected to One-Wire bus during started convertion.
+ * 
+ * Reads measured temperatures from memory of each device in turn and converts them into human-readable values. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * If the convertion has not been finished yet, nothing is read and status code of the operation will indicate this with the proper value.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to started convertion instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__CollectTemperaturesC(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Reads the current temperature the device has measured as raw value (in 1/16 Celsius).
+ * 
+ * Works the same way as ds18b20__GetTemperatureC(), but no floating point operations are performed,
+ * so it can be used by tasks that never touch the FPU.
+ * @note Raw value can be converted with ds18b20__RawToMilliC() or ds18b20__RawToC() methods.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Reads the current temperature the device has measured as raw value (in 1/16 Celsius) while periodically checking if performing operation by the device has ended.
+ * 
+ * Works the same way as ds18b20__GetTemperatureCWithChecking(), but no floating point operations are performed.
+ * This method cannot be used if selected DS18B20 is working in parasite mode!
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checkPeriodMs Specifies how often the status of the temperature convertion will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for temperature convertion
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperatureRawWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, uint16_t checkPeriodMs, const bool checksum);
+
+/**
+ * @brief Reads the current temperatures all devices connected to One-Wire bus have measured as raw values (in 1/16 Celsius).
+ * 
+ * Works the same way as ds18b20__GetTemperaturesC(), but no floating point operations are performed.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesRaw(const DS18B20_onewire_t * const onewire, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Reads the current temperatures all devices connected to One-Wire bus have measured as raw values (in 1/16 Celsius) while periodically checking if performing operation by the devices has ended.
+ * 
+ * Works the same way as ds18b20__GetTemperaturesCWithChecking(), but no floating point operations are performed.
+ * This method cannot be used if any of connected DS18B20 is working in parasite mode!
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checkPeriodMs Specifies how often the status of the temperature convertion will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for temperature convertion
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesRawWithChecking(const DS18B20_onewire_t * const onewire, DS18B20_temperature_raw_t * const temperaturesOut, uint16_t checkPeriodMs, const bool checksum);
+
+/**
+ * @brief Reads the temperature measured as raw value (in 1/16 Celsius) during started convertion of chosen DS18B20.
+ * 
+ * Works the same way as ds18b20__CollectTemperatureC(), but no floating point operations are performed.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param convertion Pointer to started convertion instance
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__CollectTemperatureRaw(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, DS18B20_convertion_t * const convertion, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Reads the temperatures measured as raw values (in 1/16 Celsius) by all devices connected to One-Wire bus during started convertion.
+ * 
+ * Works the same way as ds18b20__CollectTemperaturesC(), but no floating point operations are performed.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param convertion Pointer to started convertion instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__CollectTemperaturesRaw(const DS18B20_onewire_t * const onewire, DS18B20_convertion_t * const convertion, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Converts raw temperature value into Celsius.
+ * 
+ * @param raw Temperature in 1/16 Celsius
+ * @return DS18B20_temperature_out_t Temperature in Celsius
+ */
+DS18B20_temperature_out_t ds18b20__RawToC(const DS18B20_temperature_raw_t raw);
+
+/**
+ * @brief Converts raw temperature value into thousandths of Celsius using integer arithmetic only.
+ * 
+ * Results of 12-bit resolution ending with half of thousandth are rounded toward zero.
+ * 
+ * @param raw Temperature in 1/16 Celsius
+ * @return DS18B20_temperature_milli_t Temperature in 1/1000 Celsius
+ */
+DS18B20_temperature_milli_t ds18b20__RawToMilliC(const DS18B20_temperature_raw_t raw);
+
+/**
+ * @brief Initializes limits of adaptive integrity mode with default values.
+ * 
+ * Default range is the whole measurement range of DS18B20, default change between consecutive readings is limited to 10 Celsius.
+ * 
+ * @param integrity Pointer to limits instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitIntegrityDefault(DS18B20_integrity_t * const integrity);
+
+/**
+ * @brief Enables adaptive integrity mode of temperature reads.
+ * 
+ * Reading methods called without CRC checksum read only temperature bytes as long as readings look plausible.
+ * Reading out of range, changed too much since the previous one or equal to power-on reset value (85 Celsius) 
+ * is read again as the whole scratchpad verified with CRC checksum, so do the next escalationReads readings of this device.
+ * The first reading of every device is always verified.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param integrity Pointer to limits of plausible readings (copied into One-Wire bus instance)
+ * @param states Array of states (one per each device), it needs to remain valid while the mode is enabled
+ * @param statesNo Number of elements in states array
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__EnableAdaptiveIntegrity(DS18B20_onewire_t * const onewire, const DS18B20_integrity_t * const integrity, 
+    DS18B20_integrity_state_t * const states, const size_t statesNo);
+
+/**
+ * @brief Disables adaptive integrity mode of temperature reads.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DisableAdaptiveIntegrity(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Enables learning of temperature convertion time.
+ * 
+ * Blocking convertions of externally powered devices sleep until the learned convertion time is about to pass 
+ * and then poll the bus every millisecond (regardless of given check period), measuring how long the convertion took.
+ * Measurements update a running average and deviation kept per each device (single device convertions)
+ * and in the last element of states array (convertions started on all devices).
+ * Devices in parasite power mode cannot report the end of convertion, so strong pullup is held for
+ * the average increased by four deviations and marginMs - only if their states have been filled in after enabling 
+ * (e.g. restored from a calibration run with external supply), otherwise the worst case time is used.
+ * Learned time never exceeds the worst case time given by the specification.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param states Array of states (one per each device and one more for all devices), it needs to remain valid while learning is enabled
+ * @param statesNo Number of elements in states array
+ * @param marginMs Safety margin added to learned convertion time (in milliseconds)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__EnableConvertionLearning(DS18B20_onewire_t * const onewire, DS18B20_timing_state_t * const states, 
+    const size_t statesNo, const uint16_t marginMs);
+
+/**
+ * @brief Disables learning of temperature convertion time.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DisableConvertionLearning(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Initializes targets of adaptive resolution mode with default values.
+ * 
+ * By default all resolutions are allowed and temperature change between readings should span at least two resolution steps.
+ * Higher resolution is restored after three consecutive readings calling for it.
+ * 
+ * @param policy Pointer to targets instance to initialize
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitResolutionPolicyDefault(DS18B20_resolution_policy_t * const policy);
+
+/**
+ * @brief Enables adaptive resolution mode.
+ * 
+ * Every temperature reading updates running averages of trend and noise of the device.
+ * The coarsest resolution whose step is not greater than the change between readings divided by stepsPerChange is chosen,
+ * limited by maxConvertionMs and then by minResolution (precision target takes precedence). 
+ * Resolution is lowered at once, but raised only after settleReadings consecutive readings.
+ * Configuration register is written just before the next temperature convertion of the device and only if chosen resolution has changed 
+ * (it is not copied into EEPROM).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param policy Pointer to targets of the mode (copied into One-Wire bus instance)
+ * @param states Array of states (one per each device), it needs to remain valid while the mode is enabled
+ * @param statesNo Number of elements in states array
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__EnableAdaptiveResolution(DS18B20_onewire_t * const onewire, const DS18B20_resolution_policy_t * const policy, 
+    DS18B20_resolution_state_t * const states, const size_t statesNo);
+
+/**
+ * @brief Disables adaptive resolution mode.
+ * 
+ * Devices keep the resolution used lately.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DisableAdaptiveResolution(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Enables avoidance of redundant configuration and EEPROM writes.
+ * 
+ * Configurable registers read back from each device (and the ones known to be stored in its EEPROM) are mirrored.
+ * Configuring methods skip the bus write if the device already holds requested configuration,
+ * storing methods skip copying into EEPROM if it already holds the same configuration as scratchpad.
+ * Mirrors become stale after ds18b20__InvalidateMirrors() call or when the device reports power-on reset temperature.
+ * All mirrors are stale right after enabling, so the first configuration of each device is always written.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param mirrors Array of mirrors (one per each device), it needs to remain valid while write avoidance is enabled
+ * @param mirrorsNo Number of elements in mirrors array
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__EnableWriteAvoidance(DS18B20_onewire_t * const onewire, DS18B20_mirror_t * const mirrors, const size_t mirrorsNo);
+
+/**
+ * @brief Disables avoidance of redundant configuration and EEPROM writes.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DisableWriteAvoidance(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Marks mirrors of all devices as stale by starting a new generation.
+ * 
+ * Should be called whenever devices could have been changed without the driver knowing it (e.g. power loss or another bus master).
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InvalidateMirrors(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Enables caching of the last temperature read from each device.
+ * 
+ * Every successful temperature reading is cached together with the time it has been captured.
+ * Getters with maximal age return cached temperatures if they are fresh enough and access the bus otherwise.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param entries Array of cache entries (one per each device), it needs to remain valid while caching is enabled
+ * @param entriesNo Number of elements in entries array
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__EnableTemperatureCache(DS18B20_onewire_t * const onewire, DS18B20_cache_entry_t * const entries, const size_t entriesNo);
+
+/**
+ * @brief Disables caching of temperatures.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__DisableTemperatureCache(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Drops cached temperatures of all devices, so the next reading of each device accesses the bus.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InvalidateTemperatureCache(DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Returns the temperature of chosen DS18B20 read not earlier than the specified time ago.
+ * 
+ * Cached temperature is returned if it is fresh enough, otherwise new convertion is requested and its result is read from the device.
+ * If caching is disabled, behaves the same as ds18b20__GetTemperatureC().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param maxAgeMs Maximal age of cached temperature (in milliseconds)
+ * @param temperatureOut Pointer to variable where the temperature (in Celsius) will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperatureCCached(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, DS18B20_temperature_out_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Returns the temperature of chosen DS18B20 as raw value, read not earlier than the specified time ago.
+ * 
+ * Cached temperature is returned if it is fresh enough, otherwise new convertion is requested and its result is read from the device.
+ * If caching is disabled, behaves the same as ds18b20__GetTemperatureRaw().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param maxAgeMs Maximal age of cached temperature (in milliseconds)
+ * @param temperatureOut Pointer to variable where the temperature (in 1/16 Celsius) will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperatureRawCached(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const uint32_t maxAgeMs, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Returns temperatures of all devices connected to One-Wire bus, read not earlier than the specified time ago.
+ * 
+ * If any cached temperature is too old, single convertion is requested on all devices and only the stale ones are read from the bus.
+ * If caching is disabled, behaves the same as ds18b20__GetTemperaturesC().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param maxAgeMs Maximal age of cached temperatures (in milliseconds)
+ * @param temperaturesOut Array where temperatures (in Celsius) will be saved eventually (one per each device)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesCCached(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Returns temperatures of all devices connected to One-Wire bus as raw values, read not earlier than the specified time ago.
+ * 
+ * If any cached temperature is too old, single convertion is requested on all devices and only the stale ones are read from the bus.
+ * If caching is disabled, behaves the same as ds18b20__GetTemperaturesRaw().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param maxAgeMs Maximal age of cached temperatures (in milliseconds)
+ * @param temperaturesOut Array where temperatures (in 1/16 Celsius) will be saved eventually (one per each device)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__GetTemperaturesRawCached(const DS18B20_onewire_t * const onewire, const uint32_t maxAgeMs, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum);
+
 /**
  * @brief Configures the selected device with the specified options.
  * 
  * Changes set configuration of chosen DS18B20 and acquires it from the memory.
  * Optionally, validates received data from the One-Wire line with CRC checksum.
  * All configuration options must be specified, because all of them will be written into DS18B20 memory.
+ * If write avoidance is enabled and the device is known to hold this configuration already, nothing is sent.
  * @note In order to initialize them with default values, please use ds18b20__InitConfigDefault() method.
  * 
  * @param onewire Pointer to One-Wire bus characteristics instance
@@ -161,6 +842,77 @@ DS18B20_error_t ds18b20__GetTemperatureCWithChecking(const DS18B20_onewire_t * c
  */
 DS18B20_error_t ds18b20__Configure(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_config_t * const config, const bool checksum);
 
+/**
+ * @brief Checks presence of devices with the given ROM addresses, one verifying search cycle per each address.
+ * 
+ * Every check takes the same fixed number of timeslots, see ds18b20_verify_rom() method.
+ * Addresses do not need to belong to devices handled by One-Wire instance.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param roms Array of ROM addresses to look for
+ * @param romsNo Number of elements in roms array
+ * @param presentOut Array where presence of each device will be saved eventually (one element per each ROM address)
+ * @param presentNoOut Pointer to variable where the number of present devices will be saved eventually (optional)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__VerifyRoms(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t * const roms, const size_t romsNo, 
+    bool * const presentOut, size_t * const presentNoOut);
+
+/**
+ * @brief Checks presence of all devices handled by One-Wire instance, one verifying search cycle per each device.
+ * 
+ * Device with index i is marked by bit (i % 32) of word (i / 32) in the bitmap, the same way as in ds18b20__FindAllAlarms().
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param presentOut Bitmap of present devices, it needs @ref DS18B20_ALARM_BITMAP_WORDS words for the number of devices
+ * @param presentNoOut Pointer to variable where the number of present devices will be saved eventually (optional)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__VerifyDevices(const DS18B20_onewire_t * const onewire, uint32_t * const presentOut, size_t * const presentNoOut);
+
+/**
+ * @brief Searches for all devices whose last measured temperature is within the specified alarm range.
+ * 
+ * Performs complete alarm search traversal of the bus in one call - one search cycle per alarming device.
+ * Device with index i is marked by bit (i % 32) of word (i / 32) in the bitmap.
+ * Alarming devices which are not handled by One-Wire instance are skipped.
+ * Optionally, validates received data (ROM addresses) from the One-Wire line with CRC checksum.
+ * @note Building ROM index with ds18b20__BuildRomIndex() method speeds up mapping of found devices.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param alarmsOut Bitmap of alarming devices, it needs to have at least DS18B20_ALARM_BITMAP_WORDS(devicesNo) words
+ * @param alarmsNoOut Pointer to variable where number of alarming devices will be saved (can be NULL)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__FindAllAlarms(const DS18B20_onewire_t * const onewire, uint32_t * const alarmsOut, size_t * const alarmsNoOut, const bool checksum);
+
+/**
+ * @brief Builds index mapping ROM addresses of initialized devices to their indices.
+ * 
+ * Index is an open-addressing hash table stored in memory provided by the caller, 
+ * so looking up the device by ROM address (e.g. found during alarm search) does not need to compare all devices.
+ * @note Index needs to be built again after the One-Wire instance is initialized again.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param slots Array of slots for the index (its content will be overwritten)
+ * @param slotsNo Number of slots - needs to be greater than number of devices, DS18B20_ROM_INDEX_SIZE() is recommended
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__BuildRomIndex(DS18B20_onewire_t * const onewire, size_t * const slots, const size_t slotsNo);
+
+/**
+ * @brief Finds the index of the device with given ROM address.
+ * 
+ * Uses ROM index if it has been built, otherwise compares ROM addresses of all devices.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param rom ROM address of the device
+ * @param deviceIndexOut Pointer to variable where index of the found device will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__FindDeviceByRom(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t rom, size_t * const deviceIndexOut);
+
 /**
  * @brief Searches for the next device whose last measured temperature is within the specified alarm range.
  * 
@@ -184,6 +936,7 @@ DS18B20_error_t ds18b20__FindNextAlarm(DS18B20_onewire_t * const onewire, size_t
  * Requests chosen DS18B20 from One-Wire bus for copying memory into its EEPROM. 
  * Waits the maximum possible time required to perform this operation.
  * This method should be called a reasonable number of times, because EEPROM of DS18B20 has limited lifetime!
+ * If write avoidance is enabled and EEPROM is known to hold the same configuration as scratchpad, copying is skipped.
  * 
  * @param onewire Pointer to One-Wire bus characteristics instance
  * @param deviceIndex Index of the selected device
@@ -197,6 +950,7 @@ DS18B20_error_t ds18b20__StoreRegisters(const DS18B20_onewire_t * const onewire,
  * Requests chosen DS18B20 from One-Wire bus for copying memory into its EEPROM. 
  * Waits until this operation has finished by periodically checking its status.
  * This method should be called a reasonable number of times, because EEPROM of DS18B20 has limited lifetime!
+ * If write avoidance is enabled and EEPROM is known to hold the same configuration as scratchpad, copying is skipped.
  * This method cannot be used if selected DS18B20 is working in parasite mode!
  * 
  * @param onewire Pointer to One-Wire bus characteristics instance
@@ -243,4 +997,86 @@ DS18B20_error_t ds18b20__RestoreRegisters(const DS18B20_onewire_t * const onewir
  */
 DS18B20_error_t ds18b20__RestoreRegistersWithChecking(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint16_t checkPeriodMs, const bool checksum);
 
+/**
+ * @brief Configures all devices connected to One-Wire bus with the same options.
+ * 
+ * Writes configuration into memory of all DS18B20 at once and then verifies each of them with a short read of its registers.
+ * If the bus holds devices not handled by this instance (of other families or above the capacity), handled devices are addressed one by one instead.
+ * Optionally, validates received data from the One-Wire line with CRC checksum (whole scratchpad is read in this case).
+ * All configuration options must be specified, because all of them will be written into DS18B20 memory.
+ * If write avoidance is enabled and all devices are known to hold this configuration already, nothing is sent.
+ * @note In order to initialize them with default values, please use ds18b20__InitConfigDefault() method.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param config Pointer to DS18B20 configuration instance
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation, @ref DS18B20_VERIFY_FAIL if any device has not accepted the configuration
+ */
+DS18B20_error_t ds18b20__ConfigureAll(const DS18B20_onewire_t * const onewire, const DS18B20_config_t * const config, const bool checksum);
+
+/**
+ * @brief Copies configuration of all devices connected to One-Wire bus into their non-volatile memory at once.
+ * 
+ * Requests all DS18B20 from One-Wire bus for copying memory into their EEPROM with a single command. 
+ * If the bus holds devices not handled by this instance (of other families or above the capacity), handled devices are addressed one by one instead.
+ * Waits the maximum possible time required to perform this operation.
+ * This method should be called a reasonable number of times, because EEPROM of DS18B20 has limited lifetime!
+ * If write avoidance is enabled and EEPROM is known to hold the same configuration as scratchpad, copying is skipped.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StoreRegistersAll(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Copies configuration of all devices connected to One-Wire bus into their non-volatile memory at once while periodically checking if performing operation by the devices has ended.
+ * 
+ * Requests all DS18B20 from One-Wire bus for copying memory into their EEPROM with a single command. 
+ * If the bus holds devices not handled by this instance (of other families or above the capacity), handled devices are addressed one by one instead.
+ * Waits until this operation has finished by periodically checking its status.
+ * This method should be called a reasonable number of times, because EEPROM of DS18B20 has limited lifetime!
+ * If write avoidance is enabled and EEPROM is known to hold the same configuration as scratchpad, copying is skipped.
+ * This method cannot be used if any of connected DS18B20 is working in parasite mode!
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checkPeriodMs Specifies how often the status of copying data will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for copying data
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StoreRegistersAllWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs);
+
+/**
+ * @brief Restores configuration of all devices connected to One-Wire bus from their non-volatile memory at once.
+ * 
+ * Requests all DS18B20 from One-Wire bus for restoring memory from their EEPROM with a single command. 
+ * If the bus holds devices not handled by this instance (of other families or above the capacity), handled devices are addressed one by one instead.
+ * Waits the maximum possible time required to perform this operation.
+ * Reads the restored configuration from memory of each device. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__RestoreRegistersAll(const DS18B20_onewire_t * const onewire, const bool checksum);
+
+/**
+ * @brief Restores configuration of all devices connected to One-Wire bus from their non-volatile memory at once while periodically checking if performing operation by the devices has ended.
+ * 
+ * Requests all DS18B20 from One-Wire bus for restoring memory from their EEPROM with a single command. 
+ * If the bus holds devices not handled by this instance (of other families or above the capacity), handled devices are addressed one by one instead.
+ * Waits until this operation has finished by periodically checking its status.
+ * Reads the restored configuration from memory of each device. 
+ * Optionally, validates received data from the One-Wire line with CRC checksum.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param checkPeriodMs Specifies how often the status of restoring data will be checked (in milliseconds),
+ * given value cannot be less than @ref DS18B20_CHECK_PERIOD_MIN_MS,
+ * value equals to @ref DS18B20_NO_CHECK_PERIOD means that method will wait the maximum possible time required for restoring data
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__RestoreRegistersAllWithChecking(const DS18B20_onewire_t * const onewire, uint16_t checkPeriodMs, const bool checksum);
+
 #endif /* DS18B20_H */
@@ -41,6 +41,72 @@
  */
 DS18B20_temperature_out_t ds18b20_convert_temperature_bytes(const uint8_t msb, uint8_t lsb, const DS18B20_resolution_t resolution);
 
+/**
+ * @brief Converts temperature bytes received from scratchpad of DS18B20 for specified resolution into raw temperature value.
+ * 
+ * Undefined bits for specified resolution are cleared. No floating point operations are performed.
+ * 
+ * @param msb The most significant byte of temperature
+ * @param lsb The least significant byte of temperature
+ * @param resolution Resolution set on the device during convertion
+ * @return DS18B20_temperature_raw_t Temperature in 1/16 Celsius
+ */
+DS18B20_temperature_raw_t ds18b20_convert_temperature_bytes_raw(const uint8_t msb, uint8_t lsb, const DS18B20_resolution_t resolution);
+
+/**
+ * @brief Converts raw temperature value into human-readable result.
+ * 
+ * @param raw Temperature in 1/16 Celsius
+ * @return DS18B20_temperature_out_t Human-readable temperature
+ */
+DS18B20_temperature_out_t ds18b20_convert_temperature_raw(const DS18B20_temperature_raw_t raw);
+
+/**
+ * @brief Converts raw temperature value into thousandths of Celsius.
+ * 
+ * Uses integer arithmetic only. Results of 12-bit resolution ending with half of thousandth are rounded toward zero.
+ * 
+ * @param raw Temperature in 1/16 Celsius
+ * @return DS18B20_temperature_milli_t Temperature in 1/1000 Celsius
+ */
+DS18B20_temperature_milli_t ds18b20_convert_temperature_raw_to_milli(const DS18B20_temperature_raw_t raw);
+
+/**
+ * @brief Converts temperature bytes of many devices into human-readable results in a single pass.
+ * 
+ * Input is given in structure-of-arrays form. The loop is branch-free, so the compiler is able to vectorize it.
+ * 
+ * @param msbs Array of the most significant bytes of temperatures
+ * @param lsbs Array of the least significant bytes of temperatures
+ * @param resolutions Array of resolutions set on the devices during convertion
+ * @param temperaturesOut Array where human-readable temperatures will be saved eventually
+ * @param temperaturesNo Number of temperatures to convert
+ */
+void ds18b20_convert_temperatures_bytes(const uint8_t * const msbs, const uint8_t * const lsbs, const DS18B20_resolution_t * const resolutions, 
+                                            DS18B20_temperature_out_t * const temperaturesOut, const size_t temperaturesNo);
+
+/**
+ * @brief Converts many raw temperature values (e.g. replayed from logs) into human-readable results in a single pass.
+ * 
+ * Undefined bits for specified resolutions are ignored. The loop is branch-free, so the compiler is able to vectorize it.
+ * 
+ * @param raws Array of temperatures in 1/16 Celsius
+ * @param resolutions Array of resolutions set on the devices during convertion
+ * @param temperaturesOut Array where human-readable temperatures will be saved eventually
+ * @param temperaturesNo Number of temperatures to convert
+ */
+void ds18b20_convert_temperatures_raw(const DS18B20_temperature_raw_t * const raws, const DS18B20_resolution_t * const resolutions, 
+                                        DS18B20_temperature_out_t * const temperaturesOut, const size_t temperaturesNo);
+
+/**
+ * @brief Converts temperatures stored in scratchpads of many devices into human-readable results in a single pass.
+ * 
+ * @param devices Array of devices with scratchpads already read
+ * @param temperaturesOut Array where human-readable temperatures (one per each device) will be saved eventually
+ * @param devicesNo Number of devices
+ */
+void ds18b20_convert_temperatures_devices(const DS18B20_t * const devices, DS18B20_temperature_out_t * const temperaturesOut, const size_t devicesNo);
+
 /**
  * @brief Converts user-defined resolution into configuration byte readable for the device.
  * 
@@ -46,6 +46,10 @@ enum DS18B20_error_t
     DS18B20_DISCONNECTED,       /**< Device haven't reply with presence status within given time */
     DS18B20_DEVICE_NOT_FOUND,   /**< Couldn't find the device's ROM address in specified driver instance - it was not initialized properly in this case */
     DS18B20_CRC_FAIL,           /**< CRC validation has failed */
+    DS18B20_NOT_READY,          /**< Requested operation has not been finished by the device yet */
+    DS18B20_VERIFY_FAIL,        /**< Data read back from the device differs from the data written */
+    DS18B20_STORE_FAIL,         /**< Data could not be loaded from or saved into the non-volatile store */
+    DS18B20_QUEUE_FULL,         /**< Request could not be queued, because the queue is full */
 };
 
 #endif /* DS18B20_ERROR_CODES_H */
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_gpio_fast.h
+ * @author Damian Ślusarczyk
+ * @brief Contains One-Wire transport implementation driving GPIO registers of ESP32 directly.
+ * 
+ * Bus is driven like open-drain output - output level of the pin is kept low and the bus is pulled low 
+ * or released by setting or clearing output enable bit. Pin masks and register addresses are precomputed 
+ * once, timeslot code is placed in IRAM and all delays are measured with CPU cycle counter from the 
+ * beginning of the timeslot, so driver calls and their locks do not skew the timings.
+ * The same register access drives many buses in lockstep - whole lane mask is set, cleared or sampled at once.
+ */
+
+#ifndef DS18B20_GPIO_FAST_H
+#define DS18B20_GPIO_FAST_H
+
+#include <stdint.h>
+
+#include "ds18b20_transport.h"
+#include "ds18b20_lockstep.h"
+#include "ds18b20_error_codes.h"
+
+typedef struct DS18B20_gpio_fast_regs_t     DS18B20_gpio_fast_regs_t;
+typedef struct DS18B20_gpio_fast_t          DS18B20_gpio_fast_t;
+
+/**
+ * @brief Describes GPIO registers of the bank containing selected pin.
+ * 
+ * Set (W1TS) and clear (W1TC) registers affect only bits written as 1.
+ */
+struct DS18B20_gpio_fast_regs_t
+{
+    volatile uint32_t                       *enableSet; /**< Output enable set register */
+    volatile uint32_t                       *enableClear; /**< Output enable clear register */
+    volatile uint32_t                       *outSet; /**< Output level set register */
+    volatile uint32_t                       *outClear; /**< Output level clear register */
+    volatile const uint32_t                 *in; /**< Input level register */
+};
+
+/**
+ * @brief Describes GPIO driven by the fast transport.
+ * 
+ * Pointer to this structure need to be passed as transport context of One-Wire bus instance.
+ * @note Structure should be initialized using ds18b20_gpio_fast_init() method.
+ */
+struct DS18B20_gpio_fast_t
+{
+    int                                     bus; /**< Selected GPIO for One-Wire communication (-1 when lanes are driven) */
+    uint32_t                                mask; /**< Mask of the selected GPIO (or all lanes) in its register bank */
+    DS18B20_gpio_fast_regs_t                regs; /**< Registers of the bank containing selected GPIO */
+    uint32_t                                cyclesPerUs; /**< Number of CPU cycles per microsecond */
+    uint32_t                                (*get_cycles)(void); /**< Returns current value of CPU cycle counter */
+};
+
+/**
+ * @brief One-Wire transport driving GPIO registers described in transport context.
+ * 
+ * Timeslots are generated inside critical sections entered by the bus.
+ */
+extern const DS18B20_transport_t ds18b20_gpio_fast_transport;
+
+/**
+ * @brief Precomputes pin mask, register addresses and CPU cycle timings for selected GPIO.
+ * 
+ * @param fast Pointer to fast GPIO transport context to initialize
+ * @param bus Selected GPIO for One-Wire communication (has to be output capable)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_gpio_fast_init(DS18B20_gpio_fast_t * const fast, const int bus);
+
+/**
+ * @brief Lockstep transport driving GPIOs of the first register bank - lane N is GPIO N.
+ * 
+ * Pointer to fast GPIO transport context initialized with ds18b20_gpio_fast_init_lanes() need to be passed as transport context of lockstep instance.
+ */
+extern const DS18B20_lockstep_transport_t ds18b20_gpio_lockstep_transport;
+
+/**
+ * @brief Precomputes register addresses and CPU cycle timings for lanes driven in lockstep.
+ * 
+ * @param fast Pointer to fast GPIO transport context to initialize
+ * @param lanes Mask of GPIOs 0-31 used as lanes (all have to be output capable)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_gpio_fast_init_lanes(DS18B20_gpio_fast_t * const fast, const uint32_t lanes);
+
+#endif /* DS18B20_GPIO_FAST_H */
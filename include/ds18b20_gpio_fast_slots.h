@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_gpio_fast_slots.h
+ * @author Damian Ślusarczyk
+ * @brief Contains timeslot sequencing of the register-level GPIO transports.
+ * 
+ * Timeslots only write and read registers described in fast GPIO transport context and measure delays
+ * with its cycle counter, so they do not depend on ESP-IDF and are verified on the host against mocked registers.
+ * Peripheral setup and the transports using these timeslots are in ds18b20_gpio_fast.c.
+ */
+
+#ifndef DS18B20_GPIO_FAST_SLOTS_H
+#define DS18B20_GPIO_FAST_SLOTS_H
+
+#include <stdint.h>
+
+#include "ds18b20_gpio_fast.h"
+#include "ds18b20_low.h"
+
+/**
+ * @brief Returns fast GPIO transport context assigned to the One-Wire bus instance.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return const DS18B20_gpio_fast_t* Pointer to fast GPIO transport context
+ */
+static inline const DS18B20_gpio_fast_t *ds18b20_gpio_fast_of(const DS18B20_onewire_t * const onewire)
+{
+    return (const DS18B20_gpio_fast_t *) onewire->transportContext;
+}
+
+/**
+ * @brief Returns fast GPIO transport context assigned to the lockstep instance.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return const DS18B20_gpio_fast_t* Pointer to fast GPIO transport context
+ */
+static inline const DS18B20_gpio_fast_t *ds18b20_gpio_lockstep_of(const DS18B20_lockstep_t * const lockstep)
+{
+    return (const DS18B20_gpio_fast_t *) lockstep->transportContext;
+}
+
+/**
+ * @brief Generates reset pulse and samples presence pulse on the bus.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance with fast GPIO transport context
+ * @return uint8_t Presence pulse detected (1) or not (0)
+ */
+uint8_t ds18b20_gpio_fast_reset(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Generates write timeslot of single bit.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance with fast GPIO transport context
+ * @param bit Bit to write
+ */
+void ds18b20_gpio_fast_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit);
+
+/**
+ * @brief Generates read timeslot and samples single bit.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance with fast GPIO transport context
+ * @return uint8_t Read bit
+ */
+uint8_t ds18b20_gpio_fast_read_bit(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Drives the bus high to power parasite devices.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance with fast GPIO transport context
+ */
+void ds18b20_gpio_fast_start_pullup(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Releases the bus driven high.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance with fast GPIO transport context
+ */
+void ds18b20_gpio_fast_end_pullup(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Generates reset pulse on selected lanes and samples their presence pulses.
+ * 
+ * @param lockstep Pointer to lockstep instance with fast GPIO transport context
+ * @param lanes Mask of driven lanes
+ * @return uint32_t Mask of lanes with presence pulse
+ */
+uint32_t ds18b20_gpio_lockstep_reset(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+/**
+ * @brief Generates write timeslot on selected lanes, every lane writes its own bit.
+ * 
+ * @param lockstep Pointer to lockstep instance with fast GPIO transport context
+ * @param lanes Mask of driven lanes
+ * @param bits Mask of lanes writing 1
+ */
+void ds18b20_gpio_lockstep_write_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits);
+
+/**
+ * @brief Generates read timeslot on selected lanes and samples their bits.
+ * 
+ * @param lockstep Pointer to lockstep instance with fast GPIO transport context
+ * @param lanes Mask of driven lanes
+ * @return uint32_t Mask of lanes which read 1
+ */
+uint32_t ds18b20_gpio_lockstep_read_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+/**
+ * @brief Drives selected lanes high to power parasite devices.
+ * 
+ * @param lockstep Pointer to lockstep instance with fast GPIO transport context
+ * @param lanes Mask of driven lanes
+ */
+void ds18b20_gpio_lockstep_start_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+/**
+ * @brief Releases selected lanes driven high.
+ * 
+ * @param lockstep Pointer to lockstep instance with fast GPIO transport context
+ * @param lanes Mask of driven lanes
+ */
+void ds18b20_gpio_lockstep_end_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes);
+
+#endif /* DS18B20_GPIO_FAST_SLOTS_H */
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_lockstep.h
+ * @author Damian Ślusarczyk
+ * @brief Contains functions driving many One-Wire buses in lockstep, bit-parallel.
+ * 
+ * Every bus is a lane - single bit of 32-bit lane mask. Timeslot of every lane is generated at the same time,
+ * lanes are driven with combined mask and sampled with single read of input levels.
+ * Each lane follows its own protocol path (ROM addresses sent with Match ROM, search decisions, received data),
+ * so reset, addressing, scratchpad reading and even search of all buses take about as long as on a single bus.
+ */
+
+#ifndef DS18B20_LOCKSTEP_H
+#define DS18B20_LOCKSTEP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "ds18b20_low.h"
+#include "ds18b20_port.h"
+#include "ds18b20_error_codes.h"
+
+#define DS18B20_LOCKSTEP_MAX_LANES          32 /**< Maximum number of lanes driven in lockstep */
+
+typedef struct DS18B20_lockstep_transport_t DS18B20_lockstep_transport_t;
+typedef struct DS18B20_lockstep_lane_t      DS18B20_lockstep_lane_t;
+typedef struct DS18B20_lockstep_t           DS18B20_lockstep_t;
+
+/**
+ * @brief Describes set of operations implementing physical layer of many One-Wire buses driven in lockstep.
+ * 
+ * Lanes are passed as bit masks - bit N set means that the operation applies to lane N.
+ * Implementation specific data can be accessed through transport context of the lockstep instance.
+ * @note Operations marked as optional can be set to NULL.
+ */
+struct DS18B20_lockstep_transport_t
+{
+    DS18B20_error_t (*init)(const DS18B20_lockstep_t * const lockstep); /**< Prepares all lanes for communication (optional) */
+    uint32_t (*reset)(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes); /**< Sends reset signal, returns mask of lanes with presence signal */
+    void (*write_bits)(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits); /**< Generates write timeslot with bit value of each lane taken from bits mask */
+    uint32_t (*read_bits)(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes); /**< Generates read timeslot and returns mask of lanes sampled high */
+    void (*start_pullup)(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes); /**< Starts strong pullup on the lanes */
+    void (*end_pullup)(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes); /**< Ends strong pullup and releases the lanes */
+    uint32_t (*get_millis)(const DS18B20_lockstep_t * const lockstep); /**< Returns current time (in milliseconds) */
+    void (*delay_ms)(const DS18B20_lockstep_t * const lockstep, const uint32_t delayMs); /**< Waits for the specified time (in milliseconds) */
+};
+
+/**
+ * @brief Describes devices of a single lane.
+ * 
+ * Arrays are provided by the user, lanes with zero capacity are not driven at all.
+ */
+struct DS18B20_lockstep_lane_t
+{
+    DS18B20_rom_t                           *roms; /**< ROM addresses of the devices found on the lane */
+    DS18B20_temperature_raw_t               *temperatures; /**< Temperatures read lately from the devices (in 1/16 Celsius) */
+    size_t                                  capacity; /**< Number of elements in roms and temperatures arrays */
+    size_t                                  devicesNo; /**< Number of devices found on the lane */
+    DS18B20_powermode_t                     powerMode; /**< Parasite if any device of the lane is parasite powered */
+    DS18B20_error_t                         status; /**< Status of the last operation performed on the lane */
+};
+
+/**
+ * @brief Describes lanes driven in lockstep.
+ * 
+ * @note Structure should be initialized using ds18b20__InitLockstep() method.
+ */
+struct DS18B20_lockstep_t
+{
+    const DS18B20_lockstep_transport_t      *transport; /**< Physical layer of all lanes */
+    void                                    *transportContext; /**< Implementation specific data of the transport */
+    DS18B20_lockstep_lane_t                 *lanes; /**< Lanes indexed by their bit number in lane masks */
+    size_t                                  lanesNo; /**< Number of elements in lanes array */
+    uint32_t                                lanesMask; /**< Mask of lanes with non-zero capacity */
+    DS18B20_spinlock_t                      lock; /**< Spinlock guarding timeslots */
+};
+
+/**
+ * @brief Initializes lockstep instance with lanes provided by the user and prepares the transport.
+ * 
+ * @param lockstep Pointer to lockstep instance to initialize
+ * @param transport Physical layer driving all lanes
+ * @param transportContext Implementation specific data of the transport
+ * @param lanes Array of lanes indexed by their bit number (with roms, temperatures and capacity set)
+ * @param lanesNo Number of elements in lanes array (up to DS18B20_LOCKSTEP_MAX_LANES)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitLockstep(DS18B20_lockstep_t * const lockstep, const DS18B20_lockstep_transport_t * const transport, void * const transportContext, 
+    DS18B20_lockstep_lane_t * const lanes, const size_t lanesNo);
+
+/**
+ * @brief Searches all lanes at once and reads power mode of each lane.
+ * 
+ * Every search cycle finds next device on each lane still having undiscovered devices.
+ * Lane status is set to DS18B20_DISCONNECTED if no device replies with presence signal and to DS18B20_INV_CONF if its capacity is too small.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param checksum Specifies if found ROM addresses should be validated with CRC
+ * @return DS18B20_error_t Status code of the operation - status of the first failed lane, if any
+ */
+DS18B20_error_t ds18b20__LockstepDiscover(DS18B20_lockstep_t * const lockstep, const bool checksum);
+
+/**
+ * @brief Requests temperature convertion on all devices of all lanes and waits until it ends.
+ * 
+ * Lanes with externally powered devices only are polled, so the waiting ends as soon as the slowest device is ready.
+ * Parasite powered lanes get strong pullup for the worst-case 12-bit convertion time.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return DS18B20_error_t Status code of the operation - status of the first failed lane, if any
+ */
+DS18B20_error_t ds18b20__LockstepConvert(DS18B20_lockstep_t * const lockstep);
+
+/**
+ * @brief Reads temperatures of all devices of all lanes.
+ * 
+ * Device N of every lane is addressed and read in the same timeslots, so reading takes as long as on the most populated lane.
+ * A failure on a lane does not stop reading of the others, its status is kept in the lane.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param checksum Specifies if whole scratchpad should be read and validated with CRC
+ * @return DS18B20_error_t Status code of the operation - status of the first failed lane, if any
+ */
+DS18B20_error_t ds18b20__LockstepReadTemperaturesRaw(DS18B20_lockstep_t * const lockstep, const bool checksum);
+
+#endif /* DS18B20_LOCKSTEP_H */
@@ -33,16 +33,35 @@
 #include <stdbool.h>
 
 #include "ds18b20_types_req.h"
+#include "ds18b20_types_res.h"
 #include "ds18b20_error_codes.h"
+#include "ds18b20_transport.h"
+#include "ds18b20_port.h"
 
 #define DS18B20_1W_SINGLEDEVICE             1 /**< Means that One-Wire bus is connected to only one device */
 
 #define DS18B20_ROM_SIZE                    8 /**< DS18B20 ROM address size in bytes */
 #define DS18B20_SP_SIZE                     9 /**< DS18B20 scratchpad size in bytes */
+#define DS18B20_SP_REGISTERS_SIZE           3 /**< Number of configurable scratchpad bytes (upper alarm, lower alarm and configuration), also stored in EEPROM */
+
+#define DS18B20_STORAGE_RESOLUTION_MASK     0x03 /**< Bits of packed device flags which store temperature resolution */
+#define DS18B20_STORAGE_POWERMODE_SHIFT     2 /**< Position of packed device flags' bit which stores power mode */
+/** Number of bytes of storage arrays used by a single device */
+#define DS18B20_STORAGE_BYTES_PER_DEVICE    (sizeof(DS18B20_rom_t) + sizeof(DS18B20_temperature_raw_t) + sizeof(uint8_t))
 
 typedef enum    DS18B20_powermode_t         DS18B20_powermode_t;
+typedef enum    DS18B20_critical_t          DS18B20_critical_t;
 typedef struct  DS18B20_onewire_t           DS18B20_onewire_t;
 typedef struct  DS18B20_t                   DS18B20_t;
+typedef struct  DS18B20_search_t            DS18B20_search_t;
+typedef struct  DS18B20_storage_t           DS18B20_storage_t;
+typedef struct  DS18B20_integrity_t         DS18B20_integrity_t;
+typedef struct  DS18B20_integrity_state_t   DS18B20_integrity_state_t;
+typedef struct  DS18B20_timing_state_t      DS18B20_timing_state_t;
+typedef struct  DS18B20_resolution_policy_t DS18B20_resolution_policy_t;
+typedef struct  DS18B20_resolution_state_t  DS18B20_resolution_state_t;
+typedef struct  DS18B20_mirror_t            DS18B20_mirror_t;
+typedef struct  DS18B20_cache_entry_t       DS18B20_cache_entry_t;
 
 typedef uint8_t                             DS18B20_rom_t[DS18B20_ROM_SIZE]; /**< DS18B20 ROM address */
 typedef uint8_t                             DS18B20_scratchpad_t[DS18B20_SP_SIZE]; /**< DS18B20 scratchpad memory */
@@ -58,6 +77,19 @@ enum DS18B20_powermode_t
     DS18B20_PM_COUNT                        /**< Number of available power modes */
 };
 
+/**
+ * @brief Describes scope of critical sections (with disabled interrupts) used while communicating on One-Wire bus.
+ * 
+ * Wider scope means fewer critical sections, but interrupts stay disabled for a longer time.
+ */
+enum DS18B20_critical_t
+{
+    DS18B20_CRITICAL_SLOT = 0,              /**< Every single timeslot (or reset signal) is generated in separate critical section */
+    DS18B20_CRITICAL_BYTE,                  /**< Every byte is transferred in single critical section */
+    DS18B20_CRITICAL_TRANSACTION,           /**< Whole transaction - from reset signal until function command is finished - is performed in single critical section */
+    DS18B20_CRITICAL_COUNT                  /**< Number of available critical section scopes */
+};
+
 /**
  * @brief Describes characteristics of single DS18B20.
  * 
@@ -71,6 +103,108 @@ struct DS18B20_t
     DS18B20_powermode_t                     powerMode; /**< Used power mode */
 };
 
+/**
+ * @brief Describes storage of all devices connected to One-Wire bus kept in separate packed arrays (alternative to array of @ref DS18B20_t).
+ * 
+ * Data used on every operation (ROMs, temperatures, resolutions and power modes) is kept apart, 
+ * so the whole bus can be scanned without walking through scratchpads of all devices.
+ * Scratchpad is shared by all devices, so it is only valid for the device used in the latest operation.
+ * @note Call ds18b20__InitStorage() method to initialize this structure.
+ */
+struct DS18B20_storage_t
+{
+    DS18B20_rom_t                           *roms; /**< ROM addresses of the devices */
+    DS18B20_temperature_raw_t               *temperatures; /**< Temperatures read lately from the devices (in 1/16 Celsius) */
+    uint8_t                                 *flags; /**< Packed resolutions and power modes of the devices */
+    DS18B20_scratchpad_t                    scratchpad; /**< Scratchpad memory of the device used in the latest operation */
+};
+
+/**
+ * @brief Describes limits of plausible temperature readings used by adaptive integrity mode.
+ * 
+ * @note Call ds18b20__InitIntegrityDefault() method to initialize this structure with default values.
+ */
+struct DS18B20_integrity_t
+{
+    DS18B20_temperature_raw_t               minTemperature; /**< The lowest plausible temperature (in 1/16 Celsius) */
+    DS18B20_temperature_raw_t               maxTemperature; /**< The highest plausible temperature (in 1/16 Celsius) */
+    DS18B20_temperature_raw_t               maxChange; /**< The highest plausible change between consecutive readings of the device (in 1/16 Celsius) */
+    uint8_t                                 escalationReads; /**< Number of full CRC-verified reads of the device after any anomaly */
+};
+
+/**
+ * @brief Describes state of adaptive integrity mode of a single device.
+ * 
+ */
+struct DS18B20_integrity_state_t
+{
+    DS18B20_temperature_raw_t               lastTemperature; /**< The last accepted temperature (in 1/16 Celsius) */
+    uint8_t                                 fullReadsLeft; /**< Number of full CRC-verified reads left before short reads are used again */
+};
+
+/**
+ * @brief Describes learned temperature convertion time of a single device (or all devices converting at once).
+ * 
+ * Times are normalized to 12-bit resolution, lower resolutions take proportionally less.
+ */
+struct DS18B20_timing_state_t
+{
+    uint32_t                                meanUs; /**< Running average of measured convertion times (in microseconds) */
+    uint32_t                                deviationUs; /**< Running average of deviations from meanUs (in microseconds) */
+    uint16_t                                samples; /**< Number of measurements taken so far (saturates at its maximum value) */
+};
+
+/**
+ * @brief Describes targets of adaptive resolution mode.
+ * 
+ * @note Call ds18b20__InitResolutionPolicyDefault() method to initialize this structure with default values.
+ */
+struct DS18B20_resolution_policy_t
+{
+    DS18B20_resolution_t                    minResolution; /**< The lowest resolution allowed (precision target) */
+    uint16_t                                maxConvertionMs; /**< The longest convertion time allowed (latency target, in milliseconds) */
+    uint8_t                                 stepsPerChange; /**< Number of resolution steps which change of temperature between readings should span */
+    uint8_t                                 settleReadings; /**< Number of consecutive readings calling for higher resolution before it is raised */
+};
+
+/**
+ * @brief Describes state of adaptive resolution mode of a single device.
+ * 
+ */
+struct DS18B20_resolution_state_t
+{
+    DS18B20_temperature_raw_t               lastTemperature; /**< The last reading (in 1/16 Celsius) */
+    int16_t                                 trend; /**< Running average of change between consecutive readings (in 1/256 Celsius) */
+    uint16_t                                noise; /**< Running average of deviation of change from the trend (in 1/256 Celsius) */
+    DS18B20_resolution_t                    resolution; /**< Resolution chosen for the next convertion */
+    uint8_t                                 settledReadings; /**< Number of consecutive readings calling for higher resolution */
+    bool                                    started; /**< Indicates if any reading has been tracked yet */
+};
+
+/**
+ * @brief Describes configurable registers of a single device known to the driver, used to avoid redundant writes.
+ * 
+ * Each copy is valid only if its generation equals the current generation of One-Wire bus instance.
+ */
+struct DS18B20_mirror_t
+{
+    uint8_t                                 registers[DS18B20_SP_REGISTERS_SIZE]; /**< Upper alarm, lower alarm and configuration registers read back lately from scratchpad */
+    uint8_t                                 eeprom[DS18B20_SP_REGISTERS_SIZE]; /**< Upper alarm, lower alarm and configuration registers known to be stored in EEPROM */
+    uint32_t                                registersGeneration; /**< Generation of the bus when registers have been read back */
+    uint32_t                                eepromGeneration; /**< Generation of the bus when EEPROM content has been learned */
+};
+
+/**
+ * @brief Describes the last temperature read from a single device together with the time it has been captured.
+ * 
+ */
+struct DS18B20_cache_entry_t
+{
+    DS18B20_temperature_raw_t               temperature; /**< Temperature read lately (in 1/16 Celsius) */
+    uint32_t                                capturedMs; /**< Time when the temperature has been read (in milliseconds) */
+    bool                                    valid; /**< Indicates if any temperature has been cached yet */
+};
+
 /**
  * @brief Describes characteristics of One-Wire bus, containing access to single or multiple DS18B20.
  * 
@@ -79,13 +213,51 @@ struct DS18B20_t
 struct DS18B20_onewire_t
 {
     int                                     bus; /**< Selected GPIO for One-Wire communication */
+    const DS18B20_transport_t               *transport; /**< Physical layer used for One-Wire communication */
+    void                                    *transportContext; /**< Data specific for the used transport implementation */
     DS18B20_t                               *devices; /**< Devices connected to the bus */
+    DS18B20_storage_t                       *storage; /**< Packed storage of devices connected to the bus (used instead of devices if set) */
     size_t                                  devicesNo; /**< Number of connected devices */
+    size_t                                  busDevicesNo; /**< Number of all devices connected to the bus (including the ones not handled by this instance) */
+    bool                                    busParasite; /**< Indicates if any device connected to the bus (including the ones not handled by this instance) is powered parasitically */
 
     size_t                                  lastSearchedDeviceNumber; /**< Number (not index) of the last found device during search procedure */
     int8_t                                  lastSearchConflictUnresolved; /**< Bit index of the last unresolved conflict in connected devices' ROMs */
     int8_t                                  lastSearchConflict; /**< Bit index of the last resolved conflict in connected devices' ROMs */
     bool                                    alarmSearchMode; /**< Indicates which search mode has been chosen lately */
+    DS18B20_rom_t                           lastSearchedRom; /**< ROM address found in the last search cycle */
+
+    size_t                                  *romIndex; /**< Hash table mapping ROM addresses to device indices (optional) */
+    size_t                                  romIndexSize; /**< Number of slots in ROM index */
+
+    DS18B20_integrity_t                     integrity; /**< Limits of plausible temperature readings */
+    DS18B20_integrity_state_t               *integrityStates; /**< States of adaptive integrity mode (one per each device, optional) */
+
+    DS18B20_timing_state_t                  *timingStates; /**< Learned convertion times (one per each device and one for all devices, optional) */
+    uint16_t                                timingMarginMs; /**< Safety margin added to learned convertion times (in milliseconds) */
+
+    DS18B20_resolution_policy_t             resolutionPolicy; /**< Targets of adaptive resolution mode */
+    DS18B20_resolution_state_t              *resolutionStates; /**< States of adaptive resolution mode (one per each device, optional) */
+
+    DS18B20_mirror_t                        *mirrors; /**< Known configurable registers of devices used to avoid redundant writes (one per each device, optional) */
+    uint32_t                                mirrorGeneration; /**< Current generation of mirrors, older ones are stale */
+
+    DS18B20_cache_entry_t                   *cache; /**< Temperatures read lately with their capture times (one per each device, optional) */
+
+    DS18B20_spinlock_t                      lock; /**< Spinlock guarding critical sections of the bus */
+    DS18B20_critical_t                      critical; /**< Scope of critical sections */
+};
+
+/**
+ * @brief Describes state of search procedure traversing the bus independently of One-Wire bus instance.
+ * 
+ * @note Call ds18b20_search_start() method to initialize this structure.
+ */
+struct DS18B20_search_t
+{
+    DS18B20_rom_t                           rom; /**< ROM address found in the last search cycle */
+    int8_t                                  lastConflict; /**< Bit index of the last conflict resolved by choosing bit 0 */
+    bool                                    finished; /**< Indicates if all devices have been found */
 };
 
 /* Basic functions */
@@ -93,7 +265,7 @@ struct DS18B20_onewire_t
 /**
  * @brief Writes single bit on the One-Wire bus.
  * 
- * Interrupts are disabled while this operation is performed. 
+ * Interrupts are disabled while this operation is performed (unless it is already part of wider critical section). 
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
  * @param bit Bit value to be written on the bus, any value other than 0 is treated as 1
@@ -103,7 +275,7 @@ void ds18b20_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bi
 /**
  * @brief Writes single byte (8 bits) on the One-Wire bus.
  * 
- * Interrupts are disabled while single bit is written.
+ * Interrupts are disabled while single bit or whole byte is written, depending on scope of critical sections.
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
  * @param byte Full value to be written on the bus, least significant bits first
@@ -113,7 +285,7 @@ void ds18b20_write_byte(const DS18B20_onewire_t * const onewire, const uint8_t b
 /**
  * @brief Reads single bit from the One-Wire bus.
  * 
- * Interrupts are disabled while this operation is performed. 
+ * Interrupts are disabled while this operation is performed (unless it is already part of wider critical section). 
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
  * @return uint8_t Value read from the bus - 0 or 1
@@ -123,7 +295,7 @@ uint8_t ds18b20_read_bit(const DS18B20_onewire_t * const onewire);
 /**
  * @brief Reads single byte (8 bits) from the One-Wire bus.
  * 
- * Interrupts are disabled while single bit is read.
+ * Interrupts are disabled while single bit or whole byte is read, depending on scope of critical sections.
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
  * @return uint8_t Full value read from the bus
@@ -134,7 +306,7 @@ uint8_t ds18b20_read_byte(const DS18B20_onewire_t * const onewire);
  * @brief Sends reset signal to all devices connected to One-Wire bus.
  * 
  * Initializes data exchange communication with the present devices.
- * Interrupts are disabled while this operation is performed.
+ * Interrupts are disabled while this operation is performed (unless it is already part of wider critical section).
  * Any alive device should respond with the 'presence' signal.
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
@@ -162,6 +334,8 @@ void ds18b20_parasite_end_pullup(const DS18B20_onewire_t * const onewire);
  * @brief Performs one cycle of the device or alarm searching procedure.
  * 
  * Found ROM address is saved in specified buffer or in the next One-Wire device characteristics internal buffer if it was not defined by the user. 
+ * Buffer is cleared before searching. ROM address found in the previous cycle is remembered in One-Wire bus instance, 
+ * so the buffers can be reused or skipped by the caller.
  * In alarm search mode, buffer need to be always specified by the user, otherwise the function will not be executed properly.
  * Search parameters are reset automatically when all search cycles have been performed or search mode has been changed.
  * @note Before the first use ds18b20_restart_search() call is required to initialize the internal search parameters.
@@ -173,6 +347,32 @@ void ds18b20_parasite_end_pullup(const DS18B20_onewire_t * const onewire);
  */
 DS18B20_error_t ds18b20_search_rom(DS18B20_onewire_t * const onewire, DS18B20_rom_t * buffer, const bool alarmSearchMode);
 
+/**
+ * @brief Performs one cycle of the device or alarm searching procedure continuing the given traversal.
+ * 
+ * Unlike ds18b20_search_rom(), all search parameters are kept in the given search state, 
+ * so the whole bus can be traversed without modifying One-Wire bus instance.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param search Pointer to search state (found ROM address is saved in it)
+ * @param alarmSearchMode Specifies search mode - 1 means searching for alarms, 0 means searching for devices
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_search_next(const DS18B20_onewire_t * const onewire, DS18B20_search_t * const search, const bool alarmSearchMode);
+
+/**
+ * @brief Checks if the device with given ROM address is connected to the bus by performing single search cycle along its address.
+ * 
+ * It takes fixed number of timeslots (reset, command and 64 x 3 search slots) whether the device is present or not,
+ * and no device needs to be selected or read, so missing devices cause neither timeouts nor CRC failures.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param rom ROM address of the device to look for
+ * @param presentOut Pointer to variable where presence of the device will be saved eventually
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_verify_rom(const DS18B20_onewire_t * const onewire, const DS18B20_rom_t rom, bool * const presentOut);
+
 /**
  * @brief Performs reading of the device's ROM address and saving it in device characteristics internal buffer.
  * 
@@ -208,6 +408,18 @@ DS18B20_error_t ds18b20_select(const DS18B20_onewire_t * const onewire, const si
  */
 DS18B20_error_t ds18b20_skip_select(const DS18B20_onewire_t * const onewire);
 
+/**
+ * @brief Addresses all devices connected to the One-Wire bus at once by sending Skip ROM command code.
+ * 
+ * This method can be used regardless of the number of devices connected to the bus,
+ * but only with functional commands which do not return any data, like converting temperature.
+ * Otherwise bit signals from many devices could overlap causing unreliable results.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_skip_select_all(const DS18B20_onewire_t * const onewire);
+
 /* Function commands */
 
 /**
@@ -223,6 +435,18 @@ DS18B20_error_t ds18b20_skip_select(const DS18B20_onewire_t * const onewire);
  */
 DS18B20_error_t ds18b20_convert_temperature(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
+/**
+ * @brief Sends a request for converting temperature to all DS18B20 connected to One-Wire bus.
+ * 
+ * If any of connected devices is working in a parasite power mode, strong pullup will be enabled. 
+ * In this specific case all interrupts are disabled while performing the operation.
+ * @note Before calling this you need to address all devices by using ds18b20_skip_select_all() method.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_convert_temperature_all(const DS18B20_onewire_t * const onewire);
+
 /**
  * @brief Writes the scratchpad of the selected DS18B20.
  * 
@@ -235,6 +459,18 @@ DS18B20_error_t ds18b20_convert_temperature(const DS18B20_onewire_t * const onew
  */
 DS18B20_error_t ds18b20_write_scratchpad(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
+/**
+ * @brief Writes the scratchpad of all DS18B20 connected to One-Wire bus with the same values.
+ * 
+ * Only configurable bytes of given scratchpad will be written to the memory of devices.
+ * @note Before calling this you need to address all devices by using ds18b20_skip_select_all() method.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param scratchpad Scratchpad memory containing configurable bytes to write
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_write_scratchpad_all(const DS18B20_onewire_t * const onewire, const DS18B20_scratchpad_t scratchpad);
+
 /**
  * @brief Reads the all scratchpad memory from the selected DS18B20.
  * 
@@ -262,6 +498,19 @@ DS18B20_error_t ds18b20_read_scratchpad(const DS18B20_onewire_t * const onewire,
  */
 DS18B20_error_t ds18b20_read_scratchpad_with_stop(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, uint8_t bytesToRead);
 
+/**
+ * @brief Reads the all scratchpad memory from the selected DS18B20 validating it with CRC checksum on the fly.
+ * 
+ * All bytes from device memory will be read and stored in the internal buffer of chosen DS18B20 characteristics instance.
+ * CRC checksum is updated as each byte arrives, so the validation result is known as soon as the last (CRC) byte has been read.
+ * @note Before calling this you need to select device by using one of these methods ds18b20_select() or ds18b20_skip_select().
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the chosen device from One-Wire bus
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_read_scratchpad_with_crc(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
 /**
  * @brief Sends a request for copying scratchpad into non-volatile EEPROM memory of the selected DS18B20.
  * 
@@ -276,10 +525,23 @@ DS18B20_error_t ds18b20_read_scratchpad_with_stop(const DS18B20_onewire_t * cons
  */
 DS18B20_error_t ds18b20_copy_scratchpad(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
+/**
+ * @brief Sends a request for copying scratchpad into non-volatile EEPROM memory of all DS18B20 connected to One-Wire bus.
+ * 
+ * If any of connected devices is working in a parasite power mode, strong pullup will be enabled. 
+ * In this specific case all interrupts are disabled while performing the operation.
+ * @note Before calling this you need to address all devices by using ds18b20_skip_select_all() method.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_copy_scratchpad_all(const DS18B20_onewire_t * const onewire);
+
 /**
  * @brief Sends a request for recalling scratchpad from non-volatile EEPROM memory of the selected DS18B20.
  * 
  * Only configurable bytes stored in device EEPROM memory will be recalled.
+ * All devices can be requested at once after addressing them with ds18b20_skip_select_all() method.
  * @note Before calling this you need to select device by using one of these methods ds18b20_select() or ds18b20_skip_select().
  * 
  * @param onewire Pointer to specified One-Wire bus characteristics instance
@@ -298,8 +560,28 @@ DS18B20_error_t ds18b20_recall_e2(const DS18B20_onewire_t * const onewire);
  */
 DS18B20_error_t ds18b20_read_powermode(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
 
+/**
+ * @brief Reads the used power mode of all DS18B20 devices connected to One-Wire bus at once.
+ * 
+ * Parasite mode is reported if at least one of the devices is parasite powered, otherwise external supply is reported.
+ * @note Before calling this you need to address all devices by using ds18b20_skip_select_all() method.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param powerModeOut Pointer to the combined power mode of the bus
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_read_powermode_all(const DS18B20_onewire_t * const onewire, DS18B20_powermode_t * const powerModeOut);
+
 /* Helpers */
 
+/**
+ * @brief Initializes search state to start new traversal of the bus.
+ * 
+ * @param search Pointer to search state
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20_search_start(DS18B20_search_t * const search);
+
 /**
  * @brief Restarts the search procedure by resetting values of the internal search parameters.
  * 
@@ -319,4 +601,104 @@ DS18B20_error_t ds18b20_restart_search(DS18B20_onewire_t * const onewire, const
  */
 uint16_t ds18b20_millis_to_wait_for_convertion(const DS18B20_resolution_t resolution);
 
+/**
+ * @brief Returns the current time used to schedule operations performed on One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return uint32_t Current time (in milliseconds), wrapping around on overflow
+ */
+uint32_t ds18b20_get_millis(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Suspends the calling task for the specified time while waiting for the devices connected to One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param delayMs Time to wait (in milliseconds)
+ */
+void ds18b20_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs);
+
+/**
+ * @brief Checks if any of the devices connected to One-Wire bus is working in a parasite power mode.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return true At least one device is powered parasitically
+ * @return false All devices are powered by an external supply
+ */
+bool ds18b20_any_parasite(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Checks if any device connected to One-Wire bus, including the ones not handled by this instance, is working in a parasite power mode.
+ * 
+ * Used by commands broadcast to the whole bus, which are performed by all connected devices.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return true At least one device on the bus is powered parasitically
+ * @return false All devices on the bus are powered by an external supply
+ */
+bool ds18b20_bus_parasite(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Returns the highest temperature convertion resolution among all devices connected to One-Wire bus.
+ * 
+ * Temperature convertion on the whole bus lasts as long as the convertion of the device using this resolution.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @return DS18B20_resolution_t The highest resolution used on the bus
+ */
+DS18B20_resolution_t ds18b20_max_resolution(const DS18B20_onewire_t * const onewire);
+
+/**
+ * @brief Returns ROM address of the device from storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return uint8_t* ROM address of the device
+ */
+uint8_t *ds18b20_device_rom(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Returns scratchpad memory of the device from storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return uint8_t* Scratchpad memory of the device (shared by all devices if packed storage is used)
+ */
+uint8_t *ds18b20_device_scratchpad(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Returns temperature resolution of the device from storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return DS18B20_resolution_t Temperature resolution of the device
+ */
+DS18B20_resolution_t ds18b20_device_resolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Sets temperature resolution of the device in storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param resolution Temperature resolution of the device
+ */
+void ds18b20_device_set_resolution(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_resolution_t resolution);
+
+/**
+ * @brief Returns power mode of the device from storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @return DS18B20_powermode_t Power mode of the device
+ */
+DS18B20_powermode_t ds18b20_device_powermode(const DS18B20_onewire_t * const onewire, const size_t deviceIndex);
+
+/**
+ * @brief Sets power mode of the device in storage used by One-Wire bus.
+ * 
+ * @param onewire Pointer to specified One-Wire bus characteristics instance
+ * @param deviceIndex Index of the selected device
+ * @param powerMode Power mode of the device
+ */
+void ds18b20_device_set_powermode(const DS18B20_onewire_t * const onewire, const size_t deviceIndex, const DS18B20_powermode_t powerMode);
+
 #endif /* DS18B20_LOW_H */
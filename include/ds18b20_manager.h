@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_manager.h
+ * @author Damian Ślusarczyk
+ * @brief Contains functions acquiring temperatures from many One-Wire buses at once.
+ * 
+ * Convertions are started on all buses together, so the samples are time-aligned,
+ * and each bus is read as soon as its convertion ends while the others are still converting.
+ * The whole sweep takes about one convertion time plus reading time of all buses, instead of one convertion time per bus.
+ */
+
+#ifndef DS18B20_MANAGER_H
+#define DS18B20_MANAGER_H
+
+#include "ds18b20.h"
+
+typedef struct DS18B20_manager_t DS18B20_manager_t;
+
+/**
+ * @brief Describes set of One-Wire buses acquired together.
+ * 
+ * @note Structure should be initialized using ds18b20__InitManager() method.
+ */
+struct DS18B20_manager_t
+{
+    const DS18B20_onewire_t * const     *buses; /**< Initialized One-Wire buses */
+    DS18B20_convertion_t                *convertions; /**< Convertions of the current sweep (one per each bus) */
+    DS18B20_error_t                     *statuses; /**< Statuses of the last sweep (one per each bus) */
+    size_t                              busesNo; /**< Number of buses */
+    size_t                              devicesNo; /**< Number of devices on all buses */
+};
+
+/**
+ * @brief Initializes manager of the given buses with arrays provided by the user.
+ * 
+ * All buses need to use the same time source, because time of the first bus is used for scheduling.
+ * 
+ * @param manager Pointer to manager instance to initialize
+ * @param buses Array of One-Wire buses initialized with any of ds18b20__InitOneWire*() or ds18b20__DiscoverOneWire*() methods
+ * @param busesNo Number of elements in buses array
+ * @param convertions Array for convertions (one per each bus)
+ * @param statuses Array for statuses of the last sweep (one per each bus)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitManager(DS18B20_manager_t * const manager, const DS18B20_onewire_t * const * const buses, const size_t busesNo, 
+    DS18B20_convertion_t * const convertions, DS18B20_error_t * const statuses);
+
+/**
+ * @brief Requests temperature convertion on all buses at once and reads the results of each bus as soon as it is ready.
+ * 
+ * Results are consolidated bus after bus - readings of the first bus come first, in the order of its devices.
+ * Failure of a single bus does not stop the sweep of the others, its status is kept in statuses array of the manager.
+ * 
+ * @param manager Pointer to manager instance
+ * @param temperaturesOut Array where temperatures of all devices will be saved eventually (one element per each device on all buses)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation - status of the first failed bus, if any
+ */
+DS18B20_error_t ds18b20__SweepTemperaturesC(DS18B20_manager_t * const manager, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Requests temperature convertion on all buses at once and reads the raw results of each bus as soon as it is ready.
+ * 
+ * Works the same way as ds18b20__SweepTemperaturesC().
+ * 
+ * @param manager Pointer to manager instance
+ * @param temperaturesOut Array where raw temperatures of all devices will be saved eventually (one element per each device on all buses)
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation - status of the first failed bus, if any
+ */
+DS18B20_error_t ds18b20__SweepTemperaturesRaw(DS18B20_manager_t * const manager, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum);
+
+#endif /* DS18B20_MANAGER_H */
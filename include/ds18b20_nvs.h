@@ -0,0 +1,42 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_nvs.h
+ * @author Damian Ślusarczyk
+ * @brief Contains topology store implementation keeping the blob in NVS partition of ESP32.
+ * 
+ */
+
+#ifndef DS18B20_NVS_H
+#define DS18B20_NVS_H
+
+#include "ds18b20_topology.h"
+
+#define DS18B20_NVS_TOPOLOGY_KEY    "ds18b20_topo" /**< NVS key of topology blob */
+
+/**
+ * @brief Topology store keeping the blob in NVS namespace given as store context (null-terminated string).
+ * 
+ * @note NVS flash has to be initialized with nvs_flash_init() before the store is used.
+ */
+extern const DS18B20_topology_store_t ds18b20_nvs_topology_store;
+
+#endif /* DS18B20_NVS_H */
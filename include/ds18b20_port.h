@@ -0,0 +1,514 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_port.h
+ * @author Damian Ślusarczyk
+ * @brief Contains platform specific synchronization primitives used by One-Wire bus.
+ * 
+ * On ESP-IDF critical sections are FreeRTOS spinlocks, which disable interrupts on the calling core
+ * and exclude the other core only when it tries to enter the same spinlock. Other platforms (e.g. host
+ * machine running the simulated bus) get POSIX mutexes, which additionally count critical section usage.
+ * Spinlocks remember their owner (core or thread), so nested operations can check if they are guarded already.
+ * Threads used by the bus worker are FreeRTOS tasks pinned to the selected core woken up with task notifications,
+ * on other platforms they are POSIX threads woken up with semaphores.
+ * Mutexes guarding shared buses inherit priority of the waiting tasks on both.
+ * Millisecond delays used by hardware transports always block the calling thread instead of spinning the CPU.
+ */
+
+#ifndef DS18B20_PORT_H
+#define DS18B20_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DS18B20_PORT_NO_OWNER               (-1)    /**< Owner of spinlock which is not taken */
+
+#ifdef ESP_PLATFORM
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+typedef struct DS18B20_spinlock_t           DS18B20_spinlock_t;
+typedef TaskHandle_t                        DS18B20_notify_t; /**< Target of notifications - task waiting for them */
+typedef struct DS18B20_thread_t             DS18B20_thread_t;
+typedef struct DS18B20_mutex_t              DS18B20_mutex_t;
+
+/**
+ * @brief Describes spinlock guarding critical sections of One-Wire bus.
+ * 
+ * Critical section disables preemption on the calling core, so the core is enough to identify the owner.
+ */
+struct DS18B20_spinlock_t
+{
+    portMUX_TYPE                            mux; /**< FreeRTOS spinlock */
+    volatile int32_t                        owner; /**< Core holding the spinlock (written only while it is held) */
+};
+
+/**
+ * @brief Describes thread of execution with its own notification target.
+ * 
+ */
+struct DS18B20_thread_t
+{
+    TaskHandle_t                            task; /**< Task running the thread */
+    SemaphoreHandle_t                       exited; /**< Semaphore given when the thread finishes */
+    StaticSemaphore_t                       exitedBuffer; /**< Memory of exited semaphore */
+};
+
+/**
+ * @brief Describes mutex with priority inheritance.
+ * 
+ */
+struct DS18B20_mutex_t
+{
+    SemaphoreHandle_t                       handle; /**< FreeRTOS mutex */
+    StaticSemaphore_t                       buffer; /**< Memory of the mutex */
+};
+
+/**
+ * @brief Initializes spinlock in unlocked state.
+ * 
+ * @param lock Pointer to spinlock instance
+ */
+static inline void ds18b20_port_spinlock_init(DS18B20_spinlock_t * const lock)
+{
+    portMUX_INITIALIZE(&lock->mux);
+    lock->owner = DS18B20_PORT_NO_OWNER;
+}
+
+/**
+ * @brief Disables interrupts on the calling core and takes the spinlock.
+ * 
+ * @param lock Pointer to spinlock instance, it must not be held by the caller already
+ */
+static inline void ds18b20_port_enter_critical(DS18B20_spinlock_t * const lock)
+{
+    taskENTER_CRITICAL(&lock->mux);
+    lock->owner = xPortGetCoreID();
+}
+
+/**
+ * @brief Releases the spinlock and enables back interrupts on the calling core.
+ * 
+ * @param lock Pointer to spinlock instance held by the caller
+ */
+static inline void ds18b20_port_exit_critical(DS18B20_spinlock_t * const lock)
+{
+    lock->owner = DS18B20_PORT_NO_OWNER;
+    taskEXIT_CRITICAL(&lock->mux);
+}
+
+/**
+ * @brief Checks if the spinlock is held by the caller.
+ * 
+ * Owner can only be set to the calling core by the caller itself, so the check is safe without taking the spinlock.
+ * 
+ * @param lock Pointer to spinlock instance
+ * @return true Caller is in critical section of the spinlock
+ * @return false Spinlock is free or held by the other core
+ */
+static inline bool ds18b20_port_holds_critical(const DS18B20_spinlock_t * const lock)
+{
+    return xPortGetCoreID() == lock->owner;
+}
+
+/**
+ * @brief Starts the thread running specified function.
+ * 
+ * @param thread Pointer to thread instance to start
+ * @param entry Function run by the thread, it has to call ds18b20_port_thread_exit() at the end
+ * @param arg Argument passed into the function
+ * @param core Core the thread is pinned to (negative value means any core)
+ * @param priority Priority of the thread
+ * @param stackSize Stack size of the thread (in bytes)
+ * @return true Thread has been started
+ * @return false Thread could not be created
+ */
+static inline bool ds18b20_port_thread_start(DS18B20_thread_t * const thread, void (*entry)(void *), void * const arg, 
+    const int core, const uint32_t priority, const uint32_t stackSize)
+{
+    thread->exited = xSemaphoreCreateBinaryStatic(&thread->exitedBuffer);
+    return pdPASS == xTaskCreatePinnedToCore(entry, "ds18b20", stackSize, arg, priority, &thread->task, core < 0 ? tskNO_AFFINITY : core);
+}
+
+/**
+ * @brief Returns notification target of the thread.
+ * 
+ * @param thread Pointer to started thread instance
+ * @return DS18B20_notify_t Notification target
+ */
+static inline DS18B20_notify_t ds18b20_port_thread_target(DS18B20_thread_t * const thread)
+{
+    return thread->task;
+}
+
+/**
+ * @brief Finishes the calling thread, called by the thread itself at the end of its function.
+ * 
+ * @param thread Pointer to thread instance
+ */
+static inline void ds18b20_port_thread_exit(DS18B20_thread_t * const thread)
+{
+    xSemaphoreGive(thread->exited);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Waits until the thread finishes.
+ * 
+ * @param thread Pointer to thread instance
+ */
+static inline void ds18b20_port_thread_join(DS18B20_thread_t * const thread)
+{
+    xSemaphoreTake(thread->exited, portMAX_DELAY);
+}
+
+/**
+ * @brief Sends notification to the target, notifications sent before the target waits for them are not lost.
+ * 
+ * @param target Notification target
+ */
+static inline void ds18b20_port_notify(const DS18B20_notify_t target)
+{
+    xTaskNotifyGive(target);
+}
+
+/**
+ * @brief Blocks the calling thread until it gets notification.
+ * 
+ * @param self Notification target of the calling thread
+ */
+static inline void ds18b20_port_wait_notification(const DS18B20_notify_t self)
+{
+    (void) self;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+/**
+ * @brief Initializes mutex in unlocked state.
+ * 
+ * @param mutex Pointer to mutex instance
+ * @return true Mutex has been initialized
+ * @return false Mutex could not be created
+ */
+static inline bool ds18b20_port_mutex_init(DS18B20_mutex_t * const mutex)
+{
+    mutex->handle = xSemaphoreCreateMutexStatic(&mutex->buffer);
+    return NULL != mutex->handle;
+}
+
+/**
+ * @brief Blocks until the mutex is taken, task holding it inherits priority of the caller meanwhile.
+ * 
+ * @param mutex Pointer to mutex instance
+ */
+static inline void ds18b20_port_mutex_lock(DS18B20_mutex_t * const mutex)
+{
+    xSemaphoreTake(mutex->handle, portMAX_DELAY);
+}
+
+/**
+ * @brief Releases the mutex taken by the caller.
+ * 
+ * @param mutex Pointer to mutex instance
+ */
+static inline void ds18b20_port_mutex_unlock(DS18B20_mutex_t * const mutex)
+{
+    xSemaphoreGive(mutex->handle);
+}
+
+/**
+ * @brief Returns time since boot measured by ESP timer, not quantized to FreeRTOS ticks.
+ * 
+ * @return uint32_t Current time (in milliseconds)
+ */
+static inline uint32_t ds18b20_port_millis(void)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+/**
+ * @brief Suspends the calling task for at least specified time.
+ * 
+ * Delay is rounded up to whole ticks, so delays shorter than a tick still yield the CPU. The first tick
+ * of vTaskDelay() may be partial, hence the task sleeps again until ESP timer confirms the delay has passed,
+ * which matters when it ends strong pullup.
+ * 
+ * @param delayMs Time to wait (in milliseconds)
+ */
+static inline void ds18b20_port_sleep_ms(const uint32_t delayMs)
+{
+    const int64_t tickUs = (int64_t) portTICK_PERIOD_MS * 1000;
+    const int64_t endUs = esp_timer_get_time() + (int64_t) delayMs * 1000;
+    for (int64_t remainingUs = (int64_t) delayMs * 1000; remainingUs > 0; remainingUs = endUs - esp_timer_get_time())
+    {
+        vTaskDelay((remainingUs + tickUs - 1) / tickUs);
+    }
+}
+
+#else
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <time.h>
+
+typedef struct DS18B20_spinlock_t           DS18B20_spinlock_t;
+typedef sem_t                               *DS18B20_notify_t; /**< Target of notifications - semaphore of thread waiting for them */
+typedef struct DS18B20_thread_t             DS18B20_thread_t;
+typedef pthread_mutex_t                     DS18B20_mutex_t; /**< POSIX mutex with priority inheritance protocol */
+
+/**
+ * @brief Describes spinlock emulated with POSIX mutex, recording its usage.
+ * 
+ */
+struct DS18B20_spinlock_t
+{
+    pthread_mutex_t                         mutex; /**< Mutex excluding threads */
+    atomic_uintptr_t                        owner; /**< Thread holding the spinlock (written only while it is held) */
+    uint32_t                                depth; /**< Current nesting depth of critical sections */
+    uint32_t                                maxDepth; /**< Maximum nesting depth reached */
+    uint32_t                                enters; /**< Number of entered critical sections */
+};
+
+/**
+ * @brief Describes POSIX thread with its own notification semaphore.
+ * 
+ */
+struct DS18B20_thread_t
+{
+    pthread_t                               thread; /**< Thread handle */
+    sem_t                                   wakeup; /**< Semaphore counting notifications */
+    void                                    (*entry)(void *); /**< Function run by the thread */
+    void                                    *arg; /**< Argument passed into the function */
+};
+
+/**
+ * @brief Initializes spinlock in unlocked state and clears its usage statistics.
+ * 
+ * @param lock Pointer to spinlock instance
+ */
+static inline void ds18b20_port_spinlock_init(DS18B20_spinlock_t * const lock)
+{
+    pthread_mutex_init(&lock->mutex, NULL);
+    atomic_init(&lock->owner, (uintptr_t) DS18B20_PORT_NO_OWNER);
+    lock->depth = 0;
+    lock->maxDepth = 0;
+    lock->enters = 0;
+}
+
+/**
+ * @brief Takes the mutex of the spinlock and records entered critical section.
+ * 
+ * @param lock Pointer to spinlock instance, it must not be held by the caller already
+ */
+static inline void ds18b20_port_enter_critical(DS18B20_spinlock_t * const lock)
+{
+    pthread_mutex_lock(&lock->mutex);
+    atomic_store_explicit(&lock->owner, (uintptr_t) pthread_self(), memory_order_relaxed);
+    ++lock->enters;
+    if (++lock->depth > lock->maxDepth)
+    {
+        lock->maxDepth = lock->depth;
+    }
+}
+
+/**
+ * @brief Releases the mutex of the spinlock held by the caller.
+ * 
+ * @param lock Pointer to spinlock instance held by the caller
+ */
+static inline void ds18b20_port_exit_critical(DS18B20_spinlock_t * const lock)
+{
+    --lock->depth;
+    atomic_store_explicit(&lock->owner, (uintptr_t) DS18B20_PORT_NO_OWNER, memory_order_relaxed);
+    pthread_mutex_unlock(&lock->mutex);
+}
+
+/**
+ * @brief Checks if the spinlock is held by the calling thread.
+ * 
+ * Owner can only be set to the calling thread by the caller itself, so the check is safe without taking the mutex.
+ * 
+ * @param lock Pointer to spinlock instance
+ * @return true Caller is in critical section of the spinlock
+ * @return false Spinlock is free or held by other thread
+ */
+static inline bool ds18b20_port_holds_critical(const DS18B20_spinlock_t * const lock)
+{
+    return (uintptr_t) pthread_self() == atomic_load_explicit(&lock->owner, memory_order_relaxed);
+}
+
+/**
+ * @brief Runs function of the thread, entry point of POSIX thread.
+ * 
+ * @param thread Pointer to thread instance
+ * @return void* Always NULL
+ */
+static inline void *ds18b20_port_thread_run(void * const thread)
+{
+    ((DS18B20_thread_t *) thread)->entry(((DS18B20_thread_t *) thread)->arg);
+    return NULL;
+}
+
+/**
+ * @brief Starts the thread running specified function.
+ * 
+ * @param thread Pointer to thread instance to start
+ * @param entry Function run by the thread, it has to call ds18b20_port_thread_exit() at the end
+ * @param arg Argument passed into the function
+ * @param core Ignored on the host
+ * @param priority Ignored on the host
+ * @param stackSize Ignored on the host
+ * @return true Thread has been started
+ * @return false Thread could not be created
+ */
+static inline bool ds18b20_port_thread_start(DS18B20_thread_t * const thread, void (*entry)(void *), void * const arg, 
+    const int core, const uint32_t priority, const uint32_t stackSize)
+{
+    // Core, priority and stack size are left to the host scheduler
+    (void) core;
+    (void) priority;
+    (void) stackSize;
+    thread->entry = entry;
+    thread->arg = arg;
+    return 0 == sem_init(&thread->wakeup, 0, 0) && 0 == pthread_create(&thread->thread, NULL, ds18b20_port_thread_run, thread);
+}
+
+/**
+ * @brief Returns notification target of the thread.
+ * 
+ * @param thread Pointer to started thread instance
+ * @return DS18B20_notify_t Notification target
+ */
+static inline DS18B20_notify_t ds18b20_port_thread_target(DS18B20_thread_t * const thread)
+{
+    return &thread->wakeup;
+}
+
+/**
+ * @brief Finishes the calling thread, called by the thread itself at the end of its function.
+ * 
+ * POSIX thread finishes by returning from its function, so nothing needs to be done here.
+ * 
+ * @param thread Pointer to thread instance
+ */
+static inline void ds18b20_port_thread_exit(DS18B20_thread_t * const thread)
+{
+    (void) thread;
+}
+
+/**
+ * @brief Waits until the thread finishes and releases its semaphore.
+ * 
+ * @param thread Pointer to thread instance
+ */
+static inline void ds18b20_port_thread_join(DS18B20_thread_t * const thread)
+{
+    pthread_join(thread->thread, NULL);
+    sem_destroy(&thread->wakeup);
+}
+
+/**
+ * @brief Sends notification to the target, notifications sent before the target waits for them are not lost.
+ * 
+ * @param target Notification target
+ */
+static inline void ds18b20_port_notify(const DS18B20_notify_t target)
+{
+    sem_post(target);
+}
+
+/**
+ * @brief Blocks the calling thread until it gets notification, waiting again when interrupted by signal.
+ * 
+ * @param self Notification target of the calling thread
+ */
+static inline void ds18b20_port_wait_notification(const DS18B20_notify_t self)
+{
+    while (0 != sem_wait(self));
+}
+
+/**
+ * @brief Initializes mutex with priority inheritance protocol in unlocked state.
+ * 
+ * @param mutex Pointer to mutex instance
+ * @return true Mutex has been initialized
+ * @return false Mutex could not be created
+ */
+static inline bool ds18b20_port_mutex_init(DS18B20_mutex_t * const mutex)
+{
+    pthread_mutexattr_t attributes;
+    bool initialized = 0 == pthread_mutexattr_init(&attributes)
+        && 0 == pthread_mutexattr_setprotocol(&attributes, PTHREAD_PRIO_INHERIT)
+        && 0 == pthread_mutex_init(mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    return initialized;
+}
+
+/**
+ * @brief Blocks until the mutex is taken, thread holding it inherits priority of the caller meanwhile.
+ * 
+ * @param mutex Pointer to mutex instance
+ */
+static inline void ds18b20_port_mutex_lock(DS18B20_mutex_t * const mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+/**
+ * @brief Releases the mutex taken by the caller.
+ * 
+ * @param mutex Pointer to mutex instance
+ */
+static inline void ds18b20_port_mutex_unlock(DS18B20_mutex_t * const mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+/**
+ * @brief Returns monotonic time since unspecified moment.
+ * 
+ * @return uint32_t Current time (in milliseconds)
+ */
+static inline uint32_t ds18b20_port_millis(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Suspends the calling thread for at least specified time, sleeping again when interrupted by signal.
+ * 
+ * @param delayMs Time to wait (in milliseconds)
+ */
+static inline void ds18b20_port_sleep_ms(const uint32_t delayMs)
+{
+    struct timespec remaining = { .tv_sec = delayMs / 1000, .tv_nsec = (long) (delayMs % 1000) * 1000000 };
+    while (0 != nanosleep(&remaining, &remaining));
+}
+
+#endif /* ESP_PLATFORM */
+
+#endif /* DS18B20_PORT_H */
@@ -37,6 +37,10 @@
 #define DS18B20_SP_CONFIG_BYTE              4 /**< Memory byte index for the device configuration */
 #define DS18B20_SP_CRC_BYTE                 8 /**< Memory byte index for the scratchpad CRC */
 
+#define DS18B20_SP_CONFIG_RESERVED_MASK     0x9F /**< Bits of the device configuration which are not used by resolution */
+#define DS18B20_SP_CONFIG_RESERVED_VALUE    0x1F /**< Fixed value of the device configuration bits which are not used by resolution */
+
+#define DS18B20_SP_TEMP_DEFAULT_VALUE       0x0550 /**< Power-on reset value for the measured temperature (85 Celsius) */
 #define DS18B20_SP_TEMP_HIGH_DEFAULT_VALUE  0x55 /**< Power-on reset value for the upper temperature alarm */
 #define DS18B20_SP_TEMP_LOW_DEFAULT_VALUE   0x00 /**< Power-on reset value for the lower temperature alarm */
 #define DS18B20_SP_CONFIG_DEFAULT_VALUE     0x7F /**< Power-on reset value for the device configuration */
@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_shared.h
+ * @author Damian Ślusarczyk
+ * @brief Contains thread-safe access to One-Wire bus shared by many tasks.
+ * 
+ * Bus is guarded by a mutex with priority inheritance. Temperature requests coalesce - a request for the device 
+ * (or the whole bus) arriving while convertion covering it is already in progress waits for that convertion
+ * and receives its result, instead of starting another one right after. Request verifying CRC checksum
+ * is served only with reading which has verified it too.
+ */
+
+#ifndef DS18B20_SHARED_H
+#define DS18B20_SHARED_H
+
+#include <stdatomic.h>
+
+#include "ds18b20.h"
+#include "ds18b20_port.h"
+
+typedef struct DS18B20_shared_reading_t     DS18B20_shared_reading_t;
+typedef struct DS18B20_shared_t             DS18B20_shared_t;
+
+/**
+ * @brief Describes the last reading of single device of shared bus.
+ * 
+ */
+struct DS18B20_shared_reading_t
+{
+    atomic_uint                             generation; /**< Number of finished readings of the device */
+    DS18B20_error_t                         status; /**< Status code of the last reading */
+    bool                                    checksum; /**< Indicates if CRC checksum has been verified by the last reading */
+};
+
+/**
+ * @brief Describes One-Wire bus shared by many tasks.
+ * 
+ * @note Structure should be initialized using ds18b20__InitSharedBus() method.
+ */
+struct DS18B20_shared_t
+{
+    const DS18B20_onewire_t                 *onewire; /**< Shared bus, it must not be used without holding the lock */
+    DS18B20_shared_reading_t                *readings; /**< The last readings (one per each device) */
+    DS18B20_temperature_raw_t               *temperatures; /**< The last temperatures (one per each device, in 1/16 Celsius) */
+    atomic_uint                             generation; /**< Number of finished readings of the whole bus */
+    DS18B20_error_t                         status; /**< Status code of the last reading of the whole bus */
+    bool                                    checksum; /**< Indicates if CRC checksum has been verified by the last reading of the whole bus */
+    uint32_t                                convertions; /**< Number of convertions issued on the bus (single device or all devices) */
+    DS18B20_mutex_t                         mutex; /**< Lock of the bus */
+};
+
+/**
+ * @brief Initializes shared bus with arrays provided by the user.
+ * 
+ * @param shared Pointer to shared bus instance to initialize
+ * @param onewire Initialized One-Wire bus
+ * @param readings Array for the last readings (one per each device)
+ * @param temperatures Array for the last temperatures (one per each device)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitSharedBus(DS18B20_shared_t * const shared, const DS18B20_onewire_t * const onewire, 
+    DS18B20_shared_reading_t * const readings, DS18B20_temperature_raw_t * const temperatures);
+
+/**
+ * @brief Takes the lock of the bus, so any other driver function can be called on it exclusively.
+ * 
+ * @param shared Pointer to shared bus instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__LockSharedBus(DS18B20_shared_t * const shared);
+
+/**
+ * @brief Releases the lock of the bus taken with ds18b20__LockSharedBus().
+ * 
+ * @param shared Pointer to shared bus instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__UnlockSharedBus(DS18B20_shared_t * const shared);
+
+/**
+ * @brief Reads temperature of the device (in Celsius), sharing convertion with concurrent requests.
+ * 
+ * Works the same way as ds18b20__SharedGetTemperatureRaw().
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SharedGetTemperatureC(DS18B20_shared_t * const shared, const size_t deviceIndex, DS18B20_temperature_out_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Reads temperature of the device as raw value (in 1/16 Celsius), sharing convertion with concurrent requests.
+ * 
+ * If the device has been read (alone or with the whole bus) since this request arrived, at least as strictly 
+ * as requested (with CRC checksum verified if checksum is set), result of that reading is returned,
+ * otherwise the device is read with ds18b20__GetTemperatureRaw().
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param deviceIndex Index of the selected device
+ * @param temperatureOut Pointer to variable where received temperature will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SharedGetTemperatureRaw(DS18B20_shared_t * const shared, const size_t deviceIndex, DS18B20_temperature_raw_t * const temperatureOut, const bool checksum);
+
+/**
+ * @brief Reads temperatures of all devices (in Celsius), sharing convertion with concurrent requests.
+ * 
+ * Works the same way as ds18b20__SharedGetTemperaturesRaw().
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SharedGetTemperaturesC(DS18B20_shared_t * const shared, DS18B20_temperature_out_t * const temperaturesOut, const bool checksum);
+
+/**
+ * @brief Reads temperatures of all devices as raw values (in 1/16 Celsius), sharing convertion with concurrent requests.
+ * 
+ * If the whole bus has been read since this request arrived, at least as strictly as requested (with CRC checksum verified 
+ * if checksum is set), result of that reading is returned, otherwise the bus is read with ds18b20__GetTemperaturesRaw() 
+ * and the result is shared with pending requests for single devices too.
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param temperaturesOut Array of variables (one per each device) where received temperatures will be saved eventually
+ * @param checksum Specifies if CRC checksum should be calculated during all performed operations
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__SharedGetTemperaturesRaw(DS18B20_shared_t * const shared, DS18B20_temperature_raw_t * const temperaturesOut, const bool checksum);
+
+#endif /* DS18B20_SHARED_H */
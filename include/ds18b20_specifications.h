@@ -34,6 +34,9 @@
 #define DS18B20_RESOLUTION_11_DELAY_MS          375 /**< Maximum temperature convertion waiting time for resolution 11 (ms) */
 #define DS18B20_RESOLUTION_12_DELAY_MS          750 /**< Maximum temperature convertion waiting time for resolution 12 (ms) */
 
+#define DS18B20_TEMPERATURE_MIN_RAW             (-55 * 16)  /**< The lowest temperature measured by the device (1/16 Celsius) */
+#define DS18B20_TEMPERATURE_MAX_RAW             (125 * 16)  /**< The highest temperature measured by the device (1/16 Celsius) */
+
 #define DS18B20_EEPROM_RESTORE_DELAY_MS         10  /**< Maximum time required for restoring memory from EEPROM (ms) */
 #define DS18B20_SCRATCHPAD_COPY_DELAY_MS        10  /**< Maximum time required for copying memory into EEPROM (ms) */
 #define DS18B20_SCRATCHPAD_COPY_MIN_PULLUP_MS   10  /**< Minimum pull-up time during memory copying in parasite power mode (ms)*/
@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_topology.h
+ * @author Damian Ślusarczyk
+ * @brief Contains interface of the non-volatile store used to keep topology of One-Wire bus between restarts.
+ * 
+ * Topology (ROM addresses, power modes and resolutions of all devices) is exported as a single versioned blob.
+ * Store only needs to keep the blob as a whole, e.g. in NVS partition on the target or in a file on the host.
+ */
+
+#ifndef DS18B20_TOPOLOGY_H
+#define DS18B20_TOPOLOGY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "ds18b20_error_codes.h"
+
+#define DS18B20_TOPOLOGY_MAGIC              0xB2 /**< First byte of every topology blob */
+#define DS18B20_TOPOLOGY_VERSION            1 /**< Version of topology blob layout, blobs of other versions are ignored */
+#define DS18B20_TOPOLOGY_HEADER_SIZE        4 /**< Size of blob header in bytes (magic, version and 16-bit number of devices) */
+#define DS18B20_TOPOLOGY_RECORD_SIZE        9 /**< Size of single device record in bytes (ROM address and packed flags) */
+/** Size of topology blob in bytes for given number of devices (header, records and CRC) */
+#define DS18B20_TOPOLOGY_SIZE(devicesNo)    (DS18B20_TOPOLOGY_HEADER_SIZE + (devicesNo) * DS18B20_TOPOLOGY_RECORD_SIZE + 1)
+
+typedef struct DS18B20_topology_store_t     DS18B20_topology_store_t;
+typedef struct DS18B20_topology_t           DS18B20_topology_t;
+
+/**
+ * @brief Describes set of operations implementing non-volatile store of topology blob.
+ * 
+ * Every operation receives store context given during initialization of the topology.
+ */
+struct DS18B20_topology_store_t
+{
+    DS18B20_error_t (*load)(void * const context, uint8_t * const blob, const size_t capacity, size_t * const sizeOut); /**< Loads the last saved blob, fails if there is none */
+    DS18B20_error_t (*save)(void * const context, const uint8_t * const blob, const size_t size); /**< Saves the blob, replacing the previous one */
+};
+
+/**
+ * @brief Describes cached topology of One-Wire bus used for warm start.
+ * 
+ * @note Structure should be initialized using ds18b20__InitTopology() method.
+ */
+struct DS18B20_topology_t
+{
+    const DS18B20_topology_store_t      *store; /**< Store keeping the blob between restarts */
+    void                                *storeContext; /**< Data specific for the used store implementation */
+    uint8_t                             *blob; /**< Buffer for the blob, see @ref DS18B20_TOPOLOGY_SIZE */
+    size_t                              blobSize; /**< Size of the buffer in bytes */
+    bool                                warm; /**< Indicates if the last initialization has been performed using cached topology */
+};
+
+#endif /* DS18B20_TOPOLOGY_H */
@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_transport.h
+ * @author Damian Ślusarczyk
+ * @brief Contains interface of the physical layer used to communicate with DS18B20 using One-Wire protocol.
+ * 
+ * Transport implements generation of single timeslots and timing services for the One-Wire bus.
+ * Critical sections are not managed by the transport - they are entered by the bus according to its scope.
+ * All protocol logic is built on top of it, so the driver can work with any implementation, 
+ * e.g. bit-banging GPIO or simulated bus.
+ */
+
+#ifndef DS18B20_TRANSPORT_H
+#define DS18B20_TRANSPORT_H
+
+#include <stdint.h>
+
+#include "ds18b20_error_codes.h"
+
+struct DS18B20_onewire_t;
+
+typedef struct DS18B20_transport_t          DS18B20_transport_t;
+
+/**
+ * @brief Describes set of operations implementing physical layer of One-Wire bus.
+ * 
+ * Every operation receives One-Wire bus characteristics instance it is called for. 
+ * Implementation specific data can be accessed through its transport context.
+ * @note Operations marked as optional can be set to NULL.
+ */
+struct DS18B20_transport_t
+{
+    DS18B20_error_t (*init)(const struct DS18B20_onewire_t * const onewire); /**< Prepares the bus for communication (optional) */
+    uint8_t (*reset)(const struct DS18B20_onewire_t * const onewire); /**< Sends reset signal, returns 1 if any device replied with presence signal */
+    void (*write_bit)(const struct DS18B20_onewire_t * const onewire, const uint8_t bit); /**< Generates write timeslot for the given bit value */
+    uint8_t (*read_bit)(const struct DS18B20_onewire_t * const onewire); /**< Generates read timeslot and returns the sampled bit value */
+    void (*start_pullup)(const struct DS18B20_onewire_t * const onewire); /**< Starts strong pullup on the bus */
+    void (*end_pullup)(const struct DS18B20_onewire_t * const onewire); /**< Ends strong pullup and releases the bus */
+    uint32_t (*get_millis)(const struct DS18B20_onewire_t * const onewire); /**< Returns current time (in milliseconds) */
+    void (*delay_ms)(const struct DS18B20_onewire_t * const onewire, const uint32_t delayMs); /**< Waits for the specified time (in milliseconds) */
+};
+
+#endif /* DS18B20_TRANSPORT_H */
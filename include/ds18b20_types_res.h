@@ -28,7 +28,13 @@
 #ifndef DS18B20_TYPES_RES_H
 #define DS18B20_TYPES_RES_H
 
+#include <stdint.h>
+
 /** Temperature measured by the device */
 typedef float DS18B20_temperature_out_t;
+/** Temperature measured by the device as stored in its scratchpad (in 1/16 Celsius) */
+typedef int16_t DS18B20_temperature_raw_t;
+/** Temperature measured by the device in fixed-point format (in 1/1000 Celsius) */
+typedef int32_t DS18B20_temperature_milli_t;
 
 #endif /* DS18B20_TYPES_RES_H */
@@ -34,14 +34,41 @@
 #include "ds18b20_error_codes.h"
 
 #define DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB  0x8C   /**< CRC polynomial used by DS18B20 with the most significant bit discarded */
+#define DS18B20_CRC8_INIT_VALUE              0x00   /**< Initial value of CRC checksum before any data byte has been processed */
 
 #define DS18B20_ROM_SIZE_TO_VALIDATE         7      /**< Number of ROM bytes to validate using CRC algorithm */
 #define DS18B20_SP_SIZE_TO_VALIDATE          8      /**< Number of scrachpad bytes to validate using CRC algorithm */
 
+// By default CRC checksum is calculated using 256-entry look-up table (256 bytes of flash memory).
+// Define DS18B20_CRC8_NIBBLE_TABLE to use two 16-entry look-up tables instead (32 bytes of flash memory),
+// which requires one more table access per each processed byte.
+
+/**
+ * @brief Updates CRC checksum with the next data byte.
+ * 
+ * Allows to calculate CRC checksum incrementally, e.g. while data bytes are being received from the One-Wire line.
+ * Checksum calculation should be started with @ref DS18B20_CRC8_INIT_VALUE.
+ * When all data bytes followed by their received CRC value have been processed, the result is equal to 0 if data is valid.
+ * 
+ * @param crc Current value of CRC checksum
+ * @param byte Next data byte to be processed
+ * @return uint8_t Updated value of CRC checksum
+ */
+uint8_t ds18b20_crc8_update(const uint8_t crc, const uint8_t byte);
+
+/**
+ * @brief Calculates CRC checksum of the data bytes using the polynomial of DS18B20.
+ * 
+ * @param data Pointer to data bytes
+ * @param dataSize Size of the data
+ * @return uint8_t Calculated CRC checksum
+ */
+uint8_t ds18b20_crc8(const uint8_t * const data, const size_t dataSize);
+
 /**
  * @brief Validates the data bytes using CRC checksum algorithm.
  * 
- * After copying the given data, CRC checksum is calculated for the given polynomial.
+ * CRC checksum is calculated for the given polynomial without copying or modifying the data.
  * If the evaluated result is equal to the given value then the validation is successful.
  * 
  * @param data Pointer to data bytes to be validated
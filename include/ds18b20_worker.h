@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_worker.h
+ * @author Damian Ślusarczyk
+ * @brief Contains worker owning One-Wire buses and performing requests queued by other tasks.
+ * 
+ * Worker runs in its own thread (pinned to the selected core on ESP-IDF), so interrupts disabled during timeslots
+ * and busy-waiting delays affect only that core, while other tasks just queue their requests and continue.
+ * Requests are passed through lock-free bounded ring, which can be fed by many producers at once,
+ * and their completions are delivered with callbacks and notifications.
+ */
+
+#ifndef DS18B20_WORKER_H
+#define DS18B20_WORKER_H
+
+#include <stdatomic.h>
+
+#include "ds18b20.h"
+#include "ds18b20_port.h"
+
+#define DS18B20_WORKER_CORE_ANY             -1      /**< Worker is not pinned to any core */
+#define DS18B20_WORKER_PRIORITY_DEFAULT     5       /**< Default priority of the worker thread */
+#define DS18B20_WORKER_STACK_SIZE_DEFAULT   4096    /**< Default stack size of the worker thread (bytes) */
+
+typedef enum DS18B20_request_type_t         DS18B20_request_type_t;
+typedef struct DS18B20_request_t            DS18B20_request_t;
+typedef struct DS18B20_worker_slot_t        DS18B20_worker_slot_t;
+typedef struct DS18B20_worker_config_t      DS18B20_worker_config_t;
+typedef struct DS18B20_worker_t             DS18B20_worker_t;
+
+/**
+ * @brief Called by the worker when the request is completed.
+ * 
+ * Runs in the worker thread, so it should return quickly.
+ */
+typedef void (*DS18B20_request_callback_t)(DS18B20_request_t * const request, void * const context);
+
+/**
+ * @brief Enumerates operations which can be requested from the worker.
+ * 
+ */
+enum DS18B20_request_type_t
+{
+    DS18B20_REQUEST_CONVERT = 0,            /**< Temperature convertion on all devices of the bus (ds18b20__RequestTemperaturesC()) */
+    DS18B20_REQUEST_READ,                   /**< Reading of the current temperatures of all devices (ds18b20__GetTemperaturesRaw()) */
+    DS18B20_REQUEST_CONFIGURE,              /**< Configuration of single device (ds18b20__Configure()) */
+    DS18B20_REQUEST_SEARCH,                 /**< Alarm search of all devices (ds18b20__FindAllAlarms()) */
+    DS18B20_REQUEST_COUNT                   /**< Number of request types */
+};
+
+/**
+ * @brief Describes single request performed by the worker.
+ * 
+ * Request is owned by the caller and needs to stay valid until it is completed.
+ * Only the fields used by the request type need to be set.
+ */
+struct DS18B20_request_t
+{
+    DS18B20_request_type_t                  type; /**< Requested operation */
+    size_t                                  busIndex; /**< Index of the bus owned by the worker */
+    size_t                                  deviceIndex; /**< Index of the device (configure) */
+    const DS18B20_config_t                  *config; /**< Configuration to write (configure) */
+    DS18B20_temperature_raw_t               *temperaturesOut; /**< Array for temperatures of all devices of the bus (read) */
+    uint32_t                                *alarmsOut; /**< Bitmap of alarming devices of the bus (search) */
+    size_t                                  *alarmsNoOut; /**< Number of alarming devices (search, optional) */
+    bool                                    checksum; /**< Specifies if CRC checksum should be calculated */
+
+    DS18B20_request_callback_t              callback; /**< Called on completion (optional) */
+    void                                    *callbackContext; /**< Passed into the callback */
+    DS18B20_notify_t                        notify; /**< Notified on completion, e.g. task waiting for the result (optional) */
+
+    DS18B20_error_t                         status; /**< Status code of the performed operation, valid after completion */
+    atomic_bool                             done; /**< Set on completion */
+};
+
+/**
+ * @brief Describes single slot of the request ring.
+ * 
+ * Sequence number of the slot tells whether it is free for the producer or filled for the worker in the current lap.
+ */
+struct DS18B20_worker_slot_t
+{
+    atomic_size_t                           sequence; /**< Sequence number of the slot */
+    DS18B20_request_t                       *request; /**< Queued request */
+};
+
+/**
+ * @brief Describes thread options of the worker.
+ * 
+ * @note Structure can be initialized with default values using ds18b20__InitWorkerConfigDefault() method.
+ */
+struct DS18B20_worker_config_t
+{
+    int                                     core; /**< Core the worker is pinned to (or DS18B20_WORKER_CORE_ANY) */
+    uint32_t                                priority; /**< Priority of the worker thread */
+    uint32_t                                stackSize; /**< Stack size of the worker thread (in bytes) */
+};
+
+/**
+ * @brief Describes worker with its buses and request ring.
+ * 
+ * @note Structure should be initialized using ds18b20__InitWorker() method.
+ */
+struct DS18B20_worker_t
+{
+    const DS18B20_onewire_t * const         *buses; /**< Buses owned by the worker, they must not be used by other tasks directly */
+    size_t                                  busesNo; /**< Number of buses */
+    DS18B20_worker_slot_t                   *slots; /**< Slots of the request ring */
+    size_t                                  slotsMask; /**< Number of slots minus one */
+    atomic_size_t                           head; /**< Position of the next request to queue */
+    size_t                                  tail; /**< Position of the next request to perform (used by the worker only) */
+    atomic_bool                             started; /**< Indicates if the worker thread is running and can be notified */
+    atomic_bool                             stopping; /**< Indicates if the worker should finish after performing all queued requests */
+    DS18B20_thread_t                        thread; /**< Thread of the worker */
+};
+
+/**
+ * @brief Initializes worker configuration with default values (any core, default priority and stack size).
+ * 
+ * @param config Pointer to configuration instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitWorkerConfigDefault(DS18B20_worker_config_t * const config);
+
+/**
+ * @brief Initializes worker of the given buses with empty request ring provided by the user.
+ * 
+ * Requests can be queued right after initialization (but not concurrently with ds18b20__StartWorker()), 
+ * they are performed once the worker is started.
+ * 
+ * @param worker Pointer to worker instance to initialize
+ * @param buses Array of initialized One-Wire buses handed over to the worker
+ * @param busesNo Number of elements in buses array
+ * @param slots Array of ring slots
+ * @param slotsNo Number of elements in slots array (has to be a power of two)
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__InitWorker(DS18B20_worker_t * const worker, const DS18B20_onewire_t * const * const buses, const size_t busesNo, 
+    DS18B20_worker_slot_t * const slots, const size_t slotsNo);
+
+/**
+ * @brief Starts the worker thread.
+ * 
+ * @param worker Pointer to initialized worker instance
+ * @param config Thread options of the worker
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StartWorker(DS18B20_worker_t * const worker, const DS18B20_worker_config_t * const config);
+
+/**
+ * @brief Performs all queued requests and stops the worker thread.
+ * 
+ * Requests must not be queued while the worker is stopping.
+ * 
+ * @param worker Pointer to started worker instance
+ * @return DS18B20_error_t Status code of the operation
+ */
+DS18B20_error_t ds18b20__StopWorker(DS18B20_worker_t * const worker);
+
+/**
+ * @brief Queues the request without blocking, can be called by many tasks at once.
+ * 
+ * @param worker Pointer to worker instance
+ * @param request Pointer to request with its arguments set
+ * @return DS18B20_error_t Status code of the operation - DS18B20_QUEUE_FULL if there is no free slot in the ring
+ */
+DS18B20_error_t ds18b20__SubmitRequest(DS18B20_worker_t * const worker, DS18B20_request_t * const request);
+
+/**
+ * @brief Checks if the request has been completed, its status and results can be used after that.
+ * 
+ * @param request Pointer to queued request
+ * @return true Request has been completed
+ * @return false Request is still queued or being performed
+ */
+bool ds18b20__IsRequestDone(DS18B20_request_t * const request);
+
+#endif /* DS18B20_WORKER_H */
@@ -0,0 +1,738 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ds18b20_sim.h"
+
+#include <string.h>
+
+#include "ds18b20_commands.h"
+#include "ds18b20_registers.h"
+#include "ds18b20_rom.h"
+#include "ds18b20_timeslots.h"
+#include "ds18b20_specifications.h"
+#include "ds18b20_validator.h"
+#include "ds18b20_converter.h"
+
+#define DS18B20_SIM_SLOT_US             (WRITE_BIT1_DELAY0_US + WRITE_BIT1_DELAY1_US)   /**< Duration of single read or write timeslot (us) */
+#define DS18B20_SIM_RESET_US            (RESET_DELAY0_US + RESET_DELAY1_US + RESET_DELAY2_US) /**< Duration of reset signal (us) */
+#define DS18B20_SIM_COPY_US             (DS18B20_SCRATCHPAD_COPY_DELAY_MS * 1000)      /**< Duration of copying scratchpad into EEPROM (us) */
+#define DS18B20_SIM_ROM_BITS            (DS18B20_ROM_SIZE * 8)  /**< Number of bits in ROM address */
+#define DS18B20_SIM_SP_BITS             (DS18B20_SP_SIZE * 8)   /**< Number of bits in scratchpad memory */
+#define DS18B20_SIM_WRITE_SP_BITS       24                      /**< Number of bits written with Write Scratchpad command */
+#define DS18B20_SIM_CONFIG_MASK         0x60                    /**< Writable bits of configuration register */
+#define DS18B20_SIM_CONFIG_FIXED        0x1F                    /**< Fixed bits of configuration register */
+#define DS18B20_SIM_MAX_RESOLUTION      DS18B20_RESOLUTION_12   /**< Resolution of the nominal convertion time */
+
+/**
+ * @brief Describes states of the protocol state machine of simulated device.
+ * 
+ */
+enum
+{
+    DS18B20_SIM_IDLE = 0,               /**< Device is not participating in communication until the next reset */
+    DS18B20_SIM_ROM_COMMAND,            /**< Device is receiving ROM command */
+    DS18B20_SIM_MATCH_ROM,              /**< Device is comparing received ROM address with its own */
+    DS18B20_SIM_SEARCH_ROM,             /**< Device is taking part in search procedure */
+    DS18B20_SIM_READ_ROM,               /**< Device is sending its ROM address */
+    DS18B20_SIM_FUNCTION_COMMAND,       /**< Device is receiving function command */
+    DS18B20_SIM_WRITE_SCRATCHPAD,       /**< Device is receiving TH, TL and configuration registers */
+    DS18B20_SIM_READ_SCRATCHPAD,        /**< Device is sending its scratchpad memory */
+    DS18B20_SIM_READ_POWER,             /**< Device is sending its power mode */
+    DS18B20_SIM_BUSY                    /**< Device is sending status of the operation performed in the background */
+};
+
+/**
+ * @brief Describes operations performed by simulated device in the background.
+ * 
+ */
+enum
+{
+    DS18B20_SIM_NO_OPERATION = 0,       /**< No operation is performed */
+    DS18B20_SIM_CONVERT,                /**< Temperature convertion */
+    DS18B20_SIM_COPY                    /**< Copying scratchpad into EEPROM */
+};
+
+/** Look-up table for masks of temperature's undefined bits and resolutions */
+static const uint8_t ds18b20_sim_resolution_masks[DS18B20_RESOLUTION_COUNT] =
+{
+    [DS18B20_RESOLUTION_09] 0xF8,
+    [DS18B20_RESOLUTION_10] 0xFC,
+    [DS18B20_RESOLUTION_11] 0xFE,
+    [DS18B20_RESOLUTION_12] 0xFF
+};
+
+/**
+ * @brief Returns simulated bus assigned to the One-Wire bus instance.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @return DS18B20_sim_t* Pointer to simulated bus instance
+ */
+static inline DS18B20_sim_t *ds18b20_sim_of(const DS18B20_onewire_t * const onewire)
+{
+    return (DS18B20_sim_t *) onewire->transportContext;
+}
+
+/**
+ * @brief Returns the next pseudo-random value.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @return uint32_t Pseudo-random value
+ */
+static uint32_t ds18b20_sim_random(DS18B20_sim_t * const sim)
+{
+    sim->seed ^= sim->seed << 13;
+    sim->seed ^= sim->seed >> 17;
+    sim->seed ^= sim->seed << 5;
+    return sim->seed;
+}
+
+/**
+ * @brief Returns value of the selected bit of ROM address.
+ * 
+ * @param device Pointer to simulated device instance
+ * @param bitNo Number of the bit
+ * @return uint8_t Bit value
+ */
+static inline uint8_t ds18b20_sim_rom_bit(const DS18B20_sim_device_t * const device, const uint8_t bitNo)
+{
+    return (device->rom[bitNo / 8] >> (bitNo % 8)) & 1;
+}
+
+/**
+ * @brief Finishes the background operation of the device if its time has passed.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param device Pointer to simulated device instance
+ */
+static void ds18b20_sim_update(DS18B20_sim_t * const sim, DS18B20_sim_device_t * const device)
+{
+    if (DS18B20_SIM_NO_OPERATION == device->operation || sim->clock->nowUs < device->busyUntilUs)
+    {
+        return;
+    }
+
+    if (DS18B20_PM_PARASITE == device->powerMode && !device->pulledUp)
+    {
+        ++sim->stats.parasiteFailures;
+    }
+    else if (DS18B20_SIM_CONVERT == device->operation)
+    {
+        DS18B20_resolution_t resolution = ds18b20_config_byte_to_resolution(device->scratchpad[DS18B20_SP_CONFIG_BYTE]);
+        device->scratchpad[DS18B20_SP_TEMP_LSB_BYTE] = (uint8_t) device->temperature & ds18b20_sim_resolution_masks[resolution];
+        device->scratchpad[DS18B20_SP_TEMP_MSB_BYTE] = (uint8_t) ((uint16_t) device->temperature >> 8);
+
+        int8_t integral = (int8_t) (device->temperature >> 4);
+        device->alarm = integral >= (int8_t) device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE]
+            || integral <= (int8_t) device->scratchpad[DS18B20_SP_TEMP_LOW_BYTE];
+    }
+    else if (DS18B20_SIM_COPY == device->operation)
+    {
+        memcpy(device->eeprom, &device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE], sizeof(device->eeprom));
+        ++sim->stats.eepromWrites;
+    }
+
+    device->operation = DS18B20_SIM_NO_OPERATION;
+}
+
+/**
+ * @brief Breaks background operations of parasite powered devices which have lost strong pullup.
+ * 
+ * @param sim Pointer to simulated bus instance
+ */
+static void ds18b20_sim_release_bus(DS18B20_sim_t * const sim)
+{
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        DS18B20_sim_device_t *device = &sim->devices[i];
+        ds18b20_sim_update(sim, device);
+        if (DS18B20_SIM_NO_OPERATION != device->operation && DS18B20_PM_PARASITE == device->powerMode)
+        {
+            device->operation = DS18B20_SIM_NO_OPERATION;
+            ++sim->stats.parasiteFailures;
+        }
+    }
+    sim->pullup = false;
+}
+
+/**
+ * @brief Generates timeslot on the simulated bus advancing the simulated clock.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param durationUs Duration of the timeslot (in microseconds)
+ */
+static void ds18b20_sim_slot(DS18B20_sim_t * const sim, const uint32_t durationUs)
+{
+    ds18b20_sim_release_bus(sim);
+    sim->clock->nowUs += durationUs;
+    sim->stats.busTimeUs += durationUs;
+
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        ds18b20_sim_update(sim, &sim->devices[i]);
+    }
+}
+
+/**
+ * @brief Starts operation performed by the device in the background.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param device Pointer to simulated device instance
+ * @param operation Operation to perform
+ * @param durationUs Duration of the operation (in microseconds)
+ */
+static void ds18b20_sim_start_operation(DS18B20_sim_t * const sim, DS18B20_sim_device_t * const device, const uint8_t operation, const uint32_t durationUs)
+{
+    device->operation = operation;
+    device->busyUntilUs = sim->clock->nowUs + durationUs;
+    device->pulledUp = false;
+    device->state = DS18B20_SIM_BUSY;
+}
+
+/**
+ * @brief Performs received ROM command.
+ * 
+ * @param device Pointer to simulated device instance
+ * @param command Command code
+ */
+static void ds18b20_sim_rom_command(DS18B20_sim_device_t * const device, const uint8_t command)
+{
+    device->bitNo = 0;
+    device->searchPhase = 0;
+    switch (command)
+    {
+        case DS18B20_MATCH_ROM:
+            device->state = DS18B20_SIM_MATCH_ROM;
+            break;
+        case DS18B20_SKIP_ROM:
+            device->state = DS18B20_SIM_FUNCTION_COMMAND;
+            break;
+        case DS18B20_READ_ROM:
+            device->state = DS18B20_SIM_READ_ROM;
+            break;
+        case DS18B20_SEARCH_ROM:
+            device->state = DS18B20_SIM_SEARCH_ROM;
+            break;
+        case DS18B20_ALARM_SEARCH:
+            device->state = device->alarm ? DS18B20_SIM_SEARCH_ROM : DS18B20_SIM_IDLE;
+            break;
+        default:
+            device->state = DS18B20_SIM_IDLE;
+            break;
+    }
+}
+
+/**
+ * @brief Performs received function command.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param device Pointer to simulated device instance
+ * @param command Command code
+ */
+static void ds18b20_sim_function_command(DS18B20_sim_t * const sim, DS18B20_sim_device_t * const device, const uint8_t command)
+{
+    device->bitNo = 0;
+    switch (command)
+    {
+        case DS18B20_CONVERT_T:
+        {
+            DS18B20_resolution_t resolution = ds18b20_config_byte_to_resolution(device->scratchpad[DS18B20_SP_CONFIG_BYTE]);
+            uint32_t durationUs = device->convertionUs >> (DS18B20_SIM_MAX_RESOLUTION - resolution);
+            if (device->jitterUs)
+            {
+                durationUs += ds18b20_sim_random(sim) % (device->jitterUs + 1);
+            }
+            ds18b20_sim_start_operation(sim, device, DS18B20_SIM_CONVERT, durationUs);
+            ++sim->stats.convertions;
+            break;
+        }
+        case DS18B20_WRITE_SCRATCHPAD:
+            device->state = DS18B20_SIM_WRITE_SCRATCHPAD;
+            break;
+        case DS18B20_READ_SCRATCHPAD:
+            device->scratchpad[DS18B20_SP_CRC_BYTE] = ds18b20_crc8(device->scratchpad, DS18B20_SP_SIZE_TO_VALIDATE);
+            device->state = DS18B20_SIM_READ_SCRATCHPAD;
+            break;
+        case DS18B20_COPY_SCRATCHPAD:
+            ds18b20_sim_start_operation(sim, device, DS18B20_SIM_COPY, DS18B20_SIM_COPY_US);
+            break;
+        case DS18B20_RECALL_E2:
+            memcpy(&device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE], device->eeprom, sizeof(device->eeprom));
+            device->state = DS18B20_SIM_BUSY;
+            break;
+        case DS18B20_READ_POWER_SUPPLY:
+            device->state = DS18B20_SIM_READ_POWER;
+            break;
+        default:
+            device->state = DS18B20_SIM_IDLE;
+            break;
+    }
+}
+
+/**
+ * @brief Processes bit written by the master on the bus.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param device Pointer to simulated device instance
+ * @param bit Written bit value
+ */
+static void ds18b20_sim_write(DS18B20_sim_t * const sim, DS18B20_sim_device_t * const device, const uint8_t bit)
+{
+    switch (device->state)
+    {
+        case DS18B20_SIM_ROM_COMMAND:
+        case DS18B20_SIM_FUNCTION_COMMAND:
+            device->rxByte |= bit << device->bitNo;
+            if (8 == ++device->bitNo)
+            {
+                uint8_t command = device->rxByte;
+                device->rxByte = 0;
+                if (DS18B20_SIM_ROM_COMMAND == device->state)
+                {
+                    ds18b20_sim_rom_command(device, command);
+                }
+                else
+                {
+                    ds18b20_sim_function_command(sim, device, command);
+                }
+            }
+            break;
+        case DS18B20_SIM_MATCH_ROM:
+            if (bit != ds18b20_sim_rom_bit(device, device->bitNo))
+            {
+                device->state = DS18B20_SIM_IDLE;
+            }
+            else if (DS18B20_SIM_ROM_BITS == ++device->bitNo)
+            {
+                device->bitNo = 0;
+                device->state = DS18B20_SIM_FUNCTION_COMMAND;
+            }
+            break;
+        case DS18B20_SIM_SEARCH_ROM:
+            if (2 != device->searchPhase || bit != ds18b20_sim_rom_bit(device, device->bitNo))
+            {
+                device->state = DS18B20_SIM_IDLE;
+            }
+            else if (DS18B20_SIM_ROM_BITS == ++device->bitNo)
+            {
+                device->bitNo = 0;
+                device->state = DS18B20_SIM_FUNCTION_COMMAND;
+            }
+            else
+            {
+                device->searchPhase = 0;
+            }
+            break;
+        case DS18B20_SIM_WRITE_SCRATCHPAD:
+        {
+            uint8_t *reg = &device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE + device->bitNo / 8];
+            uint8_t mask = 1 << (device->bitNo % 8);
+            *reg = bit ? (*reg | mask) : (*reg & ~mask);
+            if (DS18B20_SIM_WRITE_SP_BITS == ++device->bitNo)
+            {
+                device->scratchpad[DS18B20_SP_CONFIG_BYTE] = (device->scratchpad[DS18B20_SP_CONFIG_BYTE] & DS18B20_SIM_CONFIG_MASK) | DS18B20_SIM_CONFIG_FIXED;
+                device->state = DS18B20_SIM_IDLE;
+                ++sim->stats.scratchpadWrites;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Returns bit sent by the device during read timeslot.
+ * 
+ * @param device Pointer to simulated device instance
+ * @return uint8_t Bit value - 0 means the device pulls the bus low
+ */
+static uint8_t ds18b20_sim_read(DS18B20_sim_device_t * const device)
+{
+    uint8_t bit = 1;
+    switch (device->state)
+    {
+        case DS18B20_SIM_SEARCH_ROM:
+            if (2 == device->searchPhase)
+            {
+                break;
+            }
+            bit = ds18b20_sim_rom_bit(device, device->bitNo) ^ device->searchPhase;
+            ++device->searchPhase;
+            break;
+        case DS18B20_SIM_READ_ROM:
+            bit = ds18b20_sim_rom_bit(device, device->bitNo);
+            if (DS18B20_SIM_ROM_BITS == ++device->bitNo)
+            {
+                device->bitNo = 0;
+                device->state = DS18B20_SIM_FUNCTION_COMMAND;
+            }
+            break;
+        case DS18B20_SIM_READ_SCRATCHPAD:
+            if (DS18B20_SIM_SP_BITS > device->bitNo)
+            {
+                bit = (device->scratchpad[device->bitNo / 8] >> (device->bitNo % 8)) & 1;
+                ++device->bitNo;
+            }
+            break;
+        case DS18B20_SIM_READ_POWER:
+            bit = DS18B20_PM_EXTERNAL_SUPPLY == device->powerMode;
+            break;
+        case DS18B20_SIM_BUSY:
+            bit = DS18B20_SIM_NO_OPERATION == device->operation;
+            break;
+        default:
+            break;
+    }
+
+    return bit;
+}
+
+/**
+ * @brief Performs reset signal on the simulated bus, after the timeslot has been generated.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @return uint8_t 1 if any device replied with presence signal, 0 otherwise
+ */
+static uint8_t ds18b20_sim_bus_reset(DS18B20_sim_t * const sim)
+{
+    ++sim->stats.resets;
+
+    uint8_t presence = 0;
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        DS18B20_sim_device_t *device = &sim->devices[i];
+        if (device->present)
+        {
+            device->state = DS18B20_SIM_ROM_COMMAND;
+            device->rxByte = 0;
+            device->bitNo = 0;
+            presence = 1;
+        }
+    }
+
+    return presence;
+}
+
+/**
+ * @brief Passes bit written by the master to all devices, after the timeslot has been generated.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param bit Written bit value
+ */
+static void ds18b20_sim_bus_write(DS18B20_sim_t * const sim, const uint8_t bit)
+{
+    ++sim->stats.writeSlots;
+
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        if (sim->devices[i].present)
+        {
+            ds18b20_sim_write(sim, &sim->devices[i], bit ? 1 : 0);
+        }
+    }
+}
+
+/**
+ * @brief Returns bit sampled by the master, after the timeslot has been generated.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @return uint8_t Sampled bit value
+ */
+static uint8_t ds18b20_sim_bus_read(DS18B20_sim_t * const sim)
+{
+    ++sim->stats.readSlots;
+
+    // Wired-AND - any device pulling the bus low wins
+    uint8_t bit = 1;
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        if (sim->devices[i].present)
+        {
+            bit &= ds18b20_sim_read(&sim->devices[i]);
+        }
+    }
+
+    // Noise can only pull the line low
+    if (sim->readFaultPeriod && bit && 0 == ds18b20_sim_random(sim) % sim->readFaultPeriod)
+    {
+        ++sim->stats.readFaults;
+        bit = 0;
+    }
+
+    return bit;
+}
+
+/**
+ * @brief Provides strong pullup to background operations of all devices.
+ * 
+ * @param sim Pointer to simulated bus instance
+ */
+static void ds18b20_sim_bus_pullup(DS18B20_sim_t * const sim)
+{
+    sim->pullup = true;
+
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        if (DS18B20_SIM_NO_OPERATION != sim->devices[i].operation)
+        {
+            sim->devices[i].pulledUp = true;
+        }
+    }
+}
+
+static uint8_t ds18b20_sim_transport_reset(const DS18B20_onewire_t * const onewire)
+{
+    DS18B20_sim_t *sim = ds18b20_sim_of(onewire);
+    ds18b20_sim_slot(sim, DS18B20_SIM_RESET_US);
+    return ds18b20_sim_bus_reset(sim);
+}
+
+static void ds18b20_sim_transport_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit)
+{
+    DS18B20_sim_t *sim = ds18b20_sim_of(onewire);
+    ds18b20_sim_slot(sim, DS18B20_SIM_SLOT_US);
+    ds18b20_sim_bus_write(sim, bit);
+}
+
+static uint8_t ds18b20_sim_transport_read_bit(const DS18B20_onewire_t * const onewire)
+{
+    DS18B20_sim_t *sim = ds18b20_sim_of(onewire);
+    ds18b20_sim_slot(sim, DS18B20_SIM_SLOT_US);
+    return ds18b20_sim_bus_read(sim);
+}
+
+static void ds18b20_sim_transport_start_pullup(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_sim_bus_pullup(ds18b20_sim_of(onewire));
+}
+
+static void ds18b20_sim_transport_end_pullup(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_sim_release_bus(ds18b20_sim_of(onewire));
+}
+
+static uint32_t ds18b20_sim_transport_get_millis(const DS18B20_onewire_t * const onewire)
+{
+    return (uint32_t) (ds18b20_sim_of(onewire)->clock->nowUs / 1000);
+}
+
+static void ds18b20_sim_transport_delay_ms(const DS18B20_onewire_t * const onewire, const uint32_t delayMs)
+{
+    ds18b20_sim_of(onewire)->clock->nowUs += (uint64_t) delayMs * 1000;
+}
+
+const DS18B20_transport_t ds18b20_sim_transport =
+{
+    .init = NULL,
+    .reset = ds18b20_sim_transport_reset,
+    .write_bit = ds18b20_sim_transport_write_bit,
+    .read_bit = ds18b20_sim_transport_read_bit,
+    .start_pullup = ds18b20_sim_transport_start_pullup,
+    .end_pullup = ds18b20_sim_transport_end_pullup,
+    .get_millis = ds18b20_sim_transport_get_millis,
+    .delay_ms = ds18b20_sim_transport_delay_ms
+};
+
+/**
+ * @brief Returns simulated buses assigned to the lockstep instance.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @return DS18B20_sim_lockstep_t* Pointer to simulated lanes instance
+ */
+static inline DS18B20_sim_lockstep_t *ds18b20_sim_lockstep_of(const DS18B20_lockstep_t * const lockstep)
+{
+    return (DS18B20_sim_lockstep_t *) lockstep->transportContext;
+}
+
+/**
+ * @brief Generates the same timeslot on all given lanes, advancing the shared clock only once.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param lanes Mask of lanes
+ * @param durationUs Duration of the timeslot (in microseconds)
+ */
+static void ds18b20_sim_lockstep_slot(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t durationUs)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane])
+        {
+            ds18b20_sim_release_bus(simLanes->lanes[lane]);
+        }
+    }
+
+    simLanes->clock->nowUs += durationUs;
+
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane])
+        {
+            simLanes->lanes[lane]->stats.busTimeUs += durationUs;
+            ds18b20_sim_sync(simLanes->lanes[lane]);
+        }
+    }
+}
+
+static uint32_t ds18b20_sim_lockstep_reset(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    ds18b20_sim_lockstep_slot(lockstep, lanes, DS18B20_SIM_RESET_US);
+
+    uint32_t presence = 0;
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane] && ds18b20_sim_bus_reset(simLanes->lanes[lane]))
+        {
+            presence |= 1UL << lane;
+        }
+    }
+
+    return presence;
+}
+
+static void ds18b20_sim_lockstep_write_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes, const uint32_t bits)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    ds18b20_sim_lockstep_slot(lockstep, lanes, DS18B20_SIM_SLOT_US);
+
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane])
+        {
+            ds18b20_sim_bus_write(simLanes->lanes[lane], (bits >> lane) & 1);
+        }
+    }
+}
+
+static uint32_t ds18b20_sim_lockstep_read_bits(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    ds18b20_sim_lockstep_slot(lockstep, lanes, DS18B20_SIM_SLOT_US);
+
+    // Lanes without simulated bus are floating high
+    uint32_t bits = lanes;
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane] && !ds18b20_sim_bus_read(simLanes->lanes[lane]))
+        {
+            bits &= ~(1UL << lane);
+        }
+    }
+
+    return bits;
+}
+
+static void ds18b20_sim_lockstep_start_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane])
+        {
+            ds18b20_sim_bus_pullup(simLanes->lanes[lane]);
+        }
+    }
+}
+
+static void ds18b20_sim_lockstep_end_pullup(const DS18B20_lockstep_t * const lockstep, const uint32_t lanes)
+{
+    DS18B20_sim_lockstep_t *simLanes = ds18b20_sim_lockstep_of(lockstep);
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_MAX_LANES; ++lane)
+    {
+        if ((lanes & (1UL << lane)) && simLanes->lanes[lane])
+        {
+            ds18b20_sim_release_bus(simLanes->lanes[lane]);
+        }
+    }
+}
+
+static uint32_t ds18b20_sim_lockstep_get_millis(const DS18B20_lockstep_t * const lockstep)
+{
+    return (uint32_t) (ds18b20_sim_lockstep_of(lockstep)->clock->nowUs / 1000);
+}
+
+static void ds18b20_sim_lockstep_delay_ms(const DS18B20_lockstep_t * const lockstep, const uint32_t delayMs)
+{
+    ds18b20_sim_lockstep_of(lockstep)->clock->nowUs += (uint64_t) delayMs * 1000;
+}
+
+const DS18B20_lockstep_transport_t ds18b20_sim_lockstep_transport =
+{
+    .init = NULL,
+    .reset = ds18b20_sim_lockstep_reset,
+    .write_bits = ds18b20_sim_lockstep_write_bits,
+    .read_bits = ds18b20_sim_lockstep_read_bits,
+    .start_pullup = ds18b20_sim_lockstep_start_pullup,
+    .end_pullup = ds18b20_sim_lockstep_end_pullup,
+    .get_millis = ds18b20_sim_lockstep_get_millis,
+    .delay_ms = ds18b20_sim_lockstep_delay_ms
+};
+
+void ds18b20_sim_init(DS18B20_sim_t * const sim, DS18B20_sim_clock_t * const clock, DS18B20_sim_device_t * const devices, const size_t devicesNo)
+{
+    sim->clock = clock;
+    sim->devices = devices;
+    sim->devicesNo = devicesNo;
+    sim->pullup = false;
+    sim->seed = 1;
+    sim->readFaultPeriod = 0;
+    ds18b20_sim_reset_stats(sim);
+}
+
+void ds18b20_sim_init_device(DS18B20_sim_device_t * const device, const uint64_t serial, const DS18B20_powermode_t powerMode, const int16_t temperature)
+{
+    memset(device, 0, sizeof(*device));
+
+    device->rom[DS18B20_ROM_FAMILY_CODE_BYTE] = DS18B20_SIM_FAMILY_CODE;
+    for (uint8_t i = 1; i < DS18B20_ROM_CRC_BYTE; ++i)
+    {
+        device->rom[i] = (uint8_t) (serial >> (8 * (i - 1)));
+    }
+    device->rom[DS18B20_ROM_CRC_BYTE] = ds18b20_crc8(device->rom, DS18B20_ROM_SIZE_TO_VALIDATE);
+
+    device->scratchpad[DS18B20_SP_TEMP_LSB_BYTE] = (uint8_t) DS18B20_SIM_POWER_ON_TEMPERATURE;
+    device->scratchpad[DS18B20_SP_TEMP_MSB_BYTE] = (uint8_t) (DS18B20_SIM_POWER_ON_TEMPERATURE >> 8);
+    device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE] = DS18B20_SP_TEMP_HIGH_DEFAULT_VALUE;
+    device->scratchpad[DS18B20_SP_TEMP_LOW_BYTE] = DS18B20_SP_TEMP_LOW_DEFAULT_VALUE;
+    device->scratchpad[DS18B20_SP_CONFIG_BYTE] = DS18B20_SP_CONFIG_DEFAULT_VALUE;
+    device->scratchpad[5] = 0xFF;
+    device->scratchpad[6] = 0x0C;
+    device->scratchpad[7] = 0x10;
+    memcpy(device->eeprom, &device->scratchpad[DS18B20_SP_TEMP_HIGH_BYTE], sizeof(device->eeprom));
+
+    device->powerMode = powerMode;
+    device->temperature = temperature;
+    device->convertionUs = DS18B20_SIM_CONVERTION_US;
+    device->present = true;
+}
+
+void ds18b20_sim_reset_stats(DS18B20_sim_t * const sim)
+{
+    memset(&sim->stats, 0, sizeof(sim->stats));
+}
+
+void ds18b20_sim_sync(DS18B20_sim_t * const sim)
+{
+    for (size_t i = 0; i < sim->devicesNo; ++i)
+    {
+        ds18b20_sim_update(sim, &sim->devices[i]);
+    }
+}
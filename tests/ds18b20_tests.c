@@ -20,12 +20,60 @@
  */
 #include "ds18b20_tests.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+
+#ifdef ESP_PLATFORM
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+
+#define ds18b20_tests_yield()           vTaskDelay(1)
+
+#else
+
+#include <time.h>
+#include <sched.h>
+
+#define ESP_LOGI(tag, format, ...)      printf("I %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGE(tag, format, ...)      (atomic_fetch_add(&ds18b20_tests_errors, 1), printf("E %s: " format "\n", tag, ##__VA_ARGS__))
+
+#define ds18b20_tests_yield()           sched_yield()
+
+atomic_size_t ds18b20_tests_errors;
+
+/**
+ * @brief Returns monotonic time since unspecified moment (in microseconds), in place of ESP timer.
+ * 
+ */
+static int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+#endif /* ESP_PLATFORM */
 
 #include "ds18b20.h"
+#include "ds18b20_validator.h"
+#include "ds18b20_sim.h"
+#include "ds18b20_gpio_fast_slots.h"
+#include "ds18b20_timeslots.h"
+#include "ds18b20_rom.h"
+#include "ds18b20_converter.h"
+#include "ds18b20_registers.h"
+#include "ds18b20_specifications.h"
+#include "ds18b20_manager.h"
+#include "ds18b20_lockstep.h"
+#include "ds18b20_worker.h"
+#include "ds18b20_shared.h"
 
 #define TAG                             "ds18b20"
 
@@ -44,6 +92,160 @@
 #define DS18B20_RESTORE_CHECK_PERIOD_MS 10
 
 #define DS18B20_TASK_PERIOD_MS          1000
+#define DS18B20_WORK_PERIOD_MS          10
+
+#define DS18B20_BENCHMARK_BUFFERS       1024
+#define DS18B20_BENCHMARK_BUFFER_SIZE   8
+
+#define DS18B20_SIM_DEVICES_NO          4
+#define DS18B20_SIM_SERIAL              0x0000AB1234560000ULL
+#define DS18B20_SIM_TEMPERATURE         0x0191  // 25.0625 Celsius
+
+#define DS18B20_EXCLUSION_TASKS_NO      2
+#define DS18B20_EXCLUSION_ITERATIONS    200
+
+#define DS18B20_DISCOVERY_DEVICES_NO    6
+#define DS18B20_DISCOVERY_CAPACITY      8
+#define DS18B20_FOREIGN_FAMILY_CODE     0x10
+
+#define DS18B20_LOOKUP_MAX_DEVICES      256
+#define DS18B20_LOOKUP_ROUNDS           100
+
+#define DS18B20_ALARM_DEVICES_NO        40
+#define DS18B20_ALARM_ROUNDS            20
+#define DS18B20_ALARM_NORMAL            (24 * 16)
+#define DS18B20_ALARM_HOT               (35 * 16)
+#define DS18B20_ALARM_COLD              (5 * 16)
+
+#define DS18B20_RAW_CODES_NO            4096
+#define DS18B20_RAW_SIGN_BIT            0x0800
+
+#define DS18B20_BATCH_READINGS_NO       1024
+#define DS18B20_BATCH_ROUNDS            200
+
+#define DS18B20_STORAGE_DEVICES_NO      6
+#define DS18B20_STORAGE_REPORT_DEVICES  256
+
+#define DS18B20_INTEGRITY_DEVICES_NO    40
+#define DS18B20_INTEGRITY_ROUNDS        10
+#define DS18B20_INTEGRITY_FAULT_PERIOD  400
+#define DS18B20_INTEGRITY_MODES_NO      2
+
+#define DS18B20_LEARNING_DEVICES_NO     8
+#define DS18B20_LEARNING_ROUNDS         30
+#define DS18B20_LEARNING_CONVERTION_US  540000
+#define DS18B20_LEARNING_SPREAD_US      10000
+#define DS18B20_LEARNING_JITTER_US      8000
+#define DS18B20_LEARNING_MARGIN_MS      2
+#define DS18B20_LEARNING_PREEMPTION_MS  100
+#define DS18B20_TIMING_POLL_US          1000
+
+#define DS18B20_RESOLUTION_DEVICES_NO   2
+#define DS18B20_RESOLUTION_ROUNDS       60
+#define DS18B20_RESOLUTION_RAMP_START   20
+#define DS18B20_RESOLUTION_RAMP_END     35
+#define DS18B20_RESOLUTION_RAMP_STEP    32  // 2 Celsius per reading
+#define DS18B20_RESOLUTION_POLICIES_NO  3
+#define DS18B20_RESOLUTION_LATENCY_MS   200
+
+#define DS18B20_BROADCAST_DEVICES_NO    60
+#define DS18B20_BROADCAST_MODES_NO      2
+
+#define DS18B20_PARTIAL_DEVICES_NO      4
+#define DS18B20_PARTIAL_CAPACITY        2
+#define DS18B20_PARTIAL_UPPER_ALARM     0x55
+
+#define DS18B20_MIRROR_DEVICES_NO       10
+#define DS18B20_MIRROR_REASSERTS        5
+#define DS18B20_MIRROR_CHANGED_DEVICE   3
+#define DS18B20_MIRROR_BROWNOUT_DEVICE  5
+#define DS18B20_LEARNING_MODES_NO       3
+
+#define DS18B20_FAST_INIT_DEVICES_NO    30
+#define DS18B20_FAST_INIT_CASES_NO      3
+#define DS18B20_FAST_INIT_PARASITE      7
+
+#define DS18B20_TOPOLOGY_DEVICES_NO     8
+#define DS18B20_TOPOLOGY_SPARE_DEVICE   DS18B20_TOPOLOGY_DEVICES_NO
+#define DS18B20_TOPOLOGY_REMOVED_DEVICE 2
+#define DS18B20_TOPOLOGY_PATH           "ds18b20_topology.bin"
+
+#define DS18B20_VERIFY_DEVICES_NO       12
+#define DS18B20_VERIFY_REMOVED_FIRST    3
+#define DS18B20_VERIFY_REMOVED_SECOND   7
+#define DS18B20_VERIFY_ROMS_NO          3
+#define DS18B20_VERIFY_READ_SLOTS       (DS18B20_ROM_SIZE * 8 * 2)
+#define DS18B20_VERIFY_WRITE_SLOTS      (8 + DS18B20_ROM_SIZE * 8)
+
+#define DS18B20_MANAGER_BUSES_NO        4
+#define DS18B20_MANAGER_DEVICES_NO      8
+#define DS18B20_MANAGER_SWEEPS          5
+#define DS18B20_MANAGER_ALIGNMENT_MS    10
+#define DS18B20_MANAGER_FAILED_BUS      2
+
+#define DS18B20_LOCKSTEP_LANES_NO       8
+#define DS18B20_LOCKSTEP_CAPACITY       8
+#define DS18B20_LOCKSTEP_PARASITE_LANE  5
+#define DS18B20_LOCKSTEP_FAILED_LANE    2
+
+#define DS18B20_WORKER_BUSES_NO         2
+#define DS18B20_WORKER_DEVICES_NO       4
+#define DS18B20_WORKER_SLOTS_NO         8
+#define DS18B20_WORKER_PRODUCERS_NO     3
+#define DS18B20_WORKER_ITERATIONS       40
+
+#define DS18B20_SHARED_DEVICES_NO       4
+#define DS18B20_SHARED_TASKS_NO         4
+#define DS18B20_SHARED_ITERATIONS       5
+#define DS18B20_SHARED_SETTLE_MS        10
+
+#define DS18B20_CACHE_DEVICES_NO        3
+#define DS18B20_CACHE_MAX_AGE_MS        1500
+#define DS18B20_CACHE_HIT_STEP_MS       500
+
+#define DS18B20_MOCK_GPIO               4
+#define DS18B20_MOCK_EDGES              4
+
+/**
+ * @brief Reference CRC checksum calculation (former implementation of the validator) used for comparison.
+ * 
+ * Copies the data and shifts the whole copy one bit at a time.
+ */
+static uint8_t ds18b20_crc8_reference(const uint8_t * const data, const size_t dataSize)
+{
+    uint8_t *dataCopy = malloc(dataSize);
+    memcpy(dataCopy, data, dataSize);
+
+    for (size_t byteNo = 0; byteNo < dataSize; ++byteNo)
+    {
+        for (uint8_t bitNo = 0; bitNo < 8; ++bitNo)
+        {
+            bool performXor = (*dataCopy) & 0x01;
+
+            *dataCopy >>= 1;
+            for (size_t i = 1; i < dataSize - byteNo; ++i)
+            {
+                if (dataCopy[i] & 0x01)
+                {
+                    dataCopy[i - 1] |= 0x80;
+                }
+                dataCopy[i] >>= 1;
+            }
+
+            if (performXor)
+            {
+                *dataCopy ^= DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB;
+            }
+        }
+    }
+
+    uint8_t crc = *dataCopy;
+    free(dataCopy);
+
+    return crc;
+}
+
+#ifdef ESP_PLATFORM
 
 void ds18b20_init_test(void)
 {
@@ -58,17 +260,17 @@ void ds18b20_init_test(void)
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
-        ESP_LOGI(TAG, "Address %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Address %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].rom[0], ds18b20_devices[i].rom[1], ds18b20_devices[i].rom[2], ds18b20_devices[i].rom[3],
             ds18b20_devices[i].rom[4], ds18b20_devices[i].rom[5], ds18b20_devices[i].rom[6], ds18b20_devices[i].rom[7]
         );
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
-        ESP_LOGI(TAG, "Power mode %d: %d", i, ds18b20_devices[i].powerMode);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Power mode %zu: %d", i, ds18b20_devices[i].powerMode);
     }
 
     return;
@@ -93,32 +295,32 @@ void ds18b20_read_temperature_test(void)
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
-        ESP_LOGI(TAG, "Address %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Address %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].rom[0], ds18b20_devices[i].rom[1], ds18b20_devices[i].rom[2], ds18b20_devices[i].rom[3],
             ds18b20_devices[i].rom[4], ds18b20_devices[i].rom[5], ds18b20_devices[i].rom[6], ds18b20_devices[i].rom[7]
         );
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
-        ESP_LOGI(TAG, "Power mode %d: %d", i, ds18b20_devices[i].powerMode);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Power mode %zu: %d", i, ds18b20_devices[i].powerMode);
 
         if (DS18B20_OK != ds18b20__Configure(&ds18b20_oneWire, i, &ds18b20_config, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Failure while configuring device no. %d.", i);
+            ESP_LOGI(TAG, "Failure while configuring device no. %zu.", i);
             return;
         }
 
-        ESP_LOGI(TAG, "Successfully configured device no. %d.", i);
+        ESP_LOGI(TAG, "Successfully configured device no. %zu.", i);
 
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
     }
 
     while (1)
@@ -128,11 +330,91 @@ void ds18b20_read_temperature_test(void)
         {
             if (DS18B20_OK != ds18b20__GetTemperatureCWithChecking(&ds18b20_oneWire, i, &temperature, DS18B20_TEMP_CHECK_PERIOD_MS, DS18B20_CHECKSUM))
             {
-                ESP_LOGI(TAG, "Failure while reading temperature from device no. %d...", i);
+                ESP_LOGI(TAG, "Failure while reading temperature from device no. %zu...", i);
             }
             else
             {
-                ESP_LOGI(TAG, "Temperature %d: %.4f", i, temperature);
+                ESP_LOGI(TAG, "Temperature %zu: %.4f", i, temperature);
+            }
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
+    }
+}
+
+void ds18b20_read_temperatures_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20__InitOneWire(&ds18b20_oneWire, DS18B20_1W_BUS, ds18b20_devices, DS18B20_DEVICES_NO, DS18B20_CHECKSUM))
+    {
+        ESP_LOGI(TAG, "Failure while initializing DS18B20 One-Wire driver.");
+        return;
+    }
+
+    while (1)
+    {
+        DS18B20_temperature_out_t temperatures[DS18B20_DEVICES_NO];
+        TickType_t sweepStart = xTaskGetTickCount();
+        if (DS18B20_OK != ds18b20__GetTemperaturesCWithChecking(&ds18b20_oneWire, temperatures, DS18B20_TEMP_CHECK_PERIOD_MS, DS18B20_CHECKSUM))
+        {
+            ESP_LOGI(TAG, "Failure while reading temperatures from the bus...");
+        }
+        else
+        {
+            ESP_LOGI(TAG, "Sweep of %d devices took %" PRIu32 " ms.", DS18B20_DEVICES_NO, (xTaskGetTickCount() - sweepStart) * portTICK_PERIOD_MS);
+            for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
+            {
+                ESP_LOGI(TAG, "Temperature %zu: %.4f", i, temperatures[i]);
+            }
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
+    }
+}
+
+void ds18b20_split_convertion_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20__InitOneWire(&ds18b20_oneWire, DS18B20_1W_BUS, ds18b20_devices, DS18B20_DEVICES_NO, DS18B20_CHECKSUM))
+    {
+        ESP_LOGI(TAG, "Failure while initializing DS18B20 One-Wire driver.");
+        return;
+    }
+
+    while (1)
+    {
+        DS18B20_convertion_t convertion;
+        if (DS18B20_OK != ds18b20__StartTemperaturesC(&ds18b20_oneWire, &convertion))
+        {
+            ESP_LOGI(TAG, "Failure while starting temperature convertion...");
+            vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
+            continue;
+        }
+
+        // Do some other work while devices are converting
+        size_t workCycles = 0;
+        bool ready = false;
+        while (DS18B20_OK == ds18b20__IsConvertionReady(&ds18b20_oneWire, &convertion, &ready) && !ready)
+        {
+            vTaskDelay(pdMS_TO_TICKS(DS18B20_WORK_PERIOD_MS));
+            ++workCycles;
+        }
+        ESP_LOGI(TAG, "Convertion finished after %zu work cycles.", workCycles);
+
+        DS18B20_temperature_out_t temperatures[DS18B20_DEVICES_NO];
+        if (DS18B20_OK != ds18b20__CollectTemperaturesC(&ds18b20_oneWire, &convertion, temperatures, DS18B20_CHECKSUM))
+        {
+            ESP_LOGI(TAG, "Failure while collecting temperatures...");
+        }
+        else
+        {
+            for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
+            {
+                ESP_LOGI(TAG, "Temperature %zu: %.4f", i, temperatures[i]);
             }
         }
 
@@ -159,44 +441,44 @@ void ds18b20_store_registers_test(void)
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
-        ESP_LOGI(TAG, "Address %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Address %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].rom[0], ds18b20_devices[i].rom[1], ds18b20_devices[i].rom[2], ds18b20_devices[i].rom[3],
             ds18b20_devices[i].rom[4], ds18b20_devices[i].rom[5], ds18b20_devices[i].rom[6], ds18b20_devices[i].rom[7]
         );
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
-        ESP_LOGI(TAG, "Power mode %d: %d", i, ds18b20_devices[i].powerMode);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Power mode %zu: %d", i, ds18b20_devices[i].powerMode);
 
         if (DS18B20_OK != ds18b20__Configure(&ds18b20_oneWire, i, &ds18b20_config, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Failure while configuring device no. %d.", i);
+            ESP_LOGI(TAG, "Failure while configuring device no. %zu.", i);
             return;
         }
 
-        ESP_LOGI(TAG, "Successfully configured device no. %d.", i);
+        ESP_LOGI(TAG, "Successfully configured device no. %zu.", i);
 
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
     }
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
         while (DS18B20_OK != ds18b20__StoreRegistersWithChecking(&ds18b20_oneWire, i, DS18B20_STORE_CHECK_PERIOD_MS))
         {
-            ESP_LOGI(TAG, "Failure while trying to store registers into EEPROM (device no. %d).", i);
+            ESP_LOGI(TAG, "Failure while trying to store registers into EEPROM (device no. %zu).", i);
 
             vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
         }
         
-        ESP_LOGI(TAG, "Successfully stored registers into EEPROM (device no. %d).", i);
+        ESP_LOGI(TAG, "Successfully stored registers into EEPROM (device no. %zu).", i);
     }
 
     return;
@@ -221,51 +503,51 @@ void ds18b20_restore_registers_test(void)
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
-        ESP_LOGI(TAG, "Address %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Address %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].rom[0], ds18b20_devices[i].rom[1], ds18b20_devices[i].rom[2], ds18b20_devices[i].rom[3],
             ds18b20_devices[i].rom[4], ds18b20_devices[i].rom[5], ds18b20_devices[i].rom[6], ds18b20_devices[i].rom[7]
         );
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
-        ESP_LOGI(TAG, "Power mode %d: %d", i, ds18b20_devices[i].powerMode);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Power mode %zu: %d", i, ds18b20_devices[i].powerMode);
 
         if (DS18B20_OK != ds18b20__Configure(&ds18b20_oneWire, i, &ds18b20_config, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Failure while configuring device no. %d.", i);
+            ESP_LOGI(TAG, "Failure while configuring device no. %zu.", i);
             return;
         }
 
-        ESP_LOGI(TAG, "Successfully configured device no. %d.", i);
+        ESP_LOGI(TAG, "Successfully configured device no. %zu.", i);
 
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
     }
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
         while (DS18B20_OK != ds18b20__RestoreRegistersWithChecking(&ds18b20_oneWire, i, DS18B20_RESTORE_CHECK_PERIOD_MS, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Failure while trying to store registers into EEPROM (device no. %d).", i);
+            ESP_LOGI(TAG, "Failure while trying to store registers into EEPROM (device no. %zu).", i);
 
             vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
         }
         
-        ESP_LOGI(TAG, "Successfully restored registers from EEPROM (device no. %d).", i);
+        ESP_LOGI(TAG, "Successfully restored registers from EEPROM (device no. %zu).", i);
 
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
     }
 
     return;
@@ -290,32 +572,32 @@ void ds18b20_find_alarms_test(void)
 
     for (size_t i = 0; i < DS18B20_DEVICES_NO; ++i)
     {
-        ESP_LOGI(TAG, "Address %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Address %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].rom[0], ds18b20_devices[i].rom[1], ds18b20_devices[i].rom[2], ds18b20_devices[i].rom[3],
             ds18b20_devices[i].rom[4], ds18b20_devices[i].rom[5], ds18b20_devices[i].rom[6], ds18b20_devices[i].rom[7]
         );
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
-        ESP_LOGI(TAG, "Power mode %d: %d", i, ds18b20_devices[i].powerMode);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Power mode %zu: %d", i, ds18b20_devices[i].powerMode);
 
         if (DS18B20_OK != ds18b20__Configure(&ds18b20_oneWire, i, &ds18b20_config, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Failure while configuring device no. %d.", i);
+            ESP_LOGI(TAG, "Failure while configuring device no. %zu.", i);
             return;
         }
 
-        ESP_LOGI(TAG, "Successfully configured device no. %d.", i);
+        ESP_LOGI(TAG, "Successfully configured device no. %zu.", i);
 
-        ESP_LOGI(TAG, "Scratchpad %d: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
+        ESP_LOGI(TAG, "Scratchpad %zu: 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x 0x%02x", i,
             ds18b20_devices[i].scratchpad[0], ds18b20_devices[i].scratchpad[1], ds18b20_devices[i].scratchpad[2], 
             ds18b20_devices[i].scratchpad[3], ds18b20_devices[i].scratchpad[4], ds18b20_devices[i].scratchpad[5], 
             ds18b20_devices[i].scratchpad[6], ds18b20_devices[i].scratchpad[7], ds18b20_devices[i].scratchpad[8]
         );
-        ESP_LOGI(TAG, "Resolution %d: %d", i, ds18b20_devices[i].resolution + 9);
+        ESP_LOGI(TAG, "Resolution %zu: %d", i, ds18b20_devices[i].resolution + 9);
     }
 
     while (1)
@@ -324,11 +606,11 @@ void ds18b20_find_alarms_test(void)
         {
             if (DS18B20_OK != ds18b20__RequestTemperatureC(&ds18b20_oneWire, i))
             {
-                ESP_LOGI(TAG, "Failure while requesting temperature from device no. %d...", i);
+                ESP_LOGI(TAG, "Failure while requesting temperature from device no. %zu...", i);
             }
             else
             {
-                ESP_LOGI(TAG, "Temperature requested from device no. %d!", i);
+                ESP_LOGI(TAG, "Temperature requested from device no. %zu!", i);
             }
         }
         ESP_LOGI(TAG, "Searching for alarms...");
@@ -336,9 +618,3150 @@ void ds18b20_find_alarms_test(void)
         size_t deviceIndex;
         while (DS18B20_OK == ds18b20__FindNextAlarm(&ds18b20_oneWire, &deviceIndex, DS18B20_CHECKSUM))
         {
-            ESP_LOGI(TAG, "Alarm found in device no. %d!", deviceIndex);
+            ESP_LOGI(TAG, "Alarm found in device no. %zu!", deviceIndex);
         }
 
         vTaskDelay(pdMS_TO_TICKS(DS18B20_TASK_PERIOD_MS));
     }
-}
\ No newline at end of file
+}
+
+#endif /* ESP_PLATFORM */
+
+void ds18b20_crc8_benchmark_test(void)
+{
+    static uint8_t buffers[DS18B20_BENCHMARK_BUFFERS][DS18B20_BENCHMARK_BUFFER_SIZE];
+    uint32_t seed = 1;
+    for (size_t i = 0; i < DS18B20_BENCHMARK_BUFFERS; ++i)
+    {
+        for (size_t j = 0; j < DS18B20_BENCHMARK_BUFFER_SIZE; ++j)
+        {
+            seed = seed * 1103515245 + 12345;
+            buffers[i][j] = seed >> 16;
+        }
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < DS18B20_BENCHMARK_BUFFERS; ++i)
+    {
+        uint8_t crc = ds18b20_crc8(buffers[i], DS18B20_BENCHMARK_BUFFER_SIZE);
+        if (crc != ds18b20_crc8_reference(buffers[i], DS18B20_BENCHMARK_BUFFER_SIZE)
+            || DS18B20_OK != ds18b20_validate_crc8(buffers[i], DS18B20_BENCHMARK_BUFFER_SIZE, DS18B20_CRC8_POLYNOMIAL_WITHOUT_MSB, crc))
+        {
+            ++mismatches;
+        }
+    }
+    ESP_LOGI(TAG, "CRC mismatches between implementations: %zu", mismatches);
+
+    volatile uint8_t sink = 0;
+    int64_t start = esp_timer_get_time();
+    for (size_t i = 0; i < DS18B20_BENCHMARK_BUFFERS; ++i)
+    {
+        sink ^= ds18b20_crc8_reference(buffers[i], DS18B20_BENCHMARK_BUFFER_SIZE);
+    }
+    int64_t referenceUs = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (size_t i = 0; i < DS18B20_BENCHMARK_BUFFERS; ++i)
+    {
+        sink ^= ds18b20_crc8(buffers[i], DS18B20_BENCHMARK_BUFFER_SIZE);
+    }
+    int64_t tableUs = esp_timer_get_time() - start;
+
+    ESP_LOGI(TAG, "CRC of %d x %d bytes: reference %" PRId64 " us, table %" PRId64 " us", 
+        DS18B20_BENCHMARK_BUFFERS, DS18B20_BENCHMARK_BUFFER_SIZE, referenceUs, tableUs);
+
+    return;
+}
+
+/**
+ * @brief Initializes simulated bus with devices measuring consecutive temperatures and One-Wire driver using it.
+ * 
+ */
+static DS18B20_error_t ds18b20_sim_bus_init(DS18B20_onewire_t * const onewire, DS18B20_sim_t * const sim, DS18B20_sim_clock_t * const clock, 
+    DS18B20_sim_device_t * const simDevices, DS18B20_t * const devices, const size_t devicesNo)
+{
+    clock->nowUs = 0;
+    for (size_t i = 0; i < devicesNo; ++i)
+    {
+        ds18b20_sim_init_device(&simDevices[i], DS18B20_SIM_SERIAL + i, DS18B20_PM_EXTERNAL_SUPPLY, DS18B20_SIM_TEMPERATURE + i);
+    }
+    ds18b20_sim_init(sim, clock, simDevices, devicesNo);
+
+    return ds18b20__InitOneWireWithTransport(onewire, &ds18b20_sim_transport, sim, devices, devicesNo, DS18B20_CHECKSUM);
+}
+
+void ds18b20_sim_bus_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_SIM_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_SIM_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_SIM_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+    ESP_LOGI(TAG, "Init: %" PRIu32 " resets, %" PRIu32 " write slots, %" PRIu32 " read slots, %" PRIu64 " us of bus time", 
+        sim.stats.resets, sim.stats.writeSlots, sim.stats.readSlots, sim.stats.busTimeUs);
+
+    size_t failures = 0;
+    for (size_t i = 0; i < DS18B20_SIM_DEVICES_NO; ++i)
+    {
+        bool found = false;
+        for (size_t j = 0; j < DS18B20_SIM_DEVICES_NO; ++j)
+        {
+            found |= 0 == memcmp(ds18b20_devices[i].rom, simDevices[j].rom, sizeof(DS18B20_rom_t));
+        }
+        if (!found)
+        {
+            ESP_LOGE(TAG, "Device %zu has not been found on simulated bus.", i);
+            ++failures;
+        }
+    }
+
+    // Single device - request, wait and read
+    DS18B20_temperature_out_t temperature;
+    ds18b20_sim_reset_stats(&sim);
+    uint64_t start = clock.nowUs;
+    if (DS18B20_OK != ds18b20__GetTemperatureC(&ds18b20_oneWire, 0, &temperature, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperature from simulated bus.");
+        ++failures;
+    }
+    ESP_LOGI(TAG, "Single read: %" PRIu64 " us of bus time, %" PRIu64 " us in total", sim.stats.busTimeUs, clock.nowUs - start);
+
+    // All devices - simultaneous convertion and bulk read
+    DS18B20_temperature_out_t temperatures[DS18B20_SIM_DEVICES_NO];
+    ds18b20_sim_reset_stats(&sim);
+    start = clock.nowUs;
+    if (DS18B20_OK != ds18b20__GetTemperaturesCWithChecking(&ds18b20_oneWire, temperatures, DS18B20_CHECK_PERIOD_MIN_MS, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperatures from simulated bus.");
+        ++failures;
+    }
+    ESP_LOGI(TAG, "Bulk read of %d devices: %" PRIu32 " convertions, %" PRIu64 " us of bus time, %" PRIu64 " us in total", 
+        DS18B20_SIM_DEVICES_NO, sim.stats.convertions, sim.stats.busTimeUs, clock.nowUs - start);
+
+    for (size_t i = 0; i < DS18B20_SIM_DEVICES_NO; ++i)
+    {
+        DS18B20_sim_device_t *simDevice = NULL;
+        for (size_t j = 0; j < DS18B20_SIM_DEVICES_NO; ++j)
+        {
+            if (0 == memcmp(ds18b20_devices[i].rom, simDevices[j].rom, sizeof(DS18B20_rom_t)))
+            {
+                simDevice = &simDevices[j];
+            }
+        }
+        if (simDevice && temperatures[i] != simDevice->temperature / 16.0)
+        {
+            ESP_LOGE(TAG, "Temperature %zu: %.4f, expected %.4f", i, temperatures[i], simDevice->temperature / 16.0);
+            ++failures;
+        }
+    }
+
+    // All devices - split-phase convertion polled against simulated time
+    DS18B20_convertion_t convertion;
+    size_t workCycles = 0;
+    bool ready = false;
+    ds18b20_sim_reset_stats(&sim);
+    if (DS18B20_OK != ds18b20__StartTemperaturesC(&ds18b20_oneWire, &convertion))
+    {
+        ESP_LOGE(TAG, "Failure while starting temperature convertion on simulated bus.");
+        ++failures;
+    }
+    while (DS18B20_OK == ds18b20__IsConvertionReady(&ds18b20_oneWire, &convertion, &ready) && !ready)
+    {
+        clock.nowUs += DS18B20_WORK_PERIOD_MS * 1000;
+        ++workCycles;
+    }
+    if (DS18B20_OK != ds18b20__CollectTemperaturesC(&ds18b20_oneWire, &convertion, temperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while collecting temperatures from simulated bus.");
+        ++failures;
+    }
+    ESP_LOGI(TAG, "Split-phase read: ready after %zu work cycles, %" PRIu64 " us of bus time", workCycles, sim.stats.busTimeUs);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Simulated bus test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Simulated bus test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Describes mocked GPIO register file with single device connected to the bus.
+ * 
+ */
+static struct
+{
+    uint32_t enableSet, enableClear, outSet, outClear, in; /**< Registers written and read by the fast GPIO transport */
+    uint32_t enable; /**< Output enable state resulting from the writes */
+    uint32_t cycles; /**< Mocked CPU cycle counter - one cycle per microsecond, advanced on every read */
+    uint32_t holdFrom, holdTo; /**< Cycles between which the mocked device pulls the bus low */
+    uint32_t edges[DS18B20_MOCK_EDGES]; /**< Cycles at which master has pulled down or released the bus */
+    size_t edgesNo; /**< Number of recorded edges */
+} ds18b20_mock;
+
+/**
+ * @brief Applies pending register writes, records bus edges and updates input register.
+ * 
+ */
+static uint32_t ds18b20_mock_get_cycles(void)
+{
+    uint32_t enable = (ds18b20_mock.enable | ds18b20_mock.enableSet) & ~ds18b20_mock.enableClear;
+    ds18b20_mock.enableSet = ds18b20_mock.enableClear = 0;
+    if (enable != ds18b20_mock.enable && ds18b20_mock.edgesNo < DS18B20_MOCK_EDGES)
+    {
+        ds18b20_mock.edges[ds18b20_mock.edgesNo++] = ds18b20_mock.cycles;
+    }
+    ds18b20_mock.enable = enable;
+
+    bool low = enable || (ds18b20_mock.cycles >= ds18b20_mock.holdFrom && ds18b20_mock.cycles < ds18b20_mock.holdTo);
+    ds18b20_mock.in = low ? 0 : (1UL << DS18B20_MOCK_GPIO);
+
+    return ds18b20_mock.cycles++;
+}
+
+/**
+ * @brief Prepares mocked register file for the next timeslot, device holds the bus low between given moments of the timeslot.
+ * 
+ */
+static uint32_t ds18b20_mock_start_slot(const uint32_t holdFromUs, const uint32_t holdToUs)
+{
+    ds18b20_mock.edgesNo = 0;
+    ds18b20_mock.holdFrom = ds18b20_mock.cycles + holdFromUs;
+    ds18b20_mock.holdTo = ds18b20_mock.cycles + holdToUs;
+    return ds18b20_mock.cycles;
+}
+
+/**
+ * @brief Checks that the last timeslot pulled the bus low for expected time and had expected duration.
+ * 
+ */
+static size_t ds18b20_mock_check_slot(const char * const name, const uint32_t start, const uint32_t lowUs, const uint32_t slotUs)
+{
+    uint32_t measuredLowUs = 2 == ds18b20_mock.edgesNo ? ds18b20_mock.edges[1] - ds18b20_mock.edges[0] : 0;
+    uint32_t measuredSlotUs = ds18b20_mock.cycles - start - 1;
+    if (lowUs != measuredLowUs || slotUs != measuredSlotUs)
+    {
+        ESP_LOGE(TAG, "%s: bus low for %" PRIu32 " us in %" PRIu32 " us timeslot, expected %" PRIu32 " us in %" PRIu32 " us", name, measuredLowUs, measuredSlotUs, lowUs, slotUs);
+        return 1;
+    }
+    return 0;
+}
+
+void ds18b20_gpio_fast_timing_test(void)
+{
+    DS18B20_gpio_fast_t fast =
+    {
+        .bus = DS18B20_MOCK_GPIO,
+        .mask = 1UL << DS18B20_MOCK_GPIO,
+        .regs =
+        {
+            .enableSet = &ds18b20_mock.enableSet,
+            .enableClear = &ds18b20_mock.enableClear,
+            .outSet = &ds18b20_mock.outSet,
+            .outClear = &ds18b20_mock.outClear,
+            .in = &ds18b20_mock.in
+        },
+        .cyclesPerUs = 1,
+        .get_cycles = ds18b20_mock_get_cycles
+    };
+    DS18B20_onewire_t ds18b20_oneWire = { .transportContext = &fast };
+    memset(&ds18b20_mock, 0, sizeof(ds18b20_mock));
+
+    size_t failures = 0;
+    uint32_t start = ds18b20_mock_start_slot(0, 0);
+    ds18b20_gpio_fast_write_bit(&ds18b20_oneWire, 1);
+    failures += ds18b20_mock_check_slot("Write 1", start, WRITE_BIT1_DELAY0_US, WRITE_BIT1_DELAY0_US + WRITE_BIT1_DELAY1_US);
+
+    start = ds18b20_mock_start_slot(0, 0);
+    ds18b20_gpio_fast_write_bit(&ds18b20_oneWire, 0);
+    failures += ds18b20_mock_check_slot("Write 0", start, WRITE_BIT0_DELAY0_US, WRITE_BIT0_DELAY0_US + WRITE_BIT0_DELAY1_US);
+
+    // Device releases the bus shortly before sampling point
+    start = ds18b20_mock_start_slot(0, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US - 2);
+    failures += 1 != ds18b20_gpio_fast_read_bit(&ds18b20_oneWire);
+    failures += ds18b20_mock_check_slot("Read 1", start, READ_BIT_DELAY0_US, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US + READ_BIT_DELAY2_US);
+
+    // Device holds the bus low past sampling point
+    start = ds18b20_mock_start_slot(0, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US + 5);
+    failures += 0 != ds18b20_gpio_fast_read_bit(&ds18b20_oneWire);
+    failures += ds18b20_mock_check_slot("Read 0", start, READ_BIT_DELAY0_US, READ_BIT_DELAY0_US + READ_BIT_DELAY1_US + READ_BIT_DELAY2_US);
+
+    // Device answers with presence pulse 20 us after the bus is released
+    start = ds18b20_mock_start_slot(RESET_DELAY0_US + 20, RESET_DELAY0_US + 140);
+    failures += 1 != ds18b20_gpio_fast_reset(&ds18b20_oneWire);
+    failures += ds18b20_mock_check_slot("Reset", start, RESET_DELAY0_US, RESET_DELAY0_US + RESET_DELAY1_US + RESET_DELAY2_US);
+
+    start = ds18b20_mock_start_slot(0, 0);
+    failures += 0 != ds18b20_gpio_fast_reset(&ds18b20_oneWire);
+
+    ds18b20_gpio_fast_start_pullup(&ds18b20_oneWire);
+    failures += !(ds18b20_mock.outSet & fast.mask) || !(ds18b20_mock.enableSet & fast.mask);
+    ds18b20_gpio_fast_end_pullup(&ds18b20_oneWire);
+    failures += !(ds18b20_mock.outClear & fast.mask) || !(ds18b20_mock.enableClear & fast.mask);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Fast GPIO timing test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Fast GPIO timing test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_critical_scope_test(void)
+{
+#ifndef ESP_PLATFORM
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_SIM_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_SIM_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_SIM_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    // Parasite device requires strong pullup right after the convertion command
+    simDevices[0].powerMode = DS18B20_PM_PARASITE;
+    ds18b20_devices[0].powerMode = DS18B20_PM_PARASITE;
+
+    size_t failures = 0;
+    for (DS18B20_critical_t critical = DS18B20_CRITICAL_SLOT; critical < DS18B20_CRITICAL_COUNT; ++critical)
+    {
+        if (DS18B20_OK != ds18b20__SetCriticalScope(&ds18b20_oneWire, critical))
+        {
+            ESP_LOGE(TAG, "Failure while setting scope of critical sections.");
+            ++failures;
+            continue;
+        }
+        ds18b20_port_spinlock_init(&ds18b20_oneWire.lock);
+        ds18b20_sim_reset_stats(&sim);
+
+        DS18B20_temperature_out_t temperatures[DS18B20_SIM_DEVICES_NO];
+        if (DS18B20_OK != ds18b20__GetTemperaturesC(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM) || sim.stats.parasiteFailures)
+        {
+            ESP_LOGE(TAG, "Failure while reading temperatures with critical scope %d.", critical);
+            ++failures;
+        }
+
+        // Bulk read is a single convertion transaction followed by one read transaction per device,
+        // convertion command with strong pullup is always sent in single critical section
+        uint32_t slots = sim.stats.resets + sim.stats.writeSlots + sim.stats.readSlots;
+        uint32_t expected = DS18B20_CRITICAL_SLOT == critical ? slots - 7 
+            : DS18B20_CRITICAL_TRANSACTION == critical ? 1 + DS18B20_SIM_DEVICES_NO : ds18b20_oneWire.lock.enters;
+        ESP_LOGI(TAG, "Critical scope %d: %" PRIu32 " critical sections for %" PRIu32 " timeslots", critical, ds18b20_oneWire.lock.enters, slots);
+        if (expected != ds18b20_oneWire.lock.enters || 1 != ds18b20_oneWire.lock.maxDepth || 0 != ds18b20_oneWire.lock.depth 
+            || ds18b20_port_holds_critical(&ds18b20_oneWire.lock))
+        {
+            ESP_LOGE(TAG, "Critical scope %d: %" PRIu32 " critical sections (expected %" PRIu32 "), nesting depth %" PRIu32 ", left with depth %" PRIu32, critical, 
+                ds18b20_oneWire.lock.enters, expected, ds18b20_oneWire.lock.maxDepth, ds18b20_oneWire.lock.depth);
+            ++failures;
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Critical scope test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Critical scope test passed.");
+    }
+#endif /* ESP_PLATFORM */
+
+    return;
+}
+
+static atomic_uint ds18b20_exclusion_active; /**< Number of tasks generating signals on the bus at the moment */
+static atomic_uint ds18b20_exclusion_overlaps; /**< Number of signals generated while other task was generating signal too */
+
+/**
+ * @brief Records the start of signal, detecting other tasks accessing the bus at the same time.
+ * 
+ */
+static void ds18b20_exclusion_begin(void)
+{
+    if (atomic_fetch_add(&ds18b20_exclusion_active, 1))
+    {
+        atomic_fetch_add(&ds18b20_exclusion_overlaps, 1);
+    }
+}
+
+/**
+ * @brief Records the end of signal.
+ * 
+ */
+static void ds18b20_exclusion_end(void)
+{
+    atomic_fetch_sub(&ds18b20_exclusion_active, 1);
+}
+
+static uint8_t ds18b20_exclusion_reset(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_exclusion_begin();
+    uint8_t presence = ds18b20_sim_transport.reset(onewire);
+    ds18b20_exclusion_end();
+    return presence;
+}
+
+static void ds18b20_exclusion_write_bit(const DS18B20_onewire_t * const onewire, const uint8_t bit)
+{
+    ds18b20_exclusion_begin();
+    ds18b20_sim_transport.write_bit(onewire, bit);
+    ds18b20_exclusion_end();
+}
+
+static uint8_t ds18b20_exclusion_read_bit(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_exclusion_begin();
+    uint8_t bit = ds18b20_sim_transport.read_bit(onewire);
+    ds18b20_exclusion_end();
+    return bit;
+}
+
+/**
+ * @brief Describes task verifying ROM addresses of all devices on the bus shared with other tasks.
+ * 
+ */
+typedef struct
+{
+    const DS18B20_onewire_t                 *onewire; /**< Shared bus */
+    DS18B20_thread_t                        thread; /**< Thread of the task */
+    size_t                                  failures; /**< Number of failed verifications (read after the thread finishes) */
+} DS18B20_exclusion_task_t;
+
+/**
+ * @brief Verifies ROM addresses of all devices repeatedly, every verification is a single transaction.
+ * 
+ * @param arg Pointer to task instance
+ */
+static void ds18b20_exclusion_verify(void *arg)
+{
+    DS18B20_exclusion_task_t *task = (DS18B20_exclusion_task_t *) arg;
+    for (size_t i = 0; i < DS18B20_EXCLUSION_ITERATIONS; ++i)
+    {
+        size_t deviceIndex = i % task->onewire->devicesNo;
+        bool present = false;
+        if (DS18B20_OK != ds18b20_verify_rom(task->onewire, task->onewire->devices[deviceIndex].rom, &present) || !present)
+        {
+            ++task->failures;
+        }
+    }
+
+    ds18b20_port_thread_exit(&task->thread);
+}
+
+void ds18b20_critical_exclusion_test(void)
+{
+    static DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_SIM_DEVICES_NO];
+    static DS18B20_sim_clock_t clock;
+    static DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_SIM_DEVICES_NO];
+    static DS18B20_transport_t transport;
+    static DS18B20_exclusion_task_t tasks[DS18B20_EXCLUSION_TASKS_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_SIM_DEVICES_NO)
+        || DS18B20_OK != ds18b20__SetCriticalScope(&ds18b20_oneWire, DS18B20_CRITICAL_TRANSACTION))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+    transport = ds18b20_sim_transport;
+    transport.reset = ds18b20_exclusion_reset;
+    transport.write_bit = ds18b20_exclusion_write_bit;
+    transport.read_bit = ds18b20_exclusion_read_bit;
+    ds18b20_oneWire.transport = &transport;
+    atomic_store(&ds18b20_exclusion_active, 0);
+    atomic_store(&ds18b20_exclusion_overlaps, 0);
+#ifndef ESP_PLATFORM
+    uint32_t enters = ds18b20_oneWire.lock.enters;
+#endif /* ESP_PLATFORM */
+
+    // Tasks run on different cores, each transaction of one task has to be finished before the other task starts its own
+    size_t failures = 0;
+    for (size_t i = 0; i < DS18B20_EXCLUSION_TASKS_NO; ++i)
+    {
+        tasks[i] = (DS18B20_exclusion_task_t) { .onewire = &ds18b20_oneWire };
+        if (!ds18b20_port_thread_start(&tasks[i].thread, ds18b20_exclusion_verify, &tasks[i], 
+            (int) i, DS18B20_WORKER_PRIORITY_DEFAULT, DS18B20_WORKER_STACK_SIZE_DEFAULT))
+        {
+            ESP_LOGE(TAG, "Failure while starting task %zu.", i);
+            return;
+        }
+    }
+    for (size_t i = 0; i < DS18B20_EXCLUSION_TASKS_NO; ++i)
+    {
+        ds18b20_port_thread_join(&tasks[i].thread);
+        if (tasks[i].failures)
+        {
+            ESP_LOGE(TAG, "Task %zu: %zu failed ROM verifications.", i, tasks[i].failures);
+            failures += tasks[i].failures;
+        }
+    }
+
+    ESP_LOGI(TAG, "%d transactions of %d tasks: %u overlapping signals", 
+        DS18B20_EXCLUSION_TASKS_NO * DS18B20_EXCLUSION_ITERATIONS, DS18B20_EXCLUSION_TASKS_NO, atomic_load(&ds18b20_exclusion_overlaps));
+    if (atomic_load(&ds18b20_exclusion_overlaps) || ds18b20_port_holds_critical(&ds18b20_oneWire.lock))
+    {
+        ESP_LOGE(TAG, "Tasks have accessed the bus at the same time.");
+        ++failures;
+    }
+#ifndef ESP_PLATFORM
+    // Every transaction is guarded by exactly one critical section, nested operations do not enter it again
+    enters = ds18b20_oneWire.lock.enters - enters;
+    if (DS18B20_EXCLUSION_TASKS_NO * DS18B20_EXCLUSION_ITERATIONS != enters || 1 != ds18b20_oneWire.lock.maxDepth)
+    {
+        ESP_LOGE(TAG, "%" PRIu32 " critical sections (expected %d), nesting depth %" PRIu32 ".", enters, 
+            DS18B20_EXCLUSION_TASKS_NO * DS18B20_EXCLUSION_ITERATIONS, ds18b20_oneWire.lock.maxDepth);
+        ++failures;
+    }
+#endif /* ESP_PLATFORM */
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Critical exclusion test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Critical exclusion test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Changes family code of simulated device, so it is no longer recognized as DS18B20.
+ * 
+ */
+static void ds18b20_sim_set_family(DS18B20_sim_device_t * const device, const uint8_t familyCode)
+{
+    device->rom[DS18B20_ROM_FAMILY_CODE_BYTE] = familyCode;
+    device->rom[DS18B20_ROM_CRC_BYTE] = ds18b20_crc8(device->rom, DS18B20_ROM_SIZE_TO_VALIDATE);
+}
+
+/**
+ * @brief Discovers simulated bus and checks the number of found and handled devices.
+ * 
+ */
+static size_t ds18b20_discovery_check(DS18B20_sim_t * const sim, const size_t capacity, const uint8_t familyCode, const size_t expectedDevicesNo)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_DISCOVERY_CAPACITY];
+    size_t devicesNo = 0;
+
+    ds18b20_sim_reset_stats(sim);
+    DS18B20_error_t status = ds18b20__DiscoverOneWireWithTransport(&ds18b20_oneWire, &ds18b20_sim_transport, sim, 
+        ds18b20_devices, capacity, familyCode, &devicesNo, DS18B20_CHECKSUM);
+    ESP_LOGI(TAG, "Discovery of family 0x%02x (capacity %zu): %zu devices found, %" PRIu64 " us of bus time", familyCode, capacity, devicesNo, sim->stats.busTimeUs);
+    if (DS18B20_OK != status || expectedDevicesNo != devicesNo)
+    {
+        ESP_LOGE(TAG, "Discovery finished with status %d, %zu devices found (expected %zu)", status, devicesNo, expectedDevicesNo);
+        return 1;
+    }
+
+    size_t failures = 0;
+    size_t handledNo = devicesNo < capacity ? devicesNo : capacity;
+    if (handledNo != ds18b20_oneWire.devicesNo)
+    {
+        ESP_LOGE(TAG, "Discovery handles %zu devices (expected %zu)", ds18b20_oneWire.devicesNo, handledNo);
+        ++failures;
+    }
+
+    DS18B20_temperature_out_t temperatures[DS18B20_DISCOVERY_CAPACITY];
+    if (DS18B20_OK != ds18b20__GetTemperaturesC(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperatures from discovered devices.");
+        return failures + 1;
+    }
+    for (size_t i = 0; i < ds18b20_oneWire.devicesNo; ++i)
+    {
+        if (DS18B20_ANY_FAMILY != familyCode && familyCode != ds18b20_devices[i].rom[DS18B20_ROM_FAMILY_CODE_BYTE])
+        {
+            ESP_LOGE(TAG, "Device %zu has unexpected family code 0x%02x", i, ds18b20_devices[i].rom[DS18B20_ROM_FAMILY_CODE_BYTE]);
+            ++failures;
+        }
+        for (size_t j = 0; j < sim->devicesNo; ++j)
+        {
+            if (0 == memcmp(ds18b20_devices[i].rom, sim->devices[j].rom, sizeof(DS18B20_rom_t)) 
+                && temperatures[i] != sim->devices[j].temperature / 16.0)
+            {
+                ESP_LOGE(TAG, "Temperature %zu: %.4f, expected %.4f", i, temperatures[i], sim->devices[j].temperature / 16.0);
+                ++failures;
+            }
+        }
+    }
+
+    return failures;
+}
+
+void ds18b20_discovery_test(void)
+{
+    DS18B20_sim_clock_t clock = { 0 };
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_DISCOVERY_DEVICES_NO];
+
+    // Serial numbers share long prefixes to exercise search conflicts
+    static const uint64_t serials[DS18B20_DISCOVERY_DEVICES_NO] = { 0x0123, 0x0122, 0x8123, 0x0923, 0x0127, 0x4000 };
+    for (size_t i = 0; i < DS18B20_DISCOVERY_DEVICES_NO; ++i)
+    {
+        ds18b20_sim_init_device(&simDevices[i], serials[i], DS18B20_PM_EXTERNAL_SUPPLY, DS18B20_SIM_TEMPERATURE + 16 * i);
+    }
+    ds18b20_sim_set_family(&simDevices[1], DS18B20_FOREIGN_FAMILY_CODE);
+    ds18b20_sim_set_family(&simDevices[4], DS18B20_FOREIGN_FAMILY_CODE);
+    simDevices[5].present = false;
+    ds18b20_sim_init(&sim, &clock, simDevices, DS18B20_DISCOVERY_DEVICES_NO);
+
+    size_t failures = 0;
+    failures += ds18b20_discovery_check(&sim, DS18B20_DISCOVERY_CAPACITY, DS18B20_ANY_FAMILY, 5);
+    failures += ds18b20_discovery_check(&sim, DS18B20_DISCOVERY_CAPACITY, DS18B20_SIM_FAMILY_CODE, 3);
+    failures += ds18b20_discovery_check(&sim, 2, DS18B20_SIM_FAMILY_CODE, 3);
+
+    // Single DS18B20 next to a device of other family - it must be addressed with its ROM
+    ds18b20_sim_init(&sim, &clock, &simDevices[3], 2);
+    failures += ds18b20_discovery_check(&sim, DS18B20_DISCOVERY_CAPACITY, DS18B20_SIM_FAMILY_CODE, 1);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Discovery test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Discovery test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_rom_lookup_benchmark_test(void)
+{
+    static DS18B20_t ds18b20_devices[DS18B20_LOOKUP_MAX_DEVICES];
+    static size_t romIndex[DS18B20_ROM_INDEX_SIZE(DS18B20_LOOKUP_MAX_DEVICES)];
+    static const size_t devicesNos[] = { 8, 64, DS18B20_LOOKUP_MAX_DEVICES };
+
+    // Serial numbers of devices from the same production lot often differ only in a few bits
+    uint32_t seed = 1;
+    for (size_t i = 0; i < DS18B20_LOOKUP_MAX_DEVICES; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        ds18b20_devices[i].rom[DS18B20_ROM_FAMILY_CODE_BYTE] = DS18B20_SIM_FAMILY_CODE;
+        ds18b20_devices[i].rom[1] = i;
+        ds18b20_devices[i].rom[2] = seed >> 24;
+        ds18b20_devices[i].rom[3] = 0x0C;
+        ds18b20_devices[i].rom[4] = 0x5A;
+        ds18b20_devices[i].rom[5] = 0x00;
+        ds18b20_devices[i].rom[6] = 0x00;
+        ds18b20_devices[i].rom[DS18B20_ROM_CRC_BYTE] = ds18b20_crc8(ds18b20_devices[i].rom, DS18B20_ROM_SIZE_TO_VALIDATE);
+    }
+
+    size_t failures = 0;
+    for (size_t n = 0; n < sizeof(devicesNos) / sizeof(devicesNos[0]); ++n)
+    {
+        DS18B20_onewire_t ds18b20_oneWire;
+        memset(&ds18b20_oneWire, 0, sizeof(ds18b20_oneWire));
+        ds18b20_oneWire.devices = ds18b20_devices;
+        ds18b20_oneWire.devicesNo = devicesNos[n];
+
+        int64_t timesUs[2];
+        for (size_t indexed = 0; indexed < 2; ++indexed)
+        {
+            if (indexed && DS18B20_OK != ds18b20__BuildRomIndex(&ds18b20_oneWire, romIndex, DS18B20_ROM_INDEX_SIZE(devicesNos[n])))
+            {
+                ESP_LOGE(TAG, "Failure while building ROM index.");
+                ++failures;
+            }
+
+            int64_t start = esp_timer_get_time();
+            for (size_t round = 0; round < DS18B20_LOOKUP_ROUNDS; ++round)
+            {
+                for (size_t i = 0; i < devicesNos[n]; ++i)
+                {
+                    size_t deviceIndex;
+                    if (DS18B20_OK != ds18b20__FindDeviceByRom(&ds18b20_oneWire, ds18b20_devices[i].rom, &deviceIndex) || i != deviceIndex)
+                    {
+                        ++failures;
+                    }
+                }
+            }
+            timesUs[indexed] = esp_timer_get_time() - start;
+        }
+
+        // ROM of the device outside of the handled ones
+        size_t deviceIndex;
+        if (devicesNos[n] < DS18B20_LOOKUP_MAX_DEVICES 
+            && DS18B20_DEVICE_NOT_FOUND != ds18b20__FindDeviceByRom(&ds18b20_oneWire, ds18b20_devices[devicesNos[n]].rom, &deviceIndex))
+        {
+            ESP_LOGE(TAG, "Device outside of %zu handled devices has been found.", devicesNos[n]);
+            ++failures;
+        }
+
+        ESP_LOGI(TAG, "ROM lookup of %zu devices x %d: linear scan %" PRId64 " us, index %" PRId64 " us", 
+            devicesNos[n], DS18B20_LOOKUP_ROUNDS, timesUs[0], timesUs[1]);
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "ROM lookup test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "ROM lookup test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_find_all_alarms_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_ALARM_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_ALARM_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_ALARM_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    DS18B20_config_t ds18b20_config =
+    {
+        .upperAlarm = DS18B20_UPPER_ALARM,
+        .lowerAlarm = DS18B20_LOWER_ALARM,
+        .resolution = DS18B20_RESOLUTION
+    };
+    for (size_t i = 0; i < DS18B20_ALARM_DEVICES_NO; ++i)
+    {
+        if (DS18B20_OK != ds18b20__Configure(&ds18b20_oneWire, i, &ds18b20_config, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while configuring device %zu.", i);
+            return;
+        }
+    }
+
+    size_t failures = 0;
+    uint32_t seed = 7;
+    for (size_t round = 0; round < DS18B20_ALARM_ROUNDS; ++round)
+    {
+        // Random subset of devices (including none and all of them) measures temperature out of the alarm range
+        uint32_t threshold = round % 4 == 0 ? 0 : (round % 4 == 1 ? 256 : (seed >> 16) & 0xFF);
+        for (size_t i = 0; i < DS18B20_ALARM_DEVICES_NO; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            bool alarm = ((seed >> 16) & 0xFF) < threshold;
+            simDevices[i].temperature = !alarm ? DS18B20_ALARM_NORMAL : ((seed & 0x100) ? DS18B20_ALARM_HOT : DS18B20_ALARM_COLD);
+        }
+        if (DS18B20_OK != ds18b20__RequestTemperaturesC(&ds18b20_oneWire))
+        {
+            ESP_LOGE(TAG, "Failure while requesting temperatures.");
+            ++failures;
+            continue;
+        }
+
+        uint32_t alarms[DS18B20_ALARM_BITMAP_WORDS(DS18B20_ALARM_DEVICES_NO)];
+        size_t alarmsNo = 0;
+        ds18b20_sim_reset_stats(&sim);
+        if (DS18B20_OK != ds18b20__FindAllAlarms(&ds18b20_oneWire, alarms, &alarmsNo, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while searching for all alarms.");
+            ++failures;
+            continue;
+        }
+        uint64_t sweepUs = sim.stats.busTimeUs;
+
+        size_t expectedNo = 0;
+        for (size_t i = 0; i < DS18B20_ALARM_DEVICES_NO; ++i)
+        {
+            size_t simIndex = 0;
+            while (0 != memcmp(ds18b20_devices[i].rom, simDevices[simIndex].rom, sizeof(DS18B20_rom_t)))
+            {
+                ++simIndex;
+            }
+            bool marked = alarms[i / DS18B20_ALARM_BITMAP_WORD_BITS] & (1UL << (i % DS18B20_ALARM_BITMAP_WORD_BITS));
+            expectedNo += simDevices[simIndex].alarm;
+            if (marked != simDevices[simIndex].alarm)
+            {
+                ESP_LOGE(TAG, "Round %zu: device %zu alarm %d, expected %d", round, i, marked, simDevices[simIndex].alarm);
+                ++failures;
+            }
+        }
+        if (expectedNo != alarmsNo)
+        {
+            ESP_LOGE(TAG, "Round %zu: %zu alarms found, expected %zu", round, alarmsNo, expectedNo);
+            ++failures;
+        }
+
+        // The same result using one search cycle per call
+        size_t deviceIndex;
+        size_t nextAlarmsNo = 0;
+        ds18b20_sim_reset_stats(&sim);
+        while (DS18B20_OK == ds18b20__FindNextAlarm(&ds18b20_oneWire, &deviceIndex, DS18B20_CHECKSUM))
+        {
+            ++nextAlarmsNo;
+        }
+        if (nextAlarmsNo != alarmsNo)
+        {
+            ESP_LOGE(TAG, "Round %zu: %zu alarms found one by one, %zu in single sweep", round, nextAlarmsNo, alarmsNo);
+            ++failures;
+        }
+        ESP_LOGI(TAG, "Round %zu: %zu alarms, sweep %" PRIu64 " us, one by one %" PRIu64 " us of bus time", round, alarmsNo, sweepUs, sim.stats.busTimeUs);
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Find all alarms test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Find all alarms test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_temperature_convertion_test(void)
+{
+    size_t failures = 0;
+    for (DS18B20_resolution_t resolution = DS18B20_RESOLUTION_09; resolution < DS18B20_RESOLUTION_COUNT; ++resolution)
+    {
+        // Undefined bits for resolution 09 are the lowest three, one less for each higher resolution
+        int16_t undefinedMask = (1 << (DS18B20_RESOLUTION_12 - resolution)) - 1;
+        for (uint16_t code = 0; code < DS18B20_RAW_CODES_NO; ++code)
+        {
+            // Device sign-extends 12-bit temperature into whole register
+            int16_t value = (code & DS18B20_RAW_SIGN_BIT) ? (int16_t) code - DS18B20_RAW_CODES_NO : (int16_t) code;
+            uint8_t msb = (uint16_t) value >> 8;
+            uint8_t lsb = (uint16_t) value & 0xFF;
+            int16_t expected = value & ~undefinedMask;
+
+            DS18B20_temperature_raw_t raw = ds18b20_convert_temperature_bytes_raw(msb, lsb, resolution);
+            if (raw != expected)
+            {
+                ESP_LOGE(TAG, "Raw code 0x%03X (resolution %d): %d, expected %d", code, resolution, raw, expected);
+                ++failures;
+                continue;
+            }
+
+            // Every value is exactly representable as float
+            DS18B20_temperature_out_t celsius = ds18b20_convert_temperature_bytes(msb, lsb, resolution);
+            if (celsius != ds18b20__RawToC(raw) || celsius * 16 != expected)
+            {
+                ESP_LOGE(TAG, "Raw code 0x%03X (resolution %d): %f Celsius, expected %f", code, resolution, celsius, expected / 16.0);
+                ++failures;
+            }
+
+            DS18B20_temperature_milli_t milli = ds18b20__RawToMilliC(raw);
+            DS18B20_temperature_milli_t expectedMilli = (DS18B20_temperature_milli_t) ((double) expected * 62.5);
+            if (milli != expectedMilli)
+            {
+                ESP_LOGE(TAG, "Raw code 0x%03X (resolution %d): %d thousandths of Celsius, expected %d", code, resolution, milli, expectedMilli);
+                ++failures;
+            }
+        }
+    }
+
+    // Whole reading path on simulated bus
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_SIM_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_SIM_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_SIM_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+    static const int16_t temperatures[DS18B20_SIM_DEVICES_NO] = { -880, -1, 0, 2000 };
+    for (size_t i = 0; i < DS18B20_SIM_DEVICES_NO; ++i)
+    {
+        simDevices[i].temperature = temperatures[i];
+    }
+    DS18B20_temperature_raw_t raws[DS18B20_SIM_DEVICES_NO];
+    if (DS18B20_OK != ds18b20__GetTemperaturesRaw(&ds18b20_oneWire, raws, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading raw temperatures.");
+        ++failures;
+    }
+    else
+    {
+        for (size_t i = 0; i < DS18B20_SIM_DEVICES_NO; ++i)
+        {
+            size_t simIndex = 0;
+            while (0 != memcmp(ds18b20_devices[i].rom, simDevices[simIndex].rom, sizeof(DS18B20_rom_t)))
+            {
+                ++simIndex;
+            }
+            if (raws[i] != simDevices[simIndex].temperature)
+            {
+                ESP_LOGE(TAG, "Device %zu: raw temperature %d, expected %d", i, raws[i], simDevices[simIndex].temperature);
+                ++failures;
+            }
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Temperature convertion test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Temperature convertion test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_batch_convertion_benchmark_test(void)
+{
+    static uint8_t msbs[DS18B20_BATCH_READINGS_NO];
+    static uint8_t lsbs[DS18B20_BATCH_READINGS_NO];
+    static DS18B20_temperature_raw_t raws[DS18B20_BATCH_READINGS_NO];
+    static DS18B20_resolution_t resolutions[DS18B20_BATCH_READINGS_NO];
+    static DS18B20_t ds18b20_devices[DS18B20_BATCH_READINGS_NO];
+    static DS18B20_temperature_out_t expected[DS18B20_BATCH_READINGS_NO];
+    static DS18B20_temperature_out_t temperatures[DS18B20_BATCH_READINGS_NO];
+
+    // Whole-bus sweeps of devices with mixed resolutions
+    uint32_t seed = 3;
+    for (size_t i = 0; i < DS18B20_BATCH_READINGS_NO; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint16_t code = (seed >> 8) % DS18B20_RAW_CODES_NO;
+        raws[i] = (code & DS18B20_RAW_SIGN_BIT) ? (int16_t) code - DS18B20_RAW_CODES_NO : (int16_t) code;
+        msbs[i] = (uint16_t) raws[i] >> 8;
+        lsbs[i] = (uint16_t) raws[i] & 0xFF;
+        resolutions[i] = (seed >> 24) % DS18B20_RESOLUTION_COUNT;
+        ds18b20_devices[i].scratchpad[DS18B20_SP_TEMP_MSB_BYTE] = msbs[i];
+        ds18b20_devices[i].scratchpad[DS18B20_SP_TEMP_LSB_BYTE] = lsbs[i];
+        ds18b20_devices[i].resolution = resolutions[i];
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (size_t round = 0; round < DS18B20_BATCH_ROUNDS; ++round)
+    {
+        for (size_t i = 0; i < DS18B20_BATCH_READINGS_NO; ++i)
+        {
+            expected[i] = ds18b20_convert_temperature_bytes(msbs[i], lsbs[i], resolutions[i]);
+        }
+    }
+    int64_t scalarUs = esp_timer_get_time() - start;
+
+    size_t failures = 0;
+    int64_t batchUs[3];
+    static const char * const batchNames[] = { "bytes", "raw", "devices" };
+    for (size_t kernel = 0; kernel < 3; ++kernel)
+    {
+        memset(temperatures, 0, sizeof(temperatures));
+        start = esp_timer_get_time();
+        for (size_t round = 0; round < DS18B20_BATCH_ROUNDS; ++round)
+        {
+            switch (kernel)
+            {
+                case 0:
+                    ds18b20_convert_temperatures_bytes(msbs, lsbs, resolutions, temperatures, DS18B20_BATCH_READINGS_NO);
+                    break;
+                case 1:
+                    ds18b20_convert_temperatures_raw(raws, resolutions, temperatures, DS18B20_BATCH_READINGS_NO);
+                    break;
+                default:
+                    ds18b20_convert_temperatures_devices(ds18b20_devices, temperatures, DS18B20_BATCH_READINGS_NO);
+                    break;
+            }
+        }
+        batchUs[kernel] = esp_timer_get_time() - start;
+
+        for (size_t i = 0; i < DS18B20_BATCH_READINGS_NO; ++i)
+        {
+            if (temperatures[i] != expected[i])
+            {
+                ESP_LOGE(TAG, "Batch %s reading %zu: %f, expected %f", batchNames[kernel], i, temperatures[i], expected[i]);
+                ++failures;
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "Convertion of %d readings x %d: scalar %" PRId64 " us, batch bytes %" PRId64 " us, batch raw %" PRId64 " us, batch devices %" PRId64 " us", 
+        DS18B20_BATCH_READINGS_NO, DS18B20_BATCH_ROUNDS, scalarUs, batchUs[0], batchUs[1], batchUs[2]);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Batch convertion test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Batch convertion test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_storage_test(void)
+{
+    DS18B20_onewire_t arrayOneWire;
+    DS18B20_onewire_t storageOneWire;
+    DS18B20_t ds18b20_devices[DS18B20_STORAGE_DEVICES_NO];
+    DS18B20_storage_t storage;
+    DS18B20_rom_t roms[DS18B20_STORAGE_DEVICES_NO];
+    DS18B20_temperature_raw_t raws[DS18B20_STORAGE_DEVICES_NO];
+    uint8_t flags[DS18B20_STORAGE_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t arraySim;
+    DS18B20_sim_t storageSim;
+    DS18B20_sim_device_t arraySimDevices[DS18B20_STORAGE_DEVICES_NO];
+    DS18B20_sim_device_t storageSimDevices[DS18B20_STORAGE_DEVICES_NO];
+
+    // Both buses have the same devices, the last one is powered parasitically
+    clock.nowUs = 0;
+    for (size_t i = 0; i < DS18B20_STORAGE_DEVICES_NO; ++i)
+    {
+        DS18B20_powermode_t powerMode = (DS18B20_STORAGE_DEVICES_NO - 1 == i) ? DS18B20_PM_PARASITE : DS18B20_PM_EXTERNAL_SUPPLY;
+        int16_t temperature = (int16_t) (i * 0x0123) - 0x0200;
+        ds18b20_sim_init_device(&arraySimDevices[i], DS18B20_SIM_SERIAL + i, powerMode, temperature);
+        ds18b20_sim_init_device(&storageSimDevices[i], DS18B20_SIM_SERIAL + i, powerMode, temperature);
+    }
+    ds18b20_sim_init(&arraySim, &clock, arraySimDevices, DS18B20_STORAGE_DEVICES_NO);
+    ds18b20_sim_init(&storageSim, &clock, storageSimDevices, DS18B20_STORAGE_DEVICES_NO);
+
+    size_t devicesNo;
+    if (DS18B20_OK != ds18b20__InitOneWireWithTransport(&arrayOneWire, &ds18b20_sim_transport, &arraySim, ds18b20_devices, DS18B20_STORAGE_DEVICES_NO, DS18B20_CHECKSUM)
+        || DS18B20_OK != ds18b20__InitStorage(&storage, roms, raws, flags)
+        || DS18B20_OK != ds18b20__DiscoverOneWireWithStorage(&storageOneWire, &ds18b20_sim_transport, &storageSim, &storage, 
+                                                                DS18B20_STORAGE_DEVICES_NO, DS18B20_SIM_FAMILY_CODE, &devicesNo, DS18B20_CHECKSUM)
+        || DS18B20_STORAGE_DEVICES_NO != devicesNo)
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire drivers on simulated buses.");
+        return;
+    }
+
+    size_t failures = 0;
+    for (size_t i = 0; i < DS18B20_STORAGE_DEVICES_NO; ++i)
+    {
+        DS18B20_config_t config =
+        {
+            .upperAlarm = DS18B20_UPPER_ALARM,
+            .lowerAlarm = DS18B20_LOWER_ALARM,
+            .resolution = i % DS18B20_RESOLUTION_COUNT
+        };
+        if (DS18B20_OK != ds18b20__Configure(&arrayOneWire, i, &config, DS18B20_CHECKSUM)
+            || DS18B20_OK != ds18b20__Configure(&storageOneWire, i, &config, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while configuring device %zu.", i);
+            ++failures;
+        }
+    }
+
+    DS18B20_temperature_out_t arrayTemperatures[DS18B20_STORAGE_DEVICES_NO];
+    DS18B20_temperature_out_t storageTemperatures[DS18B20_STORAGE_DEVICES_NO];
+    if (DS18B20_OK != ds18b20__GetTemperaturesC(&arrayOneWire, arrayTemperatures, DS18B20_CHECKSUM)
+        || DS18B20_OK != ds18b20__GetTemperaturesC(&storageOneWire, storageTemperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperatures.");
+        ++failures;
+    }
+
+    for (size_t i = 0; i < DS18B20_STORAGE_DEVICES_NO; ++i)
+    {
+        DS18B20_t view;
+        size_t deviceIndex;
+        if (DS18B20_OK != ds18b20__GetDeviceView(&storageOneWire, i, &view)
+            || DS18B20_OK != ds18b20__FindDeviceByRom(&storageOneWire, view.rom, &deviceIndex) || i != deviceIndex)
+        {
+            ESP_LOGE(TAG, "Failure while accessing device %zu in storage.", i);
+            ++failures;
+            continue;
+        }
+        if (arrayTemperatures[i] != storageTemperatures[i]
+            || 0 != memcmp(view.rom, ds18b20_devices[i].rom, sizeof(DS18B20_rom_t))
+            || view.resolution != ds18b20_devices[i].resolution
+            || view.powerMode != ds18b20_devices[i].powerMode
+            || view.scratchpad[DS18B20_SP_CONFIG_BYTE] != ds18b20_devices[i].scratchpad[DS18B20_SP_CONFIG_BYTE]
+            || ds18b20_convert_temperature_bytes(view.scratchpad[DS18B20_SP_TEMP_MSB_BYTE], view.scratchpad[DS18B20_SP_TEMP_LSB_BYTE], view.resolution) != arrayTemperatures[i])
+        {
+            ESP_LOGE(TAG, "Device %zu differs: %f Celsius in array, %f Celsius in storage", i, arrayTemperatures[i], storageTemperatures[i]);
+            ++failures;
+        }
+    }
+
+    ESP_LOGI(TAG, "RAM per device: %zu bytes in array, %zu bytes in storage (%d devices: %zu and %zu bytes)", 
+        sizeof(DS18B20_t), DS18B20_STORAGE_BYTES_PER_DEVICE, DS18B20_STORAGE_REPORT_DEVICES,
+        DS18B20_STORAGE_REPORT_DEVICES * sizeof(DS18B20_t), DS18B20_STORAGE_REPORT_DEVICES * DS18B20_STORAGE_BYTES_PER_DEVICE + sizeof(DS18B20_storage_t));
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Storage test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Storage test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_adaptive_integrity_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_INTEGRITY_DEVICES_NO];
+    static DS18B20_integrity_state_t states[DS18B20_INTEGRITY_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_INTEGRITY_DEVICES_NO];
+    static DS18B20_temperature_raw_t accepted[DS18B20_INTEGRITY_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_INTEGRITY_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    DS18B20_integrity_t integrity;
+    ds18b20__InitIntegrityDefault(&integrity);
+
+    size_t failures = 0;
+    static const char * const modeNames[DS18B20_INTEGRITY_MODES_NO] = { "always CRC", "adaptive" };
+    for (size_t mode = 0; mode < DS18B20_INTEGRITY_MODES_NO; ++mode)
+    {
+        bool adaptive = 1 == mode;
+        if (adaptive && DS18B20_OK != ds18b20__EnableAdaptiveIntegrity(&ds18b20_oneWire, &integrity, states, DS18B20_INTEGRITY_DEVICES_NO))
+        {
+            ESP_LOGE(TAG, "Failure while enabling adaptive integrity mode.");
+            ++failures;
+            continue;
+        }
+
+        // Both modes see the same temperatures and the same noise
+        uint32_t readSlots = 0;
+        size_t detected = 0;
+        size_t undetected = 0;
+        sim.seed = 1;
+        sim.readFaultPeriod = DS18B20_INTEGRITY_FAULT_PERIOD;
+        ds18b20_sim_reset_stats(&sim);
+        for (size_t round = 0; round < DS18B20_INTEGRITY_ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < DS18B20_INTEGRITY_DEVICES_NO; ++i)
+            {
+                simDevices[i].temperature = DS18B20_SIM_TEMPERATURE + i * 4 + round * 3;
+            }
+            // Brownout of one device - it reports power-on reset value
+            if (DS18B20_INTEGRITY_ROUNDS / 2 == round)
+            {
+                simDevices[0].temperature = DS18B20_SP_TEMP_DEFAULT_VALUE;
+            }
+
+            DS18B20_convertion_t convertion;
+            if (DS18B20_OK != ds18b20__StartTemperaturesC(&ds18b20_oneWire, &convertion))
+            {
+                ESP_LOGE(TAG, "Failure while starting temperature convertion.");
+                ++failures;
+                continue;
+            }
+            clock.nowUs += DS18B20_SIM_CONVERTION_US;
+
+            uint32_t startSlots = sim.stats.readSlots;
+            for (size_t i = 0; i < DS18B20_INTEGRITY_DEVICES_NO; ++i)
+            {
+                DS18B20_temperature_raw_t raw;
+                DS18B20_error_t status = ds18b20__CollectTemperatureRaw(&ds18b20_oneWire, i, &convertion, &raw, !adaptive);
+                if (DS18B20_OK != status)
+                {
+                    ++detected;
+                    continue;
+                }
+
+                size_t simIndex = 0;
+                while (0 != memcmp(ds18b20_devices[i].rom, simDevices[simIndex].rom, sizeof(DS18B20_rom_t)))
+                {
+                    ++simIndex;
+                }
+                // Corrupted value can slip through only short read after the first one, if it is plausible change of the previous value
+                int32_t change = (int32_t) raw - accepted[i];
+                bool plausible = adaptive && round && change <= integrity.maxChange && change >= -integrity.maxChange;
+                if (raw != simDevices[simIndex].temperature)
+                {
+                    ++undetected;
+                    if (!plausible)
+                    {
+                        ESP_LOGE(TAG, "%s round %zu device %zu: %d accepted after %d, expected %d", 
+                            modeNames[mode], round, i, raw, accepted[i], simDevices[simIndex].temperature);
+                        ++failures;
+                    }
+                }
+                accepted[i] = raw;
+            }
+            readSlots += sim.stats.readSlots - startSlots;
+
+            if (adaptive && DS18B20_INTEGRITY_ROUNDS / 2 == round)
+            {
+                size_t deviceIndex;
+                ds18b20__FindDeviceByRom(&ds18b20_oneWire, simDevices[0].rom, &deviceIndex);
+                if (integrity.escalationReads - 1 != states[deviceIndex].fullReadsLeft)
+                {
+                    ESP_LOGE(TAG, "Power-on reset value did not escalate integrity of device %zu.", deviceIndex);
+                    ++failures;
+                }
+            }
+        }
+        sim.readFaultPeriod = 0;
+
+        ESP_LOGI(TAG, "Reading %d devices x %d (%s): %" PRIu32 " read slots, %" PRIu32 " faults injected, %zu failed reads, %zu corrupted values accepted within plausible change", 
+            DS18B20_INTEGRITY_DEVICES_NO, DS18B20_INTEGRITY_ROUNDS, modeNames[mode], readSlots, sim.stats.readFaults, detected, undetected);
+    }
+    ds18b20__DisableAdaptiveIntegrity(&ds18b20_oneWire);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Adaptive integrity test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Adaptive integrity test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Finds index of simulated device matching the device handled by the driver.
+ * 
+ * @param devices Devices handled by the driver
+ * @param simDevices Simulated devices
+ * @param deviceIndex Index of the device handled by the driver
+ * @return size_t Index of the simulated device
+ */
+static size_t ds18b20_sim_index(const DS18B20_t * const devices, const DS18B20_sim_device_t * const simDevices, const size_t deviceIndex)
+{
+    size_t simIndex = 0;
+    while (0 != memcmp(devices[deviceIndex].rom, simDevices[simIndex].rom, sizeof(DS18B20_rom_t)))
+    {
+        ++simIndex;
+    }
+
+    return simIndex;
+}
+
+/**
+ * @brief Describes simulated task preemption right after the convertion has started.
+ * 
+ */
+static struct
+{
+    DS18B20_sim_clock_t *clock; /**< Clock of the simulated bus */
+    uint32_t preemptionMs; /**< Time for which the task is preempted */
+    bool pending; /**< Indicates if strong pullup has been started and the task is about to be preempted */
+    uint64_t pullupStartUs; /**< Time when strong pullup has been started */
+    uint64_t pullupUs; /**< Duration of the last strong pullup */
+} ds18b20_preemption;
+
+static void ds18b20_preemption_start_pullup(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_sim_transport.start_pullup(onewire);
+    ds18b20_preemption.pending = true;
+    ds18b20_preemption.pullupStartUs = ds18b20_preemption.clock->nowUs;
+}
+
+static void ds18b20_preemption_end_pullup(const DS18B20_onewire_t * const onewire)
+{
+    ds18b20_sim_transport.end_pullup(onewire);
+    ds18b20_preemption.pullupUs = ds18b20_preemption.clock->nowUs - ds18b20_preemption.pullupStartUs;
+}
+
+/**
+ * @brief Returns simulated time, the first call after strong pullup has started (taking start time of the convertion) is followed by preemption.
+ * 
+ */
+static uint32_t ds18b20_preemption_get_millis(const DS18B20_onewire_t * const onewire)
+{
+    uint32_t nowMs = ds18b20_sim_transport.get_millis(onewire);
+    if (ds18b20_preemption.pending)
+    {
+        ds18b20_preemption.pending = false;
+        ds18b20_preemption.clock->nowUs += ds18b20_preemption.preemptionMs * 1000ULL;
+    }
+
+    return nowMs;
+}
+
+void ds18b20_convertion_learning_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_LEARNING_DEVICES_NO];
+    DS18B20_timing_state_t states[DS18B20_LEARNING_DEVICES_NO + 1];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_LEARNING_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_LEARNING_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    size_t failures = 0;
+    size_t simIndices[DS18B20_LEARNING_DEVICES_NO];
+    for (size_t i = 0; i < DS18B20_LEARNING_DEVICES_NO; ++i)
+    {
+        simIndices[i] = ds18b20_sim_index(ds18b20_devices, simDevices, i);
+        simDevices[simIndices[i]].convertionUs = DS18B20_LEARNING_CONVERTION_US + i * DS18B20_LEARNING_SPREAD_US;
+        simDevices[simIndices[i]].jitterUs = DS18B20_LEARNING_JITTER_US;
+    }
+
+    // Single device convertions - worst case waits, status checks every 10 ms and learned convertion time
+    static const char * const modeNames[DS18B20_LEARNING_MODES_NO] = { "worst case", "10 ms checks", "learned" };
+    for (size_t mode = 0; mode < DS18B20_LEARNING_MODES_NO; ++mode)
+    {
+        if (2 == mode && DS18B20_OK != ds18b20__EnableConvertionLearning(&ds18b20_oneWire, states, DS18B20_LEARNING_DEVICES_NO + 1, DS18B20_LEARNING_MARGIN_MS))
+        {
+            ESP_LOGE(TAG, "Failure while enabling learning of convertion time.");
+            ++failures;
+            continue;
+        }
+
+        sim.seed = 1;
+        uint64_t start = clock.nowUs;
+        for (size_t round = 0; round < DS18B20_LEARNING_ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < DS18B20_LEARNING_DEVICES_NO; ++i)
+            {
+                // Every convertion measures a new temperature, so reading too early returns the previous one
+                simDevices[simIndices[i]].temperature = DS18B20_SIM_TEMPERATURE + i + round * 2;
+                DS18B20_temperature_raw_t raw;
+                DS18B20_error_t status = 1 == mode
+                    ? ds18b20__GetTemperatureRawWithChecking(&ds18b20_oneWire, i, &raw, DS18B20_CHECK_PERIOD_MIN_MS, DS18B20_CHECKSUM)
+                    : ds18b20__GetTemperatureRaw(&ds18b20_oneWire, i, &raw, DS18B20_CHECKSUM);
+                if (DS18B20_OK != status || simDevices[simIndices[i]].temperature != raw)
+                {
+                    ESP_LOGE(TAG, "%s round %zu device %zu: %d read, expected %d", modeNames[mode], round, i, raw, simDevices[simIndices[i]].temperature);
+                    ++failures;
+                }
+            }
+        }
+        ESP_LOGI(TAG, "Reading %d devices x %d one by one (%s): %" PRIu64 " ms in total", 
+            DS18B20_LEARNING_DEVICES_NO, DS18B20_LEARNING_ROUNDS, modeNames[mode], (clock.nowUs - start) / 1000);
+    }
+
+    // Learned time follows the real convertion time of each device within its jitter and polling precision
+    for (size_t i = 0; i < DS18B20_LEARNING_DEVICES_NO; ++i)
+    {
+        uint32_t convertionUs = simDevices[simIndices[i]].convertionUs;
+        ESP_LOGI(TAG, "Device %zu: convertion %" PRIu32 "-%" PRIu32 " us, learned %" PRIu32 " +/- %" PRIu32 " us", i, 
+            convertionUs, convertionUs + DS18B20_LEARNING_JITTER_US, states[i].meanUs, states[i].deviationUs);
+        if (DS18B20_LEARNING_ROUNDS != states[i].samples || states[i].meanUs < convertionUs 
+            || states[i].meanUs > convertionUs + DS18B20_LEARNING_JITTER_US + 2 * DS18B20_TIMING_POLL_US)
+        {
+            ESP_LOGE(TAG, "Learned convertion time of device %zu is off.", i);
+            ++failures;
+        }
+    }
+
+    // All devices at once - the slowest one decides
+    DS18B20_temperature_raw_t temperatures[DS18B20_LEARNING_DEVICES_NO];
+    uint64_t start = clock.nowUs;
+    for (size_t round = 0; round < DS18B20_LEARNING_ROUNDS; ++round)
+    {
+        for (size_t i = 0; i < DS18B20_LEARNING_DEVICES_NO; ++i)
+        {
+            simDevices[simIndices[i]].temperature = DS18B20_SIM_TEMPERATURE - i - round * 2;
+        }
+        if (DS18B20_OK != ds18b20__GetTemperaturesRaw(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while reading temperatures in round %zu.", round);
+            ++failures;
+            continue;
+        }
+        for (size_t i = 0; i < DS18B20_LEARNING_DEVICES_NO; ++i)
+        {
+            if (simDevices[simIndices[i]].temperature != temperatures[i])
+            {
+                ESP_LOGE(TAG, "Broadcast round %zu device %zu: %d read, expected %d", round, i, temperatures[i], simDevices[simIndices[i]].temperature);
+                ++failures;
+            }
+        }
+    }
+    const DS18B20_timing_state_t *busTiming = &states[DS18B20_LEARNING_DEVICES_NO];
+    uint32_t slowestUs = DS18B20_LEARNING_CONVERTION_US + (DS18B20_LEARNING_DEVICES_NO - 1) * DS18B20_LEARNING_SPREAD_US;
+    ESP_LOGI(TAG, "Reading %d devices x %d at once (learned %" PRIu32 " +/- %" PRIu32 " us): %" PRIu64 " ms in total", 
+        DS18B20_LEARNING_DEVICES_NO, DS18B20_LEARNING_ROUNDS, busTiming->meanUs, busTiming->deviationUs, (clock.nowUs - start) / 1000);
+    if (DS18B20_LEARNING_ROUNDS != busTiming->samples || busTiming->meanUs < slowestUs 
+        || busTiming->meanUs > slowestUs + DS18B20_LEARNING_JITTER_US + 2 * DS18B20_TIMING_POLL_US)
+    {
+        ESP_LOGE(TAG, "Learned convertion time of all devices is off.");
+        ++failures;
+    }
+
+    // Parasite power - time learned with external supply shortens strong pullup
+    sim.seed = 1;
+    ds18b20_sim_reset_stats(&sim);
+    simDevices[simIndices[0]].powerMode = DS18B20_PM_PARASITE;
+    ds18b20_device_set_powermode(&ds18b20_oneWire, 0, DS18B20_PM_PARASITE);
+    start = clock.nowUs;
+    for (size_t round = 0; round < DS18B20_LEARNING_ROUNDS; ++round)
+    {
+        simDevices[simIndices[0]].temperature = DS18B20_SIM_TEMPERATURE + round;
+        DS18B20_temperature_raw_t raw;
+        if (DS18B20_OK != ds18b20__GetTemperatureRaw(&ds18b20_oneWire, 0, &raw, DS18B20_CHECKSUM) || simDevices[simIndices[0]].temperature != raw)
+        {
+            ESP_LOGE(TAG, "Parasite round %zu: %d read, expected %d", round, raw, simDevices[simIndices[0]].temperature);
+            ++failures;
+        }
+    }
+    uint64_t parasiteUs = clock.nowUs - start;
+    if (DS18B20_OK != ds18b20__GetTemperaturesRaw(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperatures with parasite device.");
+        ++failures;
+    }
+    ESP_LOGI(TAG, "Reading parasite device x %d: %" PRIu64 " ms in total, %" PRIu32 " broken convertions", 
+        DS18B20_LEARNING_ROUNDS, parasiteUs / 1000, sim.stats.parasiteFailures);
+    if (sim.stats.parasiteFailures || parasiteUs >= (uint64_t) DS18B20_LEARNING_ROUNDS * DS18B20_RESOLUTION_12_DELAY_MS * 1000)
+    {
+        ESP_LOGE(TAG, "Strong pullup has not been shortened safely.");
+        ++failures;
+    }
+
+    // Task preempted right after the start does not extend strong pullup beyond the deadline
+    DS18B20_transport_t preemptingTransport = ds18b20_sim_transport;
+    preemptingTransport.start_pullup = ds18b20_preemption_start_pullup;
+    preemptingTransport.end_pullup = ds18b20_preemption_end_pullup;
+    preemptingTransport.get_millis = ds18b20_preemption_get_millis;
+    ds18b20_oneWire.transport = &preemptingTransport;
+    ds18b20_preemption.clock = &clock;
+    uint64_t pullupUs[2];
+    for (size_t preempted = 0; preempted < 2; ++preempted)
+    {
+        ds18b20_preemption.preemptionMs = preempted ? DS18B20_LEARNING_PREEMPTION_MS : 0;
+        DS18B20_temperature_raw_t raw;
+        if (DS18B20_OK != ds18b20__GetTemperatureRaw(&ds18b20_oneWire, 0, &raw, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while reading parasite device (preemption %" PRIu32 " ms).", ds18b20_preemption.preemptionMs);
+            ++failures;
+        }
+        pullupUs[preempted] = ds18b20_preemption.pullupUs;
+    }
+    ds18b20_oneWire.transport = &ds18b20_sim_transport;
+    ESP_LOGI(TAG, "Strong pullup: %" PRIu64 " us, %" PRIu64 " us with %d ms preemption", pullupUs[0], pullupUs[1], DS18B20_LEARNING_PREEMPTION_MS);
+    if (pullupUs[1] > pullupUs[0] + DS18B20_TIMING_POLL_US)
+    {
+        ESP_LOGE(TAG, "Strong pullup has been extended by preemption.");
+        ++failures;
+    }
+    ds18b20__DisableConvertionLearning(&ds18b20_oneWire);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Convertion learning test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Convertion learning test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Returns temperature of simulated trace - steady with slight flicker, fast ramp and steady again.
+ * 
+ * @param round Number of the reading
+ * @return int16_t Temperature (in 1/16 Celsius)
+ */
+static int16_t ds18b20_resolution_trace(const size_t round)
+{
+    int16_t flicker = 0 == round % 3;
+    if (round < DS18B20_RESOLUTION_RAMP_START)
+    {
+        return DS18B20_SIM_TEMPERATURE + flicker;
+    }
+    if (round < DS18B20_RESOLUTION_RAMP_END)
+    {
+        return DS18B20_SIM_TEMPERATURE + (round - DS18B20_RESOLUTION_RAMP_START + 1) * DS18B20_RESOLUTION_RAMP_STEP;
+    }
+
+    return DS18B20_SIM_TEMPERATURE + (DS18B20_RESOLUTION_RAMP_END - DS18B20_RESOLUTION_RAMP_START) * DS18B20_RESOLUTION_RAMP_STEP + flicker;
+}
+
+void ds18b20_adaptive_resolution_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_RESOLUTION_DEVICES_NO];
+    DS18B20_resolution_state_t states[DS18B20_RESOLUTION_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_RESOLUTION_DEVICES_NO];
+
+    DS18B20_resolution_policy_t policies[DS18B20_RESOLUTION_POLICIES_NO];
+    static const char * const policyNames[DS18B20_RESOLUTION_POLICIES_NO] = { "default", "latency", "precision" };
+    for (size_t policy = 0; policy < DS18B20_RESOLUTION_POLICIES_NO; ++policy)
+    {
+        ds18b20__InitResolutionPolicyDefault(&policies[policy]);
+    }
+    policies[1].maxConvertionMs = DS18B20_RESOLUTION_LATENCY_MS;
+    policies[2].minResolution = DS18B20_RESOLUTION_11;
+
+    size_t failures = 0;
+    for (size_t policy = 0; policy < DS18B20_RESOLUTION_POLICIES_NO; ++policy)
+    {
+        if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_RESOLUTION_DEVICES_NO)
+            || DS18B20_OK != ds18b20__EnableAdaptiveResolution(&ds18b20_oneWire, &policies[policy], states, DS18B20_RESOLUTION_DEVICES_NO))
+        {
+            ESP_LOGE(TAG, "Failure while initializing adaptive resolution on simulated bus.");
+            ++failures;
+            continue;
+        }
+
+        // Only the first device follows the trace, the second one stays steady
+        size_t simIndices[DS18B20_RESOLUTION_DEVICES_NO];
+        DS18B20_resolution_t previous[DS18B20_RESOLUTION_DEVICES_NO];
+        for (size_t i = 0; i < DS18B20_RESOLUTION_DEVICES_NO; ++i)
+        {
+            simIndices[i] = ds18b20_sim_index(ds18b20_devices, simDevices, i);
+            previous[i] = ds18b20_devices[i].resolution;
+        }
+
+        ds18b20_sim_reset_stats(&sim);
+        uint64_t start = clock.nowUs;
+        size_t changes = 0;
+        DS18B20_resolution_t used[DS18B20_RESOLUTION_DEVICES_NO][DS18B20_RESOLUTION_ROUNDS];
+        for (size_t round = 0; round < DS18B20_RESOLUTION_ROUNDS; ++round)
+        {
+            simDevices[simIndices[0]].temperature = ds18b20_resolution_trace(round);
+            for (size_t i = 0; i < DS18B20_RESOLUTION_DEVICES_NO; ++i)
+            {
+                DS18B20_temperature_raw_t raw;
+                if (DS18B20_OK != ds18b20__GetTemperatureRaw(&ds18b20_oneWire, i, &raw, DS18B20_CHECKSUM))
+                {
+                    ESP_LOGE(TAG, "Failure while reading temperature of device %zu in round %zu.", i, round);
+                    ++failures;
+                    continue;
+                }
+
+                // Resolution used by the device must be the one known by the driver
+                used[i][round] = ds18b20_config_byte_to_resolution(simDevices[simIndices[i]].scratchpad[DS18B20_SP_CONFIG_BYTE]);
+                int16_t expected = simDevices[simIndices[i]].temperature & ~((1 << (DS18B20_RESOLUTION_12 - used[i][round])) - 1);
+                if (used[i][round] != ds18b20_devices[i].resolution || expected != raw)
+                {
+                    ESP_LOGE(TAG, "%s round %zu device %zu: %d read at resolution %d, expected %d at resolution %d", 
+                        policyNames[policy], round, i, raw, ds18b20_devices[i].resolution, expected, used[i][round]);
+                    ++failures;
+                }
+                changes += used[i][round] != previous[i];
+                previous[i] = used[i][round];
+                if (used[i][round] < policies[policy].minResolution 
+                    || ds18b20_millis_to_wait_for_convertion(used[i][round]) > policies[policy].maxConvertionMs)
+                {
+                    ESP_LOGE(TAG, "%s round %zu device %zu: resolution %d breaks the policy", policyNames[policy], round, i, used[i][round]);
+                    ++failures;
+                }
+            }
+        }
+
+        // Fast ramp is followed with the lowest resolution allowed, steady readings with the highest one
+        DS18B20_resolution_t highest = ds18b20_devices[1].resolution;
+        DS18B20_resolution_t lowest = 1 == policy ? DS18B20_RESOLUTION_09 : policies[policy].minResolution;
+        if (highest != used[0][DS18B20_RESOLUTION_RAMP_START - 1] || lowest != used[0][DS18B20_RESOLUTION_RAMP_END - 1] 
+            || highest != used[0][DS18B20_RESOLUTION_ROUNDS - 1])
+        {
+            ESP_LOGE(TAG, "%s: resolution %d before ramp, %d at its end and %d after it", policyNames[policy], 
+                used[0][DS18B20_RESOLUTION_RAMP_START - 1], used[0][DS18B20_RESOLUTION_RAMP_END - 1], used[0][DS18B20_RESOLUTION_ROUNDS - 1]);
+            ++failures;
+        }
+        for (size_t round = 1; round < DS18B20_RESOLUTION_ROUNDS; ++round)
+        {
+            if (highest != used[1][round])
+            {
+                ESP_LOGE(TAG, "%s round %zu: resolution of steady device changed to %d", policyNames[policy], round, used[1][round]);
+                ++failures;
+            }
+        }
+        // Configuration is written only when resolution changes
+        if (changes != sim.stats.scratchpadWrites)
+        {
+            ESP_LOGE(TAG, "%s: %zu resolution changes, but %" PRIu32 " scratchpad writes", policyNames[policy], changes, sim.stats.scratchpadWrites);
+            ++failures;
+        }
+
+        ESP_LOGI(TAG, "Trace of %d readings x %d devices (%s policy): %" PRIu64 " ms in total, %zu resolution changes", 
+            DS18B20_RESOLUTION_ROUNDS, DS18B20_RESOLUTION_DEVICES_NO, policyNames[policy], (clock.nowUs - start) / 1000, changes);
+        ds18b20__DisableAdaptiveResolution(&ds18b20_oneWire);
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Adaptive resolution test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Adaptive resolution test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_broadcast_configuration_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_BROADCAST_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_BROADCAST_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_BROADCAST_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+    // The last device needs strong pullup while copying into EEPROM
+    size_t parasiteIndex = ds18b20_sim_index(ds18b20_devices, simDevices, DS18B20_BROADCAST_DEVICES_NO - 1);
+    simDevices[parasiteIndex].powerMode = DS18B20_PM_PARASITE;
+    ds18b20_device_set_powermode(&ds18b20_oneWire, DS18B20_BROADCAST_DEVICES_NO - 1, DS18B20_PM_PARASITE);
+
+    DS18B20_config_t configs[DS18B20_BROADCAST_MODES_NO] =
+    {
+        { .upperAlarm = 30, .lowerAlarm = 10, .resolution = DS18B20_RESOLUTION_10 },
+        { .upperAlarm = 50, .lowerAlarm = -10, .resolution = DS18B20_RESOLUTION_11 }
+    };
+    static const char * const modeNames[DS18B20_BROADCAST_MODES_NO] = { "one by one", "broadcast" };
+
+    size_t failures = 0;
+    for (size_t mode = 0; mode < DS18B20_BROADCAST_MODES_NO; ++mode)
+    {
+        const DS18B20_config_t * const config = &configs[mode];
+        ds18b20_sim_reset_stats(&sim);
+        uint64_t start = clock.nowUs;
+        DS18B20_error_t status = DS18B20_OK;
+        if (0 == mode)
+        {
+            for (size_t i = 0; i < DS18B20_BROADCAST_DEVICES_NO && DS18B20_OK == status; ++i)
+            {
+                status = ds18b20__Configure(&ds18b20_oneWire, i, config, !DS18B20_CHECKSUM);
+                if (DS18B20_OK == status)
+                {
+                    status = ds18b20__StoreRegisters(&ds18b20_oneWire, i);
+                }
+            }
+        }
+        else
+        {
+            status = ds18b20__ConfigureAll(&ds18b20_oneWire, config, !DS18B20_CHECKSUM);
+            if (DS18B20_OK == status)
+            {
+                status = ds18b20__StoreRegistersAll(&ds18b20_oneWire);
+            }
+        }
+        if (DS18B20_OK != status)
+        {
+            ESP_LOGE(TAG, "Failure while provisioning devices %s (status %d).", modeNames[mode], status);
+            ++failures;
+        }
+
+        ESP_LOGI(TAG, "Provisioning %d devices %s: %" PRIu64 " us of bus time, %" PRIu64 " us in total, %" PRIu32 " EEPROM writes", 
+            DS18B20_BROADCAST_DEVICES_NO, modeNames[mode], sim.stats.busTimeUs, clock.nowUs - start, sim.stats.eepromWrites);
+        if (DS18B20_BROADCAST_DEVICES_NO != sim.stats.eepromWrites || sim.stats.parasiteFailures)
+        {
+            ESP_LOGE(TAG, "%s: %" PRIu32 " EEPROM writes, %" PRIu32 " broken by missing pullup", modeNames[mode], sim.stats.eepromWrites, sim.stats.parasiteFailures);
+            ++failures;
+        }
+        for (size_t i = 0; i < DS18B20_BROADCAST_DEVICES_NO; ++i)
+        {
+            const DS18B20_sim_device_t * const simDevice = &simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, i)];
+            if ((uint8_t) config->upperAlarm != simDevice->eeprom[0] || (uint8_t) config->lowerAlarm != simDevice->eeprom[1]
+                || config->resolution != ds18b20_config_byte_to_resolution(simDevice->eeprom[2]) || config->resolution != ds18b20_devices[i].resolution)
+            {
+                ESP_LOGE(TAG, "%s: device %zu has not been provisioned.", modeNames[mode], i);
+                ++failures;
+            }
+        }
+    }
+
+    // Changes which have not been stored are dropped by restoring EEPROM
+    if (DS18B20_OK != ds18b20__ConfigureAll(&ds18b20_oneWire, &configs[0], DS18B20_CHECKSUM)
+        || DS18B20_OK != ds18b20__RestoreRegistersAll(&ds18b20_oneWire, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while restoring configuration of all devices.");
+        ++failures;
+    }
+    for (size_t i = 0; i < DS18B20_BROADCAST_DEVICES_NO; ++i)
+    {
+        if (configs[1].resolution != ds18b20_devices[i].resolution 
+            || (uint8_t) configs[1].upperAlarm != ds18b20_devices[i].scratchpad[DS18B20_SP_TEMP_HIGH_BYTE])
+        {
+            ESP_LOGE(TAG, "Configuration of device %zu has not been restored.", i);
+            ++failures;
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Broadcast configuration test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Broadcast configuration test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Checks if simulated device is handled by One-Wire bus instance.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param simDevice Pointer to simulated device
+ * @return bool True if ROM address of the device has been discovered
+ */
+static bool ds18b20_partial_is_handled(const DS18B20_onewire_t * const onewire, const DS18B20_sim_device_t * const simDevice)
+{
+    for (size_t i = 0; i < onewire->devicesNo; ++i)
+    {
+        if (0 == memcmp(onewire->devices[i].rom, simDevice->rom, sizeof(DS18B20_rom_t)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ds18b20_partial_bus_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_PARTIAL_CAPACITY];
+    DS18B20_sim_clock_t clock = { 0 };
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_PARTIAL_DEVICES_NO];
+    DS18B20_sim_device_t untouched[DS18B20_PARTIAL_DEVICES_NO];
+
+    // Device of other family and DS18B20 above the capacity share the bus with handled devices
+    for (size_t i = 0; i < DS18B20_PARTIAL_DEVICES_NO; ++i)
+    {
+        ds18b20_sim_init_device(&simDevices[i], DS18B20_SIM_SERIAL + i, DS18B20_PM_EXTERNAL_SUPPLY, DS18B20_SIM_TEMPERATURE);
+    }
+    ds18b20_sim_set_family(&simDevices[0], DS18B20_FOREIGN_FAMILY_CODE);
+    simDevices[0].powerMode = DS18B20_PM_PARASITE;
+    ds18b20_sim_init(&sim, &clock, simDevices, DS18B20_PARTIAL_DEVICES_NO);
+
+    size_t devicesNo;
+    if (DS18B20_OK != ds18b20__DiscoverOneWireWithTransport(&ds18b20_oneWire, &ds18b20_sim_transport, &sim, 
+        ds18b20_devices, DS18B20_PARTIAL_CAPACITY, DS18B20_SIM_FAMILY_CODE, &devicesNo, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while discovering devices on simulated bus.");
+        return;
+    }
+
+    // Scratchpads of not handled devices differ from their EEPROM, so recalling it would be noticed too
+    for (size_t i = 0; i < DS18B20_PARTIAL_DEVICES_NO; ++i)
+    {
+        if (!ds18b20_partial_is_handled(&ds18b20_oneWire, &simDevices[i]))
+        {
+            simDevices[i].scratchpad[DS18B20_SP_TEMP_HIGH_BYTE] = DS18B20_PARTIAL_UPPER_ALARM;
+        }
+    }
+    memcpy(untouched, simDevices, sizeof(untouched));
+
+    const DS18B20_config_t config = { .upperAlarm = 40, .lowerAlarm = 0, .resolution = DS18B20_RESOLUTION_10 };
+    size_t failures = 0;
+    ds18b20_sim_reset_stats(&sim);
+    if (DS18B20_OK != ds18b20__ConfigureAll(&ds18b20_oneWire, &config, DS18B20_CHECKSUM)
+        || DS18B20_OK != ds18b20__StoreRegistersAll(&ds18b20_oneWire)
+        || DS18B20_OK != ds18b20__RestoreRegistersAll(&ds18b20_oneWire, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while provisioning handled devices.");
+        ++failures;
+    }
+
+    ESP_LOGI(TAG, "%zu of %d devices handled: %" PRIu32 " EEPROM writes", ds18b20_oneWire.devicesNo, DS18B20_PARTIAL_DEVICES_NO, sim.stats.eepromWrites);
+    if (DS18B20_PARTIAL_CAPACITY != sim.stats.eepromWrites)
+    {
+        ESP_LOGE(TAG, "%" PRIu32 " EEPROM writes instead of %d.", sim.stats.eepromWrites, DS18B20_PARTIAL_CAPACITY);
+        ++failures;
+    }
+    for (size_t i = 0; i < DS18B20_PARTIAL_DEVICES_NO; ++i)
+    {
+        const DS18B20_sim_device_t * const simDevice = &simDevices[i];
+        if (ds18b20_partial_is_handled(&ds18b20_oneWire, simDevice))
+        {
+            if ((uint8_t) config.upperAlarm != simDevice->eeprom[0] || config.resolution != ds18b20_config_byte_to_resolution(simDevice->scratchpad[DS18B20_SP_CONFIG_BYTE]))
+            {
+                ESP_LOGE(TAG, "Handled device %zu has not been provisioned.", i);
+                ++failures;
+            }
+        }
+        else if (0 != memcmp(simDevice->scratchpad, untouched[i].scratchpad, sizeof(DS18B20_scratchpad_t))
+            || 0 != memcmp(simDevice->eeprom, untouched[i].eeprom, sizeof(simDevice->eeprom)))
+        {
+            ESP_LOGE(TAG, "Device %zu not handled by the driver has been modified.", i);
+            ++failures;
+        }
+    }
+
+    // Convertion is broadcast to all devices, so parasite powered device not handled by the driver needs strong pullup too
+    DS18B20_temperature_out_t temperatures[DS18B20_PARTIAL_CAPACITY];
+    ds18b20_sim_reset_stats(&sim);
+    if (DS18B20_OK != ds18b20__GetTemperaturesC(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM) || sim.stats.parasiteFailures)
+    {
+        ESP_LOGE(TAG, "Broadcast convertion has not powered all devices (%" PRIu32 " failures).", sim.stats.parasiteFailures);
+        ++failures;
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Partial bus test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Partial bus test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Configures all devices one by one and stores their configuration, counting resulting writes on simulated bus.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param sim Pointer to simulated bus instance
+ * @param configs Array of configurations (one per each device)
+ * @param devicesNo Number of devices
+ * @param name Name of the step used in logs
+ * @param scratchpadWrites Expected number of scratchpad writes
+ * @param eepromWrites Expected number of EEPROM writes
+ * @return size_t Number of failures
+ */
+static size_t ds18b20_mirror_reassert(const DS18B20_onewire_t * const onewire, DS18B20_sim_t * const sim, const DS18B20_config_t * const configs, 
+    const size_t devicesNo, const char * const name, const uint32_t scratchpadWrites, const uint32_t eepromWrites)
+{
+    size_t failures = 0;
+    ds18b20_sim_reset_stats(sim);
+    for (size_t i = 0; i < devicesNo; ++i)
+    {
+        if (DS18B20_OK != ds18b20__Configure(onewire, i, &configs[i], !DS18B20_CHECKSUM) || DS18B20_OK != ds18b20__StoreRegisters(onewire, i))
+        {
+            ESP_LOGE(TAG, "%s: failure while configuring device %zu.", name, i);
+            ++failures;
+        }
+    }
+
+    ds18b20_sim_sync(sim);
+    ESP_LOGI(TAG, "%s: %" PRIu32 " scratchpad writes, %" PRIu32 " EEPROM writes, %" PRIu64 " us of bus time", 
+        name, sim->stats.scratchpadWrites, sim->stats.eepromWrites, sim->stats.busTimeUs);
+    if (scratchpadWrites != sim->stats.scratchpadWrites || eepromWrites != sim->stats.eepromWrites)
+    {
+        ESP_LOGE(TAG, "%s: expected %" PRIu32 " scratchpad writes and %" PRIu32 " EEPROM writes", name, scratchpadWrites, eepromWrites);
+        ++failures;
+    }
+
+    return failures;
+}
+
+void ds18b20_write_avoidance_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_MIRROR_DEVICES_NO];
+    DS18B20_mirror_t mirrors[DS18B20_MIRROR_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_MIRROR_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_MIRROR_DEVICES_NO)
+        || DS18B20_OK != ds18b20__EnableWriteAvoidance(&ds18b20_oneWire, mirrors, DS18B20_MIRROR_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    DS18B20_config_t configs[DS18B20_MIRROR_DEVICES_NO];
+    for (size_t i = 0; i < DS18B20_MIRROR_DEVICES_NO; ++i)
+    {
+        configs[i] = (DS18B20_config_t) { .upperAlarm = 40, .lowerAlarm = -5, .resolution = DS18B20_RESOLUTION_11 };
+    }
+
+    size_t failures = 0;
+    failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "Initial configuration", 
+        DS18B20_MIRROR_DEVICES_NO, DS18B20_MIRROR_DEVICES_NO);
+
+    // Periodic reassertion of unchanged configuration does not touch the bus at all
+    for (size_t round = 0; round < DS18B20_MIRROR_REASSERTS; ++round)
+    {
+        failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "Reassertion", 0, 0);
+        if (sim.stats.busTimeUs)
+        {
+            ESP_LOGE(TAG, "Reassertion of unchanged configuration has used the bus.");
+            ++failures;
+        }
+    }
+
+    // Only the changed device is written
+    configs[DS18B20_MIRROR_CHANGED_DEVICE].upperAlarm = 45;
+    failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "Single change", 1, 1);
+
+    // Device reporting power-on reset temperature has reloaded its scratchpad from EEPROM, so it is read back again,
+    // but EEPROM already holds the same configuration
+    DS18B20_temperature_raw_t raw;
+    simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, DS18B20_MIRROR_BROWNOUT_DEVICE)].temperature = DS18B20_SP_TEMP_DEFAULT_VALUE;
+    if (DS18B20_OK != ds18b20__GetTemperatureRaw(&ds18b20_oneWire, DS18B20_MIRROR_BROWNOUT_DEVICE, &raw, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading temperature of device %d.", DS18B20_MIRROR_BROWNOUT_DEVICE);
+        ++failures;
+    }
+    failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "Power-on reset", 1, 0);
+
+    // New generation makes everything stale
+    ds18b20__InvalidateMirrors(&ds18b20_oneWire);
+    failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "New generation", 
+        DS18B20_MIRROR_DEVICES_NO, DS18B20_MIRROR_DEVICES_NO);
+
+    // Broadcast configuration is skipped as a whole only if all devices hold it already
+    for (size_t round = 0; round < 2; ++round)
+    {
+        ds18b20_sim_reset_stats(&sim);
+        if (DS18B20_OK != ds18b20__ConfigureAll(&ds18b20_oneWire, &configs[0], !DS18B20_CHECKSUM) 
+            || DS18B20_OK != ds18b20__StoreRegistersAll(&ds18b20_oneWire))
+        {
+            ESP_LOGE(TAG, "Failure while configuring all devices.");
+            ++failures;
+        }
+        ds18b20_sim_sync(&sim);
+        ESP_LOGI(TAG, "Broadcast %zu: %" PRIu32 " EEPROM writes, %" PRIu64 " us of bus time", round, sim.stats.eepromWrites, sim.stats.busTimeUs);
+        if ((0 == round) != (DS18B20_MIRROR_DEVICES_NO == sim.stats.eepromWrites) || (0 != round && sim.stats.busTimeUs))
+        {
+            ESP_LOGE(TAG, "Broadcast %zu has not been avoided properly.", round);
+            ++failures;
+        }
+    }
+    configs[DS18B20_MIRROR_CHANGED_DEVICE] = configs[0];
+
+    // Without mirrors everything is written every time
+    ds18b20__DisableWriteAvoidance(&ds18b20_oneWire);
+    failures += ds18b20_mirror_reassert(&ds18b20_oneWire, &sim, configs, DS18B20_MIRROR_DEVICES_NO, "Disabled", 
+        DS18B20_MIRROR_DEVICES_NO, DS18B20_MIRROR_DEVICES_NO);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Write avoidance test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Write avoidance test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Initializes devices with known ROM addresses the way it has been done before, probing each one separately.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance attached to simulated bus
+ * @return DS18B20_error_t Status code of the operation
+ */
+static DS18B20_error_t ds18b20_init_per_device(DS18B20_onewire_t * const onewire)
+{
+    DS18B20_error_t status = ds18b20_restart_search(onewire, false);
+    DS18B20_rom_t rom;
+    for (size_t i = 0; i < onewire->devicesNo && DS18B20_OK == status; ++i)
+    {
+        status = ds18b20_search_rom(onewire, &rom, false);
+    }
+    for (size_t i = 0; i < onewire->devicesNo && DS18B20_OK == status; ++i)
+    {
+        status = ds18b20_select(onewire, i);
+        if (DS18B20_OK == status)
+        {
+            status = ds18b20_read_scratchpad_with_crc(onewire, i);
+        }
+        if (DS18B20_OK == status)
+        {
+            status = ds18b20_select(onewire, i);
+        }
+        if (DS18B20_OK == status)
+        {
+            status = ds18b20_read_powermode(onewire, i);
+        }
+        if (DS18B20_OK == status && DS18B20_PM_PARASITE == ds18b20_device_powermode(onewire, i))
+        {
+            status = ds18b20_select(onewire, i);
+            if (DS18B20_OK == status)
+            {
+                status = ds18b20_convert_temperature(onewire, i);
+                ds18b20_delay_ms(onewire, ds18b20_millis_to_wait_for_convertion(ds18b20_device_resolution(onewire, i)));
+                ds18b20_parasite_end_pullup(onewire);
+            }
+        }
+    }
+
+    return status;
+}
+
+void ds18b20_fast_init_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_FAST_INIT_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_FAST_INIT_DEVICES_NO];
+    static const char * const caseNames[DS18B20_FAST_INIT_CASES_NO] = { "external", "mixed", "parasite" };
+
+    size_t failures = 0;
+    for (size_t busCase = 0; busCase < DS18B20_FAST_INIT_CASES_NO; ++busCase)
+    {
+        clock.nowUs = 0;
+        for (size_t i = 0; i < DS18B20_FAST_INIT_DEVICES_NO; ++i)
+        {
+            bool isParasite = 2 == busCase || (1 == busCase && DS18B20_FAST_INIT_PARASITE == i);
+            ds18b20_sim_init_device(&simDevices[i], DS18B20_SIM_SERIAL + i, isParasite ? DS18B20_PM_PARASITE : DS18B20_PM_EXTERNAL_SUPPLY, 
+                DS18B20_SIM_TEMPERATURE + i);
+        }
+        ds18b20_sim_init(&sim, &clock, simDevices, DS18B20_FAST_INIT_DEVICES_NO);
+
+        // Driver has to be attached before the previous way of initialization can be replayed
+        if (DS18B20_OK != ds18b20__InitOneWireWithTransport(&ds18b20_oneWire, &ds18b20_sim_transport, &sim, 
+            ds18b20_devices, DS18B20_FAST_INIT_DEVICES_NO, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "%s: failure while initializing DS18B20 One-Wire driver on simulated bus.", caseNames[busCase]);
+            ++failures;
+            continue;
+        }
+
+        ds18b20_sim_reset_stats(&sim);
+        uint64_t start = clock.nowUs;
+        if (DS18B20_OK != ds18b20_init_per_device(&ds18b20_oneWire))
+        {
+            ESP_LOGE(TAG, "%s: failure while initializing devices one by one.", caseNames[busCase]);
+            ++failures;
+        }
+        uint64_t perDeviceBusUs = sim.stats.busTimeUs;
+        uint64_t perDeviceUs = clock.nowUs - start;
+
+        memset(ds18b20_devices, 0, sizeof(ds18b20_devices));
+        ds18b20_sim_reset_stats(&sim);
+        start = clock.nowUs;
+        if (DS18B20_OK != ds18b20__InitOneWireWithTransport(&ds18b20_oneWire, &ds18b20_sim_transport, &sim, 
+            ds18b20_devices, DS18B20_FAST_INIT_DEVICES_NO, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "%s: failure while initializing DS18B20 One-Wire driver again.", caseNames[busCase]);
+            ++failures;
+            continue;
+        }
+        uint64_t fastBusUs = sim.stats.busTimeUs;
+        uint64_t fastUs = clock.nowUs - start;
+
+        ESP_LOGI(TAG, "Init of %d %s devices: one by one %" PRIu64 " us of bus time, %" PRIu64 " us in total; fast %" PRIu64 " us of bus time, %" PRIu64 " us in total", 
+            DS18B20_FAST_INIT_DEVICES_NO, caseNames[busCase], perDeviceBusUs, perDeviceUs, fastBusUs, fastUs);
+        if (fastBusUs >= perDeviceBusUs || fastUs >= perDeviceUs || sim.stats.parasiteFailures)
+        {
+            ESP_LOGE(TAG, "%s: fast init has not been faster (%" PRIu32 " broken by missing pullup).", caseNames[busCase], sim.stats.parasiteFailures);
+            ++failures;
+        }
+        ds18b20_sim_sync(&sim);
+        if ((0 != busCase) != (DS18B20_FAST_INIT_DEVICES_NO == sim.stats.convertions) || (0 == busCase && sim.stats.convertions))
+        {
+            ESP_LOGE(TAG, "%s: %" PRIu32 " convertions performed during init.", caseNames[busCase], sim.stats.convertions);
+            ++failures;
+        }
+        for (size_t i = 0; i < DS18B20_FAST_INIT_DEVICES_NO; ++i)
+        {
+            const DS18B20_sim_device_t * const simDevice = &simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, i)];
+            if (simDevice->powerMode != ds18b20_devices[i].powerMode || DS18B20_RESOLUTION_12 != ds18b20_devices[i].resolution)
+            {
+                ESP_LOGE(TAG, "%s: device %zu has been initialized with power mode %d and resolution %d.", 
+                    caseNames[busCase], i, ds18b20_devices[i].powerMode, ds18b20_devices[i].resolution);
+                ++failures;
+            }
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Fast init test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Fast init test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Loads topology blob from the file given as store context.
+ * 
+ */
+static DS18B20_error_t ds18b20_file_load(void * const context, uint8_t * const blob, const size_t capacity, size_t * const sizeOut)
+{
+    FILE *file = fopen((const char *) context, "rb");
+    if (!file)
+    {
+        return DS18B20_STORE_FAIL;
+    }
+    *sizeOut = fread(blob, 1, capacity, file);
+    fclose(file);
+
+    return DS18B20_OK;
+}
+
+/**
+ * @brief Saves topology blob into the file given as store context.
+ * 
+ */
+static DS18B20_error_t ds18b20_file_save(void * const context, const uint8_t * const blob, const size_t size)
+{
+    FILE *file = fopen((const char *) context, "wb");
+    if (!file)
+    {
+        return DS18B20_STORE_FAIL;
+    }
+    size_t written = fwrite(blob, 1, size, file);
+    fclose(file);
+
+    return (size == written) ? DS18B20_OK : DS18B20_STORE_FAIL;
+}
+
+static const DS18B20_topology_store_t ds18b20_file_topology_store =
+{
+    .load = ds18b20_file_load,
+    .save = ds18b20_file_save
+};
+
+/**
+ * @brief Restarts simulated bus and initializes the driver with cached topology, checking if ROM search has been skipped as expected.
+ * 
+ * @param sim Pointer to simulated bus instance
+ * @param simDevices Simulated devices, including the ones which are disconnected
+ * @param simDevicesNo Number of simulated devices
+ * @param devicesNo Number of devices to initialize
+ * @param topology Pointer to topology cache
+ * @param name Name of the start used in logs
+ * @param warm Expected kind of the start
+ * @return size_t Number of failures
+ */
+static size_t ds18b20_topology_boot(DS18B20_sim_t * const sim, DS18B20_sim_device_t * const simDevices, const size_t simDevicesNo, 
+    const size_t devicesNo, DS18B20_topology_t * const topology, const char * const name, const bool warm)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_TOPOLOGY_DEVICES_NO + 1];
+
+    ds18b20_sim_init(sim, sim->clock, simDevices, simDevicesNo);
+    uint64_t start = sim->clock->nowUs;
+    if (DS18B20_OK != ds18b20__InitOneWireWithTopology(&ds18b20_oneWire, &ds18b20_sim_transport, sim, ds18b20_devices, devicesNo, topology, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "%s: failure while initializing DS18B20 One-Wire driver on simulated bus.", name);
+        return 1;
+    }
+    ESP_LOGI(TAG, "%s start (%s): %" PRIu64 " us of bus time, %" PRIu64 " us in total", 
+        name, topology->warm ? "warm" : "cold", sim->stats.busTimeUs, sim->clock->nowUs - start);
+
+    size_t failures = 0;
+    if (warm != topology->warm)
+    {
+        ESP_LOGE(TAG, "%s: expected %s start.", name, warm ? "warm" : "cold");
+        ++failures;
+    }
+    for (size_t i = 0; i < devicesNo; ++i)
+    {
+        size_t simIndex = 0;
+        while (simIndex < simDevicesNo && memcmp(ds18b20_devices[i].rom, simDevices[simIndex].rom, sizeof(DS18B20_rom_t)))
+        {
+            ++simIndex;
+        }
+        if (simIndex == simDevicesNo || !simDevices[simIndex].present || simDevices[simIndex].powerMode != ds18b20_devices[i].powerMode)
+        {
+            ESP_LOGE(TAG, "%s: device %zu does not match any connected device.", name, i);
+            ++failures;
+        }
+    }
+
+    return failures;
+}
+
+void ds18b20_topology_cache_test(void)
+{
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_TOPOLOGY_DEVICES_NO + 1];
+    DS18B20_topology_t topology;
+    uint8_t blob[DS18B20_TOPOLOGY_SIZE(DS18B20_TOPOLOGY_DEVICES_NO + 1)];
+
+    clock.nowUs = 0;
+    sim.clock = &clock;
+    for (size_t i = 0; i <= DS18B20_TOPOLOGY_DEVICES_NO; ++i)
+    {
+        ds18b20_sim_init_device(&simDevices[i], DS18B20_SIM_SERIAL + i, DS18B20_PM_EXTERNAL_SUPPLY, DS18B20_SIM_TEMPERATURE + i);
+    }
+    simDevices[DS18B20_TOPOLOGY_SPARE_DEVICE].present = false;
+
+    remove(DS18B20_TOPOLOGY_PATH);
+    if (DS18B20_OK != ds18b20__InitTopology(&topology, &ds18b20_file_topology_store, DS18B20_TOPOLOGY_PATH, blob, sizeof(blob)))
+    {
+        ESP_LOGE(TAG, "Failure while initializing topology cache.");
+        return;
+    }
+
+    size_t failures = 0;
+    const size_t simDevicesNo = DS18B20_TOPOLOGY_DEVICES_NO + 1;
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO, &topology, "First", false);
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO, &topology, "Unchanged", true);
+
+    // Replaced device does not reply to its cached ROM address
+    simDevices[DS18B20_TOPOLOGY_REMOVED_DEVICE].present = false;
+    simDevices[DS18B20_TOPOLOGY_SPARE_DEVICE].present = true;
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO, &topology, "Replaced", false);
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO, &topology, "After replacement", true);
+
+    // Added device changes the number of devices
+    simDevices[DS18B20_TOPOLOGY_REMOVED_DEVICE].present = true;
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO + 1, &topology, "Added", false);
+
+    // Changed wiring of power supply is noticed by broadcast probe
+    simDevices[0].powerMode = DS18B20_PM_PARASITE;
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO + 1, &topology, "Parasite", false);
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO + 1, &topology, "Parasite again", true);
+
+    // Corrupted blob is never trusted
+    FILE *file = fopen(DS18B20_TOPOLOGY_PATH, "r+b");
+    if (file)
+    {
+        fseek(file, DS18B20_TOPOLOGY_HEADER_SIZE, SEEK_SET);
+        fputc(0x5A, file);
+        fclose(file);
+    }
+    failures += ds18b20_topology_boot(&sim, simDevices, simDevicesNo, DS18B20_TOPOLOGY_DEVICES_NO + 1, &topology, "Corrupted", false);
+    remove(DS18B20_TOPOLOGY_PATH);
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Topology cache test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Topology cache test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_verify_rom_test(void)
+{
+    DS18B20_onewire_t ds18b20_oneWire;
+    DS18B20_t ds18b20_devices[DS18B20_VERIFY_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+    DS18B20_sim_t sim;
+    DS18B20_sim_device_t simDevices[DS18B20_VERIFY_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_VERIFY_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    size_t failures = 0;
+    uint32_t present[DS18B20_ALARM_BITMAP_WORDS(DS18B20_VERIFY_DEVICES_NO)];
+    size_t presentNo;
+    if (DS18B20_OK != ds18b20__VerifyDevices(&ds18b20_oneWire, present, &presentNo) || DS18B20_VERIFY_DEVICES_NO != presentNo)
+    {
+        ESP_LOGE(TAG, "Not all connected devices have been verified.");
+        ++failures;
+    }
+
+    // Hot-removed devices, every check takes the same number of timeslots
+    simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, DS18B20_VERIFY_REMOVED_FIRST)].present = false;
+    simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, DS18B20_VERIFY_REMOVED_SECOND)].present = false;
+    for (size_t i = 0; i < DS18B20_VERIFY_DEVICES_NO; ++i)
+    {
+        bool isPresent;
+        ds18b20_sim_reset_stats(&sim);
+        if (DS18B20_OK != ds18b20_verify_rom(&ds18b20_oneWire, ds18b20_devices[i].rom, &isPresent))
+        {
+            ESP_LOGE(TAG, "Failure while verifying device %zu.", i);
+            ++failures;
+            continue;
+        }
+        bool removed = DS18B20_VERIFY_REMOVED_FIRST == i || DS18B20_VERIFY_REMOVED_SECOND == i;
+        if (removed == isPresent || 1 != sim.stats.resets 
+            || DS18B20_VERIFY_READ_SLOTS != sim.stats.readSlots || DS18B20_VERIFY_WRITE_SLOTS != sim.stats.writeSlots)
+        {
+            ESP_LOGE(TAG, "Device %zu: present %d, %" PRIu32 " resets, %" PRIu32 " read and %" PRIu32 " write timeslots", 
+                i, isPresent, sim.stats.resets, sim.stats.readSlots, sim.stats.writeSlots);
+            ++failures;
+        }
+    }
+    ESP_LOGI(TAG, "Verification of single ROM: %" PRIu64 " us of bus time", sim.stats.busTimeUs);
+
+    if (DS18B20_OK != ds18b20__VerifyDevices(&ds18b20_oneWire, present, &presentNo) || DS18B20_VERIFY_DEVICES_NO - 2 != presentNo
+        || present[0] != ((1UL << DS18B20_VERIFY_DEVICES_NO) - 1 - (1UL << DS18B20_VERIFY_REMOVED_FIRST) - (1UL << DS18B20_VERIFY_REMOVED_SECOND)))
+    {
+        ESP_LOGE(TAG, "Removed devices have not been reported (%zu present, bitmap 0x%08" PRIx32 ").", presentNo, present[0]);
+        ++failures;
+    }
+
+    // Address differing from connected device in the last bit only and one of removed device
+    DS18B20_rom_t roms[DS18B20_VERIFY_ROMS_NO];
+    bool romsPresent[DS18B20_VERIFY_ROMS_NO];
+    memcpy(roms[0], ds18b20_devices[0].rom, sizeof(DS18B20_rom_t));
+    memcpy(roms[1], ds18b20_devices[0].rom, sizeof(DS18B20_rom_t));
+    roms[1][DS18B20_ROM_SIZE - 1] ^= 0x80;
+    memcpy(roms[2], ds18b20_devices[DS18B20_VERIFY_REMOVED_FIRST].rom, sizeof(DS18B20_rom_t));
+    if (DS18B20_OK != ds18b20__VerifyRoms(&ds18b20_oneWire, roms, DS18B20_VERIFY_ROMS_NO, romsPresent, &presentNo) 
+        || 1 != presentNo || !romsPresent[0] || romsPresent[1] || romsPresent[2])
+    {
+        ESP_LOGE(TAG, "ROM list has not been verified properly (%zu present).", presentNo);
+        ++failures;
+    }
+
+    // Empty bus does not reply to reset at all
+    for (size_t i = 0; i < DS18B20_VERIFY_DEVICES_NO; ++i)
+    {
+        simDevices[i].present = false;
+    }
+    if (DS18B20_OK != ds18b20__VerifyDevices(&ds18b20_oneWire, present, &presentNo) || presentNo || present[0])
+    {
+        ESP_LOGE(TAG, "Devices have been reported on empty bus.");
+        ++failures;
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Verify ROM test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Verify ROM test passed.");
+    }
+
+    return;
+}
+
+void ds18b20_manager_test(void)
+{
+    static DS18B20_onewire_t ds18b20_oneWires[DS18B20_MANAGER_BUSES_NO];
+    static DS18B20_t ds18b20_devices[DS18B20_MANAGER_BUSES_NO][DS18B20_MANAGER_DEVICES_NO];
+    static DS18B20_sim_t sims[DS18B20_MANAGER_BUSES_NO];
+    static DS18B20_sim_device_t simDevices[DS18B20_MANAGER_BUSES_NO][DS18B20_MANAGER_DEVICES_NO];
+    static DS18B20_temperature_raw_t temperatures[DS18B20_MANAGER_BUSES_NO * DS18B20_MANAGER_DEVICES_NO];
+    DS18B20_sim_clock_t clock;
+
+    // All buses share the same time, so reading one bus delays the others just like on the target
+    const DS18B20_onewire_t *buses[DS18B20_MANAGER_BUSES_NO];
+    for (size_t bus = 0; bus < DS18B20_MANAGER_BUSES_NO; ++bus)
+    {
+        if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWires[bus], &sims[bus], &clock, simDevices[bus], ds18b20_devices[bus], DS18B20_MANAGER_DEVICES_NO))
+        {
+            ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus %zu.", bus);
+            return;
+        }
+        buses[bus] = &ds18b20_oneWires[bus];
+    }
+
+    size_t failures = 0;
+    uint64_t start = clock.nowUs;
+    for (size_t sweep = 0; sweep < DS18B20_MANAGER_SWEEPS; ++sweep)
+    {
+        for (size_t bus = 0; bus < DS18B20_MANAGER_BUSES_NO; ++bus)
+        {
+            if (DS18B20_OK != ds18b20__GetTemperaturesRaw(buses[bus], &temperatures[bus * DS18B20_MANAGER_DEVICES_NO], DS18B20_CHECKSUM))
+            {
+                ESP_LOGE(TAG, "Failure while reading bus %zu one after another.", bus);
+                ++failures;
+            }
+        }
+    }
+    uint64_t sequentialUs = (clock.nowUs - start) / DS18B20_MANAGER_SWEEPS;
+
+    DS18B20_manager_t manager;
+    DS18B20_convertion_t convertions[DS18B20_MANAGER_BUSES_NO];
+    DS18B20_error_t statuses[DS18B20_MANAGER_BUSES_NO];
+    if (DS18B20_OK != ds18b20__InitManager(&manager, buses, DS18B20_MANAGER_BUSES_NO, convertions, statuses)
+        || DS18B20_MANAGER_BUSES_NO * DS18B20_MANAGER_DEVICES_NO != manager.devicesNo)
+    {
+        ESP_LOGE(TAG, "Failure while initializing manager.");
+        return;
+    }
+
+    start = clock.nowUs;
+    for (size_t sweep = 0; sweep < DS18B20_MANAGER_SWEEPS; ++sweep)
+    {
+        memset(temperatures, 0, sizeof(temperatures));
+        if (DS18B20_OK != ds18b20__SweepTemperaturesRaw(&manager, temperatures, DS18B20_CHECKSUM))
+        {
+            ESP_LOGE(TAG, "Failure while sweeping all buses.");
+            ++failures;
+        }
+        if ((uint32_t)(convertions[DS18B20_MANAGER_BUSES_NO - 1].startMs - convertions[0].startMs) > DS18B20_MANAGER_ALIGNMENT_MS)
+        {
+            ESP_LOGE(TAG, "Convertions have not been started together (%" PRIu32 " ms apart).", convertions[DS18B20_MANAGER_BUSES_NO - 1].startMs - convertions[0].startMs);
+            ++failures;
+        }
+    }
+    uint64_t pipelinedUs = (clock.nowUs - start) / DS18B20_MANAGER_SWEEPS;
+
+    for (size_t bus = 0; bus < DS18B20_MANAGER_BUSES_NO; ++bus)
+    {
+        for (size_t i = 0; i < DS18B20_MANAGER_DEVICES_NO; ++i)
+        {
+            const DS18B20_sim_device_t * const simDevice = &simDevices[bus][ds18b20_sim_index(ds18b20_devices[bus], simDevices[bus], i)];
+            if (simDevice->temperature != temperatures[bus * DS18B20_MANAGER_DEVICES_NO + i])
+            {
+                ESP_LOGE(TAG, "Bus %zu device %zu: %d, expected %d", bus, i, temperatures[bus * DS18B20_MANAGER_DEVICES_NO + i], simDevice->temperature);
+                ++failures;
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "Sweep of %d buses x %d devices: one after another %" PRIu64 " us, pipelined %" PRIu64 " us", 
+        DS18B20_MANAGER_BUSES_NO, DS18B20_MANAGER_DEVICES_NO, sequentialUs, pipelinedUs);
+    if (2 * pipelinedUs >= sequentialUs)
+    {
+        ESP_LOGE(TAG, "Pipelined sweep has not been faster.");
+        ++failures;
+    }
+
+    // Disconnected bus does not stop the others
+    for (size_t i = 0; i < DS18B20_MANAGER_DEVICES_NO; ++i)
+    {
+        simDevices[DS18B20_MANAGER_FAILED_BUS][i].present = false;
+    }
+    memset(temperatures, 0, sizeof(temperatures));
+    if (DS18B20_DISCONNECTED != ds18b20__SweepTemperaturesRaw(&manager, temperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Disconnected bus has not been reported.");
+        ++failures;
+    }
+    for (size_t bus = 0; bus < DS18B20_MANAGER_BUSES_NO; ++bus)
+    {
+        if ((DS18B20_MANAGER_FAILED_BUS == bus) == (DS18B20_OK == statuses[bus]) 
+            || (DS18B20_MANAGER_FAILED_BUS != bus && !temperatures[bus * DS18B20_MANAGER_DEVICES_NO]))
+        {
+            ESP_LOGE(TAG, "Bus %zu: status %d after sweep with disconnected bus.", bus, statuses[bus]);
+            ++failures;
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Manager test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Manager test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Discovers lanes and reads their temperatures, returning bus time of both operations.
+ * 
+ * @param lockstep Pointer to lockstep instance
+ * @param clock Pointer to simulated clock shared by all lanes
+ * @param failures Pointer to failures counter
+ * @return uint64_t Time of discovery and reading (in microseconds)
+ */
+static uint64_t ds18b20_lockstep_acquire(DS18B20_lockstep_t * const lockstep, DS18B20_sim_clock_t * const clock, size_t * const failures)
+{
+    uint64_t start = clock->nowUs;
+    if (DS18B20_OK != ds18b20__LockstepDiscover(lockstep, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while discovering lanes.");
+        ++*failures;
+    }
+    uint64_t elapsedUs = clock->nowUs - start;
+
+    if (DS18B20_OK != ds18b20__LockstepConvert(lockstep))
+    {
+        ESP_LOGE(TAG, "Failure while converting temperatures on lanes.");
+        ++*failures;
+    }
+
+    start = clock->nowUs;
+    if (DS18B20_OK != ds18b20__LockstepReadTemperaturesRaw(lockstep, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Failure while reading lanes.");
+        ++*failures;
+    }
+
+    return elapsedUs + clock->nowUs - start;
+}
+
+void ds18b20_lockstep_test(void)
+{
+    // Lanes are sparse and have different device sets - each lane follows its own search, addressing and data
+    static const size_t devicesNo[DS18B20_LOCKSTEP_LANES_NO] = { [0] = 3, [2] = 8, [5] = 1, [7] = 5 };
+    static DS18B20_sim_t sims[DS18B20_LOCKSTEP_LANES_NO];
+    static DS18B20_sim_device_t simDevices[DS18B20_LOCKSTEP_LANES_NO][DS18B20_LOCKSTEP_CAPACITY];
+    static DS18B20_rom_t roms[DS18B20_LOCKSTEP_LANES_NO][DS18B20_LOCKSTEP_CAPACITY];
+    static DS18B20_temperature_raw_t temperatures[DS18B20_LOCKSTEP_LANES_NO][DS18B20_LOCKSTEP_CAPACITY];
+    DS18B20_sim_clock_t clock = { .nowUs = 0 };
+    DS18B20_sim_lockstep_t simLanes = { .clock = &clock };
+    DS18B20_lockstep_lane_t lanes[DS18B20_LOCKSTEP_LANES_NO];
+    DS18B20_lockstep_t lockstep;
+
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_LANES_NO; ++lane)
+    {
+        for (size_t i = 0; i < devicesNo[lane]; ++i)
+        {
+            DS18B20_powermode_t powerMode = (DS18B20_LOCKSTEP_PARASITE_LANE == lane) ? DS18B20_PM_PARASITE : DS18B20_PM_EXTERNAL_SUPPLY;
+            ds18b20_sim_init_device(&simDevices[lane][i], DS18B20_SIM_SERIAL + (lane << 8) + i * 37, powerMode, DS18B20_SIM_TEMPERATURE + 16 * lane + i);
+        }
+        ds18b20_sim_init(&sims[lane], &clock, simDevices[lane], devicesNo[lane]);
+        simLanes.lanes[lane] = devicesNo[lane] ? &sims[lane] : NULL;
+    }
+
+    // Every lane driven alone, one after another
+    size_t failures = 0;
+    size_t usedLanesNo = 0;
+    uint64_t sequentialUs = 0;
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_LANES_NO; ++lane)
+    {
+        if (!devicesNo[lane])
+        {
+            continue;
+        }
+        ++usedLanesNo;
+        memset(lanes, 0, sizeof(lanes));
+        lanes[lane] = (DS18B20_lockstep_lane_t) { .roms = roms[lane], .temperatures = temperatures[lane], .capacity = DS18B20_LOCKSTEP_CAPACITY };
+        if (DS18B20_OK != ds18b20__InitLockstep(&lockstep, &ds18b20_sim_lockstep_transport, &simLanes, lanes, DS18B20_LOCKSTEP_LANES_NO))
+        {
+            ESP_LOGE(TAG, "Failure while initializing lockstep of lane %zu.", lane);
+            return;
+        }
+        sequentialUs += ds18b20_lockstep_acquire(&lockstep, &clock, &failures);
+    }
+
+    // All lanes at once
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_LANES_NO; ++lane)
+    {
+        lanes[lane] = (DS18B20_lockstep_lane_t) { .roms = roms[lane], .temperatures = temperatures[lane], .capacity = devicesNo[lane] ? DS18B20_LOCKSTEP_CAPACITY : 0 };
+        ds18b20_sim_reset_stats(&sims[lane]);
+    }
+    memset(temperatures, 0, sizeof(temperatures));
+    if (DS18B20_OK != ds18b20__InitLockstep(&lockstep, &ds18b20_sim_lockstep_transport, &simLanes, lanes, DS18B20_LOCKSTEP_LANES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing lockstep of all lanes.");
+        return;
+    }
+    uint64_t lockstepUs = ds18b20_lockstep_acquire(&lockstep, &clock, &failures);
+
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_LANES_NO; ++lane)
+    {
+        DS18B20_powermode_t powerMode = (DS18B20_LOCKSTEP_PARASITE_LANE == lane) ? DS18B20_PM_PARASITE : DS18B20_PM_EXTERNAL_SUPPLY;
+        ds18b20_sim_sync(&sims[lane]);
+        if (devicesNo[lane] != lanes[lane].devicesNo || DS18B20_OK != lanes[lane].status 
+            || (devicesNo[lane] && powerMode != lanes[lane].powerMode) || sims[lane].stats.parasiteFailures)
+        {
+            ESP_LOGE(TAG, "Lane %zu: %zu devices (status %d, power mode %d), expected %zu.", lane, lanes[lane].devicesNo, lanes[lane].status, lanes[lane].powerMode, devicesNo[lane]);
+            ++failures;
+            continue;
+        }
+
+        for (size_t i = 0; i < devicesNo[lane]; ++i)
+        {
+            size_t simIndex = 0;
+            while (simIndex < devicesNo[lane] && memcmp(simDevices[lane][simIndex].rom, roms[lane][i], DS18B20_ROM_SIZE))
+            {
+                ++simIndex;
+            }
+            if (simIndex == devicesNo[lane] || simDevices[lane][simIndex].temperature != temperatures[lane][i])
+            {
+                ESP_LOGE(TAG, "Lane %zu device %zu: unknown ROM address or temperature %d.", lane, i, temperatures[lane][i]);
+                ++failures;
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "Discovery and reading of %zu lanes: one after another %" PRIu64 " us, in lockstep %" PRIu64 " us", usedLanesNo, sequentialUs, lockstepUs);
+    if (2 * lockstepUs >= sequentialUs)
+    {
+        ESP_LOGE(TAG, "Lockstep has not been faster.");
+        ++failures;
+    }
+
+    // Disconnected lane does not stop the others
+    for (size_t i = 0; i < devicesNo[DS18B20_LOCKSTEP_FAILED_LANE]; ++i)
+    {
+        simDevices[DS18B20_LOCKSTEP_FAILED_LANE][i].present = false;
+    }
+    memset(temperatures, 0, sizeof(temperatures));
+    if (DS18B20_DISCONNECTED != ds18b20__LockstepReadTemperaturesRaw(&lockstep, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Disconnected lane has not been reported.");
+        ++failures;
+    }
+    for (size_t lane = 0; lane < DS18B20_LOCKSTEP_LANES_NO; ++lane)
+    {
+        if (devicesNo[lane] && ((DS18B20_LOCKSTEP_FAILED_LANE == lane) == (DS18B20_OK == lanes[lane].status)
+            || (DS18B20_LOCKSTEP_FAILED_LANE != lane && !temperatures[lane][0])))
+        {
+            ESP_LOGE(TAG, "Lane %zu: status %d after reading with disconnected lane.", lane, lanes[lane].status);
+            ++failures;
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Lockstep test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Lockstep test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Describes producer thread queueing requests to the worker one after another.
+ * 
+ */
+typedef struct
+{
+    DS18B20_worker_t                        *worker; /**< Worker performing the requests */
+    size_t                                  busIndex; /**< Bus used by the producer */
+    const DS18B20_t                         *devices; /**< Devices of the bus */
+    const DS18B20_sim_device_t              *simDevices; /**< Simulated devices of the bus */
+    DS18B20_thread_t                        thread; /**< Thread of the producer */
+    size_t                                  failures; /**< Number of failed checks (read after the thread finishes) */
+} DS18B20_worker_producer_t;
+
+/**
+ * @brief Queues requests of every type, waits for notification of each of them and checks the results.
+ * 
+ * @param arg Pointer to producer instance
+ */
+static void ds18b20_worker_produce(void *arg)
+{
+    DS18B20_worker_producer_t *producer = (DS18B20_worker_producer_t *) arg;
+    DS18B20_temperature_raw_t temperatures[DS18B20_WORKER_DEVICES_NO];
+    uint32_t alarms[DS18B20_ALARM_BITMAP_WORDS(DS18B20_WORKER_DEVICES_NO)];
+    size_t alarmsNo;
+    DS18B20_config_t config;
+    ds18b20__InitConfigDefault(&config);
+
+    DS18B20_request_t request = 
+    {
+        .busIndex = producer->busIndex,
+        .config = &config,
+        .temperaturesOut = temperatures,
+        .alarmsOut = alarms,
+        .alarmsNoOut = &alarmsNo,
+        .checksum = DS18B20_CHECKSUM,
+        .notify = ds18b20_port_thread_target(&producer->thread)
+    };
+
+    // Convertion comes first, so every read returns temperatures measured by the simulated devices
+    for (size_t i = 0; i < DS18B20_WORKER_ITERATIONS; ++i)
+    {
+        request.type = (DS18B20_request_type_t) (i % DS18B20_REQUEST_COUNT);
+        request.deviceIndex = i % DS18B20_WORKER_DEVICES_NO;
+        memset(temperatures, 0, sizeof(temperatures));
+        alarmsNo = DS18B20_WORKER_DEVICES_NO;
+
+        // Full queue is not a failure, the request is submitted again once the worker makes room
+        DS18B20_error_t status;
+        while (DS18B20_QUEUE_FULL == (status = ds18b20__SubmitRequest(producer->worker, &request)))
+        {
+            ds18b20_tests_yield();
+        }
+        if (DS18B20_OK != status)
+        {
+            ++producer->failures;
+            continue;
+        }
+        ds18b20_port_wait_notification(ds18b20_port_thread_target(&producer->thread));
+
+        if (!ds18b20__IsRequestDone(&request) || DS18B20_OK != request.status 
+            || (DS18B20_REQUEST_SEARCH == request.type && 0 != alarmsNo))
+        {
+            ++producer->failures;
+            continue;
+        }
+        for (size_t j = 0; DS18B20_REQUEST_READ == request.type && j < DS18B20_WORKER_DEVICES_NO; ++j)
+        {
+            if (producer->simDevices[ds18b20_sim_index(producer->devices, producer->simDevices, j)].temperature != temperatures[j])
+            {
+                ++producer->failures;
+            }
+        }
+    }
+
+    ds18b20_port_thread_exit(&producer->thread);
+}
+
+/**
+ * @brief Counts completions of the requests.
+ * 
+ * @param request Pointer to completed request
+ * @param context Pointer to atomic counter
+ */
+static void ds18b20_worker_count(DS18B20_request_t * const request, void * const context)
+{
+    (void) request;
+    atomic_fetch_add((atomic_size_t *) context, 1);
+}
+
+void ds18b20_worker_test(void)
+{
+    static DS18B20_onewire_t ds18b20_oneWires[DS18B20_WORKER_BUSES_NO];
+    static DS18B20_t ds18b20_devices[DS18B20_WORKER_BUSES_NO][DS18B20_WORKER_DEVICES_NO];
+    static DS18B20_sim_t sims[DS18B20_WORKER_BUSES_NO];
+    static DS18B20_sim_device_t simDevices[DS18B20_WORKER_BUSES_NO][DS18B20_WORKER_DEVICES_NO];
+    static DS18B20_sim_clock_t clocks[DS18B20_WORKER_BUSES_NO];
+    static DS18B20_temperature_raw_t temperatures[DS18B20_WORKER_SLOTS_NO][DS18B20_WORKER_DEVICES_NO];
+    static DS18B20_request_t requests[DS18B20_WORKER_SLOTS_NO + 1];
+    static DS18B20_worker_producer_t producers[DS18B20_WORKER_PRODUCERS_NO];
+    DS18B20_worker_slot_t slots[DS18B20_WORKER_SLOTS_NO];
+    DS18B20_worker_t worker;
+
+    const DS18B20_onewire_t *buses[DS18B20_WORKER_BUSES_NO];
+    for (size_t bus = 0; bus < DS18B20_WORKER_BUSES_NO; ++bus)
+    {
+        if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWires[bus], &sims[bus], &clocks[bus], simDevices[bus], ds18b20_devices[bus], DS18B20_WORKER_DEVICES_NO)
+            || DS18B20_OK != ds18b20__RequestTemperaturesC(&ds18b20_oneWires[bus]))
+        {
+            ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus %zu.", bus);
+            return;
+        }
+        buses[bus] = &ds18b20_oneWires[bus];
+    }
+
+    if (DS18B20_OK != ds18b20__InitWorker(&worker, buses, DS18B20_WORKER_BUSES_NO, slots, DS18B20_WORKER_SLOTS_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing worker.");
+        return;
+    }
+
+    // Requests queued before the start fill the whole ring
+    size_t failures = 0;
+    atomic_size_t completions;
+    atomic_init(&completions, 0);
+    for (size_t i = 0; i <= DS18B20_WORKER_SLOTS_NO; ++i)
+    {
+        requests[i] = (DS18B20_request_t)
+        {
+            .type = DS18B20_REQUEST_READ,
+            .busIndex = i % DS18B20_WORKER_BUSES_NO,
+            .temperaturesOut = temperatures[i % DS18B20_WORKER_SLOTS_NO],
+            .checksum = DS18B20_CHECKSUM,
+            .callback = ds18b20_worker_count,
+            .callbackContext = &completions
+        };
+        DS18B20_error_t expected = (DS18B20_WORKER_SLOTS_NO == i) ? DS18B20_QUEUE_FULL : DS18B20_OK;
+        if (expected != ds18b20__SubmitRequest(&worker, &requests[i]))
+        {
+            ESP_LOGE(TAG, "Request %zu has not been queued as expected.", i);
+            ++failures;
+        }
+    }
+
+    DS18B20_worker_config_t config;
+    ds18b20__InitWorkerConfigDefault(&config);
+    if (DS18B20_OK != ds18b20__StartWorker(&worker, &config))
+    {
+        ESP_LOGE(TAG, "Failure while starting worker.");
+        return;
+    }
+
+    // Many producers queue their requests at once
+    for (size_t i = 0; i < DS18B20_WORKER_PRODUCERS_NO; ++i)
+    {
+        producers[i] = (DS18B20_worker_producer_t)
+        {
+            .worker = &worker,
+            .busIndex = i % DS18B20_WORKER_BUSES_NO,
+            .devices = ds18b20_devices[i % DS18B20_WORKER_BUSES_NO],
+            .simDevices = simDevices[i % DS18B20_WORKER_BUSES_NO]
+        };
+        if (!ds18b20_port_thread_start(&producers[i].thread, ds18b20_worker_produce, &producers[i], 
+            DS18B20_WORKER_CORE_ANY, DS18B20_WORKER_PRIORITY_DEFAULT, DS18B20_WORKER_STACK_SIZE_DEFAULT))
+        {
+            ESP_LOGE(TAG, "Failure while starting producer %zu.", i);
+            return;
+        }
+    }
+    for (size_t i = 0; i < DS18B20_WORKER_PRODUCERS_NO; ++i)
+    {
+        ds18b20_port_thread_join(&producers[i].thread);
+        if (producers[i].failures)
+        {
+            ESP_LOGE(TAG, "Producer %zu: %zu failed requests.", i, producers[i].failures);
+            failures += producers[i].failures;
+        }
+    }
+
+    // Stopping performs everything still queued
+    if (DS18B20_OK != ds18b20__StopWorker(&worker))
+    {
+        ESP_LOGE(TAG, "Failure while stopping worker.");
+        ++failures;
+    }
+    if (DS18B20_WORKER_SLOTS_NO != atomic_load(&completions))
+    {
+        ESP_LOGE(TAG, "%zu completions of requests queued before the start, expected %d.", atomic_load(&completions), DS18B20_WORKER_SLOTS_NO);
+        ++failures;
+    }
+    for (size_t i = 0; i < DS18B20_WORKER_SLOTS_NO; ++i)
+    {
+        const size_t bus = requests[i].busIndex;
+        if (!ds18b20__IsRequestDone(&requests[i]) || DS18B20_OK != requests[i].status 
+            || simDevices[bus][ds18b20_sim_index(ds18b20_devices[bus], simDevices[bus], 0)].temperature != temperatures[i][0])
+        {
+            ESP_LOGE(TAG, "Request %zu: status %d, temperature %d.", i, requests[i].status, temperatures[i][0]);
+            ++failures;
+        }
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Worker test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Worker test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Describes task reading shared bus, either whole or its single device.
+ * 
+ */
+typedef struct
+{
+    DS18B20_shared_t                        *shared; /**< Shared bus */
+    const DS18B20_t                         *devices; /**< Devices of the bus */
+    const DS18B20_sim_device_t              *simDevices; /**< Simulated devices of the bus */
+    bool                                    wholeBus; /**< Indicates if the task reads all devices */
+    size_t                                  deviceIndex; /**< Device read by the task otherwise */
+    bool                                    checksum; /**< Checksum setting of the requests */
+    size_t                                  iterations; /**< Number of rounds */
+    DS18B20_thread_t                        thread; /**< Thread of the task */
+    atomic_uint                             *arrived; /**< Number of tasks which are about to send request of the current round */
+    atomic_uint                             *returned; /**< Number of tasks which have finished request of the current round */
+    size_t                                  failures; /**< Number of failed checks (read after the thread finishes) */
+} DS18B20_shared_task_t;
+
+/**
+ * @brief Reads temperatures once per round and checks them against the simulated devices.
+ * 
+ * Each round starts with notification from the test, which holds the lock until all tasks of the round have arrived.
+ * 
+ * @param arg Pointer to task instance
+ */
+static void ds18b20_shared_read(void *arg)
+{
+    DS18B20_shared_task_t *task = (DS18B20_shared_task_t *) arg;
+    DS18B20_temperature_raw_t temperatures[DS18B20_SHARED_DEVICES_NO];
+
+    for (size_t i = 0; i < task->iterations; ++i)
+    {
+        ds18b20_port_wait_notification(ds18b20_port_thread_target(&task->thread));
+        atomic_fetch_add(task->arrived, 1);
+
+        size_t first = task->wholeBus ? 0 : task->deviceIndex;
+        size_t last = task->wholeBus ? DS18B20_SHARED_DEVICES_NO : task->deviceIndex + 1;
+        DS18B20_error_t status = task->wholeBus 
+            ? ds18b20__SharedGetTemperaturesRaw(task->shared, temperatures, task->checksum)
+            : ds18b20__SharedGetTemperatureRaw(task->shared, task->deviceIndex, &temperatures[task->deviceIndex], task->checksum);
+        for (size_t j = first; DS18B20_OK == status && j < last; ++j)
+        {
+            if (task->simDevices[ds18b20_sim_index(task->devices, task->simDevices, j)].temperature != temperatures[j])
+            {
+                ++task->failures;
+            }
+        }
+        task->failures += DS18B20_OK != status;
+        atomic_fetch_add(task->returned, 1);
+    }
+
+    ds18b20_port_thread_exit(&task->thread);
+}
+
+/**
+ * @brief Starts the tasks, runs all their rounds and waits until they finish.
+ * 
+ * Requests of the round are sent while the test holds the lock, so they sample generation before the first reading starts.
+ * 
+ * @param shared Pointer to shared bus instance
+ * @param tasks Array of prepared tasks
+ * @param tasksNo Number of the tasks
+ * @param rounds Number of rounds (the same for all the tasks)
+ * @return size_t Number of failed checks
+ */
+static size_t ds18b20_shared_run(DS18B20_shared_t * const shared, DS18B20_shared_task_t * const tasks, const size_t tasksNo, const size_t rounds)
+{
+    size_t failures = 0;
+    atomic_uint arrived, returned;
+    atomic_init(&arrived, 0);
+    atomic_init(&returned, 0);
+    for (size_t i = 0; i < tasksNo; ++i)
+    {
+        tasks[i].iterations = rounds;
+        tasks[i].arrived = &arrived;
+        tasks[i].returned = &returned;
+        tasks[i].failures = 0;
+        if (!ds18b20_port_thread_start(&tasks[i].thread, ds18b20_shared_read, &tasks[i], 
+            DS18B20_WORKER_CORE_ANY, DS18B20_WORKER_PRIORITY_DEFAULT, DS18B20_WORKER_STACK_SIZE_DEFAULT))
+        {
+            ESP_LOGE(TAG, "Failure while starting task %zu.", i);
+            return failures + 1;
+        }
+    }
+
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        atomic_store(&arrived, 0);
+        atomic_store(&returned, 0);
+        ds18b20__LockSharedBus(shared);
+        for (size_t i = 0; i < tasksNo; ++i)
+        {
+            ds18b20_port_notify(ds18b20_port_thread_target(&tasks[i].thread));
+        }
+        while (tasksNo != atomic_load(&arrived))
+        {
+            ds18b20_tests_yield();
+        }
+        ds18b20_port_sleep_ms(DS18B20_SHARED_SETTLE_MS);
+        ds18b20__UnlockSharedBus(shared);
+        while (tasksNo != atomic_load(&returned))
+        {
+            ds18b20_tests_yield();
+        }
+    }
+
+    for (size_t i = 0; i < tasksNo; ++i)
+    {
+        ds18b20_port_thread_join(&tasks[i].thread);
+        if (tasks[i].failures)
+        {
+            ESP_LOGE(TAG, "Task %zu: %zu failed readings.", i, tasks[i].failures);
+            failures += tasks[i].failures;
+        }
+    }
+
+    return failures;
+}
+
+void ds18b20_shared_test(void)
+{
+    static DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_SHARED_DEVICES_NO];
+    static DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_SHARED_DEVICES_NO];
+    static DS18B20_sim_clock_t clock;
+    static DS18B20_shared_reading_t readings[DS18B20_SHARED_DEVICES_NO];
+    static DS18B20_temperature_raw_t temperatures[DS18B20_SHARED_DEVICES_NO];
+    static DS18B20_shared_task_t tasks[DS18B20_SHARED_TASKS_NO];
+    DS18B20_shared_t shared;
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_SHARED_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+    if (DS18B20_OK != ds18b20__InitSharedBus(&shared, &ds18b20_oneWire, readings, temperatures))
+    {
+        ESP_LOGE(TAG, "Failure while initializing shared bus.");
+        return;
+    }
+
+    // Half of the tasks read the whole bus, the others read single devices
+    size_t failures = 0;
+    size_t naiveConvertions = 0;
+    ds18b20_sim_reset_stats(&sim);
+    for (size_t i = 0; i < DS18B20_SHARED_TASKS_NO; ++i)
+    {
+        tasks[i] = (DS18B20_shared_task_t)
+        {
+            .shared = &shared,
+            .devices = ds18b20_devices,
+            .simDevices = simDevices,
+            .wholeBus = 0 == i % 2,
+            .deviceIndex = i / 2,
+            .checksum = DS18B20_CHECKSUM
+        };
+        naiveConvertions += DS18B20_SHARED_ITERATIONS;
+    }
+    failures += ds18b20_shared_run(&shared, tasks, DS18B20_SHARED_TASKS_NO, DS18B20_SHARED_ITERATIONS);
+
+    ESP_LOGI(TAG, "%zu requests of %d tasks: %" PRIu32 " convertions issued (%" PRIu32 " device convertions)", 
+        naiveConvertions, DS18B20_SHARED_TASKS_NO, shared.convertions, sim.stats.convertions);
+    // Whole bus is read once per round, single devices at most once before it
+    if (shared.convertions > DS18B20_SHARED_ITERATIONS * (1 + DS18B20_SHARED_TASKS_NO / 2))
+    {
+        ESP_LOGE(TAG, "Concurrent requests have not been coalesced.");
+        ++failures;
+    }
+
+    // Reading without checksum is not shared with request verifying it, whichever of them is served first
+    tasks[0] = (DS18B20_shared_task_t) { .shared = &shared, .devices = ds18b20_devices, .simDevices = simDevices, .wholeBus = true, .checksum = false };
+    tasks[1] = (DS18B20_shared_task_t) { .shared = &shared, .devices = ds18b20_devices, .simDevices = simDevices, .deviceIndex = 0, .checksum = true };
+    uint32_t convertions = shared.convertions;
+    failures += ds18b20_shared_run(&shared, tasks, 2, 1);
+    if (2 != shared.convertions - convertions)
+    {
+        ESP_LOGE(TAG, "Request with checksum has been served with %" PRIu32 " convertions instead of 2.", shared.convertions - convertions);
+        ++failures;
+    }
+
+    // Lock gives exclusive access for any other operation
+    if (DS18B20_OK != ds18b20__LockSharedBus(&shared) 
+        || DS18B20_OK != ds18b20__RequestTemperaturesC(shared.onewire) 
+        || DS18B20_OK != ds18b20__UnlockSharedBus(&shared))
+    {
+        ESP_LOGE(TAG, "Failure while using locked bus.");
+        ++failures;
+    }
+
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Shared bus test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Shared bus test passed.");
+    }
+
+    return;
+}
+
+/**
+ * @brief Reads temperature of the selected device through cache and checks if the bus has been accessed as expected.
+ * 
+ * @param onewire Pointer to One-Wire bus characteristics instance
+ * @param sim Pointer to simulated bus
+ * @param deviceIndex Index of the selected device
+ * @param expected Temperature expected to be returned (in 1/16 Celsius)
+ * @param hit Indicates if the temperature is expected to be taken from cache
+ * @return size_t Number of failed checks
+ */
+static size_t ds18b20_cache_check(const DS18B20_onewire_t * const onewire, DS18B20_sim_t * const sim, const size_t deviceIndex, 
+    const DS18B20_temperature_raw_t expected, const bool hit)
+{
+    size_t failures = 0;
+    DS18B20_temperature_raw_t temperature;
+
+    ds18b20_sim_reset_stats(sim);
+    if (DS18B20_OK != ds18b20__GetTemperatureRawCached(onewire, deviceIndex, DS18B20_CACHE_MAX_AGE_MS, &temperature, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Device %zu: reading failed.", deviceIndex);
+        return 1;
+    }
+    if (expected != temperature)
+    {
+        ESP_LOGE(TAG, "Device %zu: temperature %d instead of %d.", deviceIndex, temperature, expected);
+        ++failures;
+    }
+    if (hit != (0 == sim->stats.resets))
+    {
+        ESP_LOGE(TAG, "Device %zu: expected cache %s, %" PRIu32 " resets generated.", deviceIndex, hit ? "hit" : "miss", sim->stats.resets);
+        ++failures;
+    }
+
+    return failures;
+}
+
+void ds18b20_cache_test(void)
+{
+    static DS18B20_onewire_t ds18b20_oneWire;
+    static DS18B20_t ds18b20_devices[DS18B20_CACHE_DEVICES_NO];
+    static DS18B20_sim_t sim;
+    static DS18B20_sim_device_t simDevices[DS18B20_CACHE_DEVICES_NO];
+    static DS18B20_sim_clock_t clock;
+    static DS18B20_cache_entry_t cache[DS18B20_CACHE_DEVICES_NO];
+    DS18B20_temperature_raw_t temperatures[DS18B20_CACHE_DEVICES_NO];
+    DS18B20_temperature_out_t temperaturesC[DS18B20_CACHE_DEVICES_NO];
+
+    if (DS18B20_OK != ds18b20_sim_bus_init(&ds18b20_oneWire, &sim, &clock, simDevices, ds18b20_devices, DS18B20_CACHE_DEVICES_NO)
+        || DS18B20_OK != ds18b20__EnableTemperatureCache(&ds18b20_oneWire, cache, DS18B20_CACHE_DEVICES_NO))
+    {
+        ESP_LOGE(TAG, "Failure while initializing DS18B20 One-Wire driver on simulated bus.");
+        return;
+    }
+
+    size_t failures = 0;
+    DS18B20_sim_device_t *simDevice = &simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, 0)];
+    DS18B20_temperature_raw_t first = simDevice->temperature;
+
+    // The first reading goes to the bus, the next ones are served from cache until it gets too old
+    failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first, false);
+    simDevice->temperature = first + 16;
+    for (uint32_t ageMs = DS18B20_CACHE_HIT_STEP_MS; ageMs <= DS18B20_CACHE_MAX_AGE_MS; ageMs += DS18B20_CACHE_HIT_STEP_MS)
+    {
+        clock.nowUs += DS18B20_CACHE_HIT_STEP_MS * 1000ull;
+        failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first, true);
+    }
+    clock.nowUs += 1000;
+    failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first + 16, false);
+    failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first + 16, true);
+
+    // Bus reading converts once and reads only devices with stale temperatures
+    ds18b20_sim_reset_stats(&sim);
+    if (DS18B20_OK != ds18b20__GetTemperaturesRawCached(&ds18b20_oneWire, DS18B20_CACHE_MAX_AGE_MS, temperatures, DS18B20_CHECKSUM))
+    {
+        ESP_LOGE(TAG, "Bus reading failed.");
+        ++failures;
+    }
+    uint32_t resets = sim.stats.resets;
+    for (size_t i = 0; i < DS18B20_CACHE_DEVICES_NO; ++i)
+    {
+        if (simDevices[ds18b20_sim_index(ds18b20_devices, simDevices, i)].temperature != temperatures[i])
+        {
+            ESP_LOGE(TAG, "Device %zu: temperature %d after bus reading.", i, temperatures[i]);
+            ++failures;
+        }
+    }
+    ds18b20_sim_reset_stats(&sim);
+    ds18b20__GetTemperaturesRawCached(&ds18b20_oneWire, DS18B20_CACHE_MAX_AGE_MS, temperatures, DS18B20_CHECKSUM);
+    if (DS18B20_OK != ds18b20__GetTemperaturesCCached(&ds18b20_oneWire, DS18B20_CACHE_MAX_AGE_MS, temperaturesC, DS18B20_CHECKSUM)
+        || sim.stats.resets)
+    {
+        ESP_LOGE(TAG, "Fresh bus reading accessed the bus (%" PRIu32 " resets).", sim.stats.resets);
+        ++failures;
+    }
+    for (size_t i = 0; i < DS18B20_CACHE_DEVICES_NO; ++i)
+    {
+        if (ds18b20_convert_temperature_raw(temperatures[i]) != temperaturesC[i])
+        {
+            ESP_LOGE(TAG, "Device %zu: cached Celsius temperature differs from raw one.", i);
+            ++failures;
+        }
+    }
+
+    // Invalidated or disabled cache always goes to the bus
+    ds18b20__InvalidateTemperatureCache(&ds18b20_oneWire);
+    failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first + 16, false);
+    ds18b20__DisableTemperatureCache(&ds18b20_oneWire);
+    failures += ds18b20_cache_check(&ds18b20_oneWire, &sim, 0, first + 16, false);
+    ds18b20_sim_reset_stats(&sim);
+    ds18b20__GetTemperaturesRaw(&ds18b20_oneWire, temperatures, DS18B20_CHECKSUM);
+
+    ESP_LOGI(TAG, "Bus reading with 1 fresh device out of %d: %" PRIu32 " resets (%" PRIu32 " without cache)", DS18B20_CACHE_DEVICES_NO, resets, sim.stats.resets);
+    if (resets >= sim.stats.resets)
+    {
+        ESP_LOGE(TAG, "Fresh device has been read again during bus reading.");
+        ++failures;
+    }
+    if (failures)
+    {
+        ESP_LOGE(TAG, "Temperature cache test failed with %zu errors.", failures);
+    }
+    else
+    {
+        ESP_LOGI(TAG, "Temperature cache test passed.");
+    }
+
+    return;
+}
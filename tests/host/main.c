@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "ds18b20_tests.h"
+
+/**
+ * @brief Describes test run on the host.
+ * 
+ */
+typedef struct
+{
+    const char                              *name; /**< Name of the test */
+    void                                    (*run)(void); /**< Function of the test */
+} DS18B20_host_test_t;
+
+#define DS18B20_HOST_TEST(test)             { #test, test }
+
+/**
+ * @brief Tests using simulated bus, they do not need ESP32 to run.
+ * 
+ */
+static const DS18B20_host_test_t ds18b20_host_tests[] =
+{
+    DS18B20_HOST_TEST(ds18b20_crc8_benchmark_test),
+    DS18B20_HOST_TEST(ds18b20_sim_bus_test),
+    DS18B20_HOST_TEST(ds18b20_gpio_fast_timing_test),
+    DS18B20_HOST_TEST(ds18b20_critical_scope_test),
+    DS18B20_HOST_TEST(ds18b20_critical_exclusion_test),
+    DS18B20_HOST_TEST(ds18b20_discovery_test),
+    DS18B20_HOST_TEST(ds18b20_rom_lookup_benchmark_test),
+    DS18B20_HOST_TEST(ds18b20_find_all_alarms_test),
+    DS18B20_HOST_TEST(ds18b20_temperature_convertion_test),
+    DS18B20_HOST_TEST(ds18b20_batch_convertion_benchmark_test),
+    DS18B20_HOST_TEST(ds18b20_storage_test),
+    DS18B20_HOST_TEST(ds18b20_adaptive_integrity_test),
+    DS18B20_HOST_TEST(ds18b20_convertion_learning_test),
+    DS18B20_HOST_TEST(ds18b20_adaptive_resolution_test),
+    DS18B20_HOST_TEST(ds18b20_broadcast_configuration_test),
+    DS18B20_HOST_TEST(ds18b20_partial_bus_test),
+    DS18B20_HOST_TEST(ds18b20_write_avoidance_test),
+    DS18B20_HOST_TEST(ds18b20_fast_init_test),
+    DS18B20_HOST_TEST(ds18b20_topology_cache_test),
+    DS18B20_HOST_TEST(ds18b20_verify_rom_test),
+    DS18B20_HOST_TEST(ds18b20_manager_test),
+    DS18B20_HOST_TEST(ds18b20_lockstep_test),
+    DS18B20_HOST_TEST(ds18b20_worker_test),
+    DS18B20_HOST_TEST(ds18b20_shared_test),
+    DS18B20_HOST_TEST(ds18b20_cache_test),
+};
+
+/**
+ * @brief Runs tests selected by their names (all tests when no name is given).
+ * 
+ * @return int Zero if no test has logged an error
+ */
+int main(int argc, char **argv)
+{
+    const size_t testsNo = sizeof(ds18b20_host_tests) / sizeof(ds18b20_host_tests[0]);
+
+    for (size_t i = 0; i < testsNo; ++i)
+    {
+        bool selected = argc < 2;
+        for (int arg = 1; arg < argc; ++arg)
+        {
+            selected |= 0 == strcmp(argv[arg], ds18b20_host_tests[i].name);
+        }
+        if (selected)
+        {
+            ds18b20_host_tests[i].run();
+        }
+    }
+
+    return 0 == atomic_load(&ds18b20_tests_errors) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Damian Ślusarczyk
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial
+ * portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ * TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * @file ds18b20_sim.h
+ * @author Damian Ślusarczyk
+ * @brief Contains One-Wire transport implementation simulating bus with many DS18B20 devices.
+ * 
+ * Simulated devices implement ROM and function commands of DS18B20 (including wired-AND search behaviour),
+ * scratchpad and EEPROM memory, alarm flags, power modes and temperature convertion latency.
+ * Time is simulated as well - every timeslot advances the simulated clock by its nominal duration,
+ * so bus time of any driver operation can be measured without the real hardware.
+ */
+
+#ifndef DS18B20_SIM_H
+#define DS18B20_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "ds18b20_low.h"
+#include "ds18b20_transport.h"
+#include "ds18b20_lockstep.h"
+
+#define DS18B20_SIM_FAMILY_CODE             0x28    /**< Family code of DS18B20 placed in ROM of simulated devices */
+#define DS18B20_SIM_POWER_ON_TEMPERATURE    0x0550  /**< Power-on reset value of temperature register (85 Celsius) */
+#define DS18B20_SIM_CONVERTION_US           600000  /**< Default 12-bit temperature convertion time of simulated devices (us) */
+
+typedef struct DS18B20_sim_clock_t          DS18B20_sim_clock_t;
+typedef struct DS18B20_sim_stats_t          DS18B20_sim_stats_t;
+typedef struct DS18B20_sim_device_t         DS18B20_sim_device_t;
+typedef struct DS18B20_sim_t                DS18B20_sim_t;
+typedef struct DS18B20_sim_lockstep_t       DS18B20_sim_lockstep_t;
+
+/**
+ * @brief Describes simulated time, which can be shared between many simulated buses.
+ * 
+ */
+struct DS18B20_sim_clock_t
+{
+    uint64_t                                nowUs; /**< Current simulated time (in microseconds) */
+};
+
+/**
+ * @brief Describes statistics of the simulated bus activity.
+ * 
+ */
+struct DS18B20_sim_stats_t
+{
+    uint32_t                                resets; /**< Number of generated reset signals */
+    uint32_t                                writeSlots; /**< Number of generated write timeslots */
+    uint32_t                                readSlots; /**< Number of generated read timeslots */
+    uint64_t                                busTimeUs; /**< Time spent by the bus on generating signals (in microseconds) */
+    uint32_t                                convertions; /**< Number of temperature convertions performed by all devices */
+    uint32_t                                scratchpadWrites; /**< Number of scratchpad writes received by all devices */
+    uint32_t                                eepromWrites; /**< Number of EEPROM writes performed by all devices */
+    uint32_t                                parasiteFailures; /**< Number of operations in parasite power mode broken by missing strong pullup */
+    uint32_t                                readFaults; /**< Number of read timeslots corrupted by fault injection */
+};
+
+/**
+ * @brief Describes single simulated DS18B20.
+ * 
+ * @note Structure should be initialized using ds18b20_sim_init_device() method.
+ */
+struct DS18B20_sim_device_t
+{
+    DS18B20_rom_t                           rom; /**< ROM address of the device */
+    DS18B20_scratchpad_t                    scratchpad; /**< Scratchpad memory of the device (CRC byte is calculated on read) */
+    uint8_t                                 eeprom[3]; /**< Non-volatile copy of TH, TL and configuration registers */
+    DS18B20_powermode_t                     powerMode; /**< Power mode of the device */
+    int16_t                                 temperature; /**< Temperature measured during next convertion (1/16 Celsius) */
+    uint32_t                                convertionUs; /**< Time of 12-bit temperature convertion (in microseconds), lower resolutions take proportionally less */
+    uint32_t                                jitterUs; /**< Maximum random deviation added to every convertion time (in microseconds) */
+    bool                                    present; /**< Indicates if the device is connected to the bus */
+
+    bool                                    alarm; /**< Alarm flag set after the last convertion */
+    uint8_t                                 state; /**< Current state of the protocol state machine */
+    uint8_t                                 rxByte; /**< Byte being received from the bus */
+    uint8_t                                 bitNo; /**< Number of processed bits in the current state */
+    uint8_t                                 searchPhase; /**< Phase of Search ROM (bit, complement, direction) */
+    uint8_t                                 operation; /**< Function command being performed in the background */
+    uint64_t                                busyUntilUs; /**< Time when the operation performed in the background ends */
+    bool                                    pulledUp; /**< Indicates if strong pullup has been provided for the background operation */
+};
+
+/**
+ * @brief Describes simulated One-Wire bus.
+ * 
+ * Pointer to this structure need to be passed as transport context of One-Wire bus instance.
+ * @note Structure should be initialized using ds18b20_sim_init() method.
+ */
+struct DS18B20_sim_t
+{
+    DS18B20_sim_clock_t                     *clock; /**< Simulated clock */
+    DS18B20_sim_device_t                    *devices; /**< Devices connected to the bus */
+    size_t                                  devicesNo; /**< Number of devices */
+    bool                                    pullup; /**< Indicates if strong pullup is enabled */
+    uint32_t                                seed; /**< Seed of pseudo-random generator used for convertion jitter and fault injection */
+    uint32_t                                readFaultPeriod; /**< Average number of read timeslots per one corrupted (pulled low by noise), 0 disables fault injection */
+    DS18B20_sim_stats_t                     stats; /**< Bus activity statistics */
+};
+
+/**
+ * @brief Describes simulated buses driven in lockstep as lanes.
+ * 
+ * Pointer to this structure need to be passed as transport context of lockstep instance.
+ * All simulated buses need to use the given clock, which is advanced once per timeslot of all lanes.
+ */
+struct DS18B20_sim_lockstep_t
+{
+    DS18B20_sim_clock_t                     *clock; /**< Simulated clock shared by all lanes */
+    DS18B20_sim_t                           *lanes[DS18B20_LOCKSTEP_MAX_LANES]; /**< Simulated buses indexed by lane bit number (NULL for unused lanes) */
+};
+
+/**
+ * @brief One-Wire transport driving simulated bus specified in transport context.
+ * 
+ */
+extern const DS18B20_transport_t ds18b20_sim_transport;
+
+/**
+ * @brief Lockstep transport driving simulated buses specified in transport context.
+ * 
+ */
+extern const DS18B20_lockstep_transport_t ds18b20_sim_lockstep_transport;
+
+/**
+ * @brief Initializes simulated bus.
+ * 
+ * @param sim Pointer to simulated bus instance to initialize
+ * @param clock Pointer to simulated clock
+ * @param devices Array of simulated devices connected to the bus (should be initialized with ds18b20_sim_init_device())
+ * @param devicesNo Number of devices
+ */
+void ds18b20_sim_init(DS18B20_sim_t * const sim, DS18B20_sim_clock_t * const clock, DS18B20_sim_device_t * const devices, const size_t devicesNo);
+
+/**
+ * @brief Initializes simulated device with power-on reset values.
+ * 
+ * @param device Pointer to simulated device instance to initialize
+ * @param serial Serial number placed in the device ROM address (lower 48 bits are used)
+ * @param powerMode Power mode of the device
+ * @param temperature Temperature measured by the device (1/16 Celsius)
+ */
+void ds18b20_sim_init_device(DS18B20_sim_device_t * const device, const uint64_t serial, const DS18B20_powermode_t powerMode, const int16_t temperature);
+
+/**
+ * @brief Clears statistics of the simulated bus activity.
+ * 
+ * @param sim Pointer to simulated bus instance
+ */
+void ds18b20_sim_reset_stats(DS18B20_sim_t * const sim);
+
+/**
+ * @brief Finishes background operations of all devices whose time has passed, without any bus activity.
+ * 
+ * Operations are otherwise finished lazily on the next timeslot, so this should be called before checking statistics.
+ * 
+ * @param sim Pointer to simulated bus instance
+ */
+void ds18b20_sim_sync(DS18B20_sim_t * const sim);
+
+#endif /* DS18B20_SIM_H */
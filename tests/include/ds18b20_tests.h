@@ -21,10 +21,48 @@
 #ifndef DS18B20_TESTS_H
 #define DS18B20_TESTS_H
 
+#ifdef ESP_PLATFORM
+
 void ds18b20_init_test(void);
 void ds18b20_read_temperature_test(void);
+void ds18b20_read_temperatures_test(void);
+void ds18b20_split_convertion_test(void);
 void ds18b20_store_registers_test(void);
 void ds18b20_restore_registers_test(void);
 void ds18b20_find_alarms_test(void);
 
+#else
+
+#include <stdatomic.h>
+
+extern atomic_size_t ds18b20_tests_errors; /**< Number of errors logged by the tests on the host */
+
+#endif /* ESP_PLATFORM */
+
+void ds18b20_crc8_benchmark_test(void);
+void ds18b20_sim_bus_test(void);
+void ds18b20_gpio_fast_timing_test(void);
+void ds18b20_critical_scope_test(void);
+void ds18b20_critical_exclusion_test(void);
+void ds18b20_discovery_test(void);
+void ds18b20_rom_lookup_benchmark_test(void);
+void ds18b20_find_all_alarms_test(void);
+void ds18b20_temperature_convertion_test(void);
+void ds18b20_batch_convertion_benchmark_test(void);
+void ds18b20_storage_test(void);
+void ds18b20_adaptive_integrity_test(void);
+void ds18b20_convertion_learning_test(void);
+void ds18b20_adaptive_resolution_test(void);
+void ds18b20_broadcast_configuration_test(void);
+void ds18b20_partial_bus_test(void);
+void ds18b20_write_avoidance_test(void);
+void ds18b20_fast_init_test(void);
+void ds18b20_topology_cache_test(void);
+void ds18b20_verify_rom_test(void);
+void ds18b20_manager_test(void);
+void ds18b20_lockstep_test(void);
+void ds18b20_worker_test(void);
+void ds18b20_shared_test(void);
+void ds18b20_cache_test(void);
+
 #endif /* DS18B20_TESTS_H */